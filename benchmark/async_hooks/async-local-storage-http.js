@@ -0,0 +1,86 @@
+'use strict';
+// Compares the cost of keeping per-request state with AsyncLocalStorage to
+// doing it with an async_hooks init() hook, for an HTTP server whose handler
+// awaits a few promises and timers.
+const common = require('../common.js');
+const http = require('http');
+const { AsyncLocalStorage, createHook, executionAsyncId } =
+  require('async_hooks');
+
+const bench = common.createBenchmark(main, {
+  n: [1e4],
+  type: ['none', 'async-hooks', 'async-local-storage'],
+  connections: [50]
+});
+
+function setupTracking(type) {
+  switch (type) {
+    case 'none':
+      return (id, fn) => fn();
+    case 'async-hooks': {
+      const contexts = new Map();
+      createHook({
+        init(asyncId, type, triggerAsyncId) {
+          const context = contexts.get(triggerAsyncId);
+          if (context !== undefined)
+            contexts.set(asyncId, context);
+        },
+        destroy(asyncId) {
+          contexts.delete(asyncId);
+        }
+      }).enable();
+      return (id, fn) => {
+        contexts.set(executionAsyncId(), id);
+        fn();
+      };
+    }
+    case 'async-local-storage': {
+      const storage = new AsyncLocalStorage();
+      return (id, fn) => storage.run(id, fn);
+    }
+    default:
+      throw new Error(`Unsupported type "${type}"`);
+  }
+}
+
+async function handle(req, res) {
+  await null;
+  await new Promise((resolve) => setImmediate(resolve));
+  await Promise.resolve();
+  res.end('ok');
+}
+
+function main({ n, type, connections }) {
+  const track = setupTracking(type);
+  let nextId = 0;
+  const server = http.createServer((req, res) => {
+    track(nextId++, () => handle(req, res));
+  });
+
+  server.listen(0, () => {
+    const agent = new http.Agent({ keepAlive: true, maxSockets: connections });
+    const port = server.address().port;
+    let sent = 0;
+    let done = 0;
+
+    function request() {
+      sent++;
+      http.get({ port, agent }, (res) => {
+        res.resume();
+        res.on('end', () => {
+          if (++done === n) {
+            bench.end(n);
+            agent.destroy();
+            server.close();
+          } else if (sent < n) {
+            request();
+          }
+        });
+      });
+    }
+
+    bench.start();
+    for (let i = 0; i < connections && i < n; i++)
+      request();
+  });
+}
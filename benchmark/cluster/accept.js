@@ -0,0 +1,57 @@
+'use strict';
+// Measures how fast a cluster of workers accepts connections with each of
+// the scheduling policies.
+
+const cluster = require('cluster');
+const net = require('net');
+
+if (cluster.isMaster) {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    policy: ['rr', 'none', 'reuseport'],
+    workers: [2],
+    concurrent: [16],
+    n: [1e4]
+  });
+
+  function main({ policy, workers, concurrent, n }) {
+    cluster.schedulingPolicy = {
+      rr: cluster.SCHED_RR,
+      none: cluster.SCHED_NONE,
+      reuseport: cluster.SCHED_REUSEPORT
+    }[policy];
+
+    var listening = 0;
+    var port;
+    for (var i = 0; i < workers; ++i) {
+      cluster.fork().on('listening', (address) => {
+        port = address.port;
+        if (++listening === workers)
+          run();
+      });
+    }
+
+    function run() {
+      var started = 0;
+      var finished = 0;
+      bench.start();
+      for (var i = 0; i < concurrent; ++i)
+        connect();
+
+      function connect() {
+        if (started++ === n)
+          return;
+        net.connect(port).on('close', () => {
+          if (++finished === n) {
+            bench.end(n);
+            cluster.disconnect();
+          } else {
+            connect();
+          }
+        });
+      }
+    }
+  }
+} else {
+  net.createServer((socket) => socket.end()).listen(0);
+}
@@ -0,0 +1,60 @@
+'use strict';
+// Measures how many sequential fs.stat() calls complete while scrypt() calls
+// keep the threadpool busy, with and without --threadpool-crypto-size. The
+// calls run in a child process so that the threadpools can be configured
+// for it.
+const { fork } = require('child_process');
+
+if (process.argv[2] === 'child') {
+  child(+process.argv[3], +process.argv[4]);
+} else {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    cryptoSize: [0, 2],
+    concurrent: [8],
+    n: [1e3],
+  });
+
+  function main({ cryptoSize, concurrent, n }) {
+    const execArgv = [];
+    if (cryptoSize > 0)
+      execArgv.push(`--threadpool-crypto-size=${cryptoSize}`);
+    const proc = fork(__filename, ['child', concurrent, n], {
+      execArgv,
+      env: { ...process.env, UV_THREADPOOL_SIZE: '4' }
+    });
+    proc.on('message', ({ elapsed }) => {
+      bench.report(n / (elapsed[0] + elapsed[1] / 1e9), elapsed);
+    });
+  }
+}
+
+function child(concurrent, n) {
+  const crypto = require('crypto');
+  const fs = require('fs');
+  const assert = require('assert');
+
+  let stopped = false;
+  function scrypt() {
+    crypto.scrypt('secret', 'salt', 64, (err) => {
+      assert.ifError(err);
+      if (!stopped)
+        scrypt();
+    });
+  }
+  for (let i = 0; i < concurrent; i++)
+    scrypt();
+
+  let i = 0;
+  const start = process.hrtime();
+  (function stat() {
+    fs.stat(__filename, (err) => {
+      assert.ifError(err);
+      if (++i < n)
+        return stat();
+      const elapsed = process.hrtime(start);
+      stopped = true;
+      process.send({ elapsed }, () => process.exit());
+    });
+  })();
+}
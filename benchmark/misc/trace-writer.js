@@ -0,0 +1,40 @@
+'use strict';
+
+const common = require('../common.js');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [1e5],
+  format: ['none', 'json', 'proto']
+});
+
+// Emits `n` trace events from a child process, so that the time spent
+// serializing and writing them is included up to process exit.
+function childCode(n) {
+  return `
+    const { internalBinding } = require('internal/test/binding');
+    const { trace } = internalBinding('trace_events');
+    const kEvent = internalBinding('constants').trace
+      .TRACE_EVENT_PHASE_NESTABLE_ASYNC_BEGIN;
+    for (var i = 0; i < ${n}; i++)
+      trace(kEvent, 'foo', 'test', i, 'test');
+  `;
+}
+
+function main({ n, format }) {
+  tmpdir.refresh();
+  const args = ['--expose-internals', '--no-warnings'];
+  if (format !== 'none') {
+    args.push('--trace-event-categories', 'foo',
+              '--trace-event-format', format);
+  }
+  args.push('-e', childCode(n));
+
+  bench.start();
+  const child = spawnSync(process.execPath, args, { cwd: tmpdir.path });
+  bench.end(n);
+
+  if (child.status !== 0)
+    throw new Error(child.stderr.toString());
+}
@@ -0,0 +1,51 @@
+'use strict';
+// Measures resolving packages through their package.json "main" field, with
+// manifests of realistic size where most of the content is irrelevant to the
+// loader.
+const fs = require('fs');
+const path = require('path');
+const common = require('../common.js');
+
+const tmpdir = require('../../test/common/tmpdir');
+const benchmarkDirectory = path.join(tmpdir.path, 'nodejs-benchmark-module');
+
+const bench = common.createBenchmark(main, {
+  files: [5e2],
+  fields: [0, 100]
+});
+
+function createPackageJSON(fields) {
+  const pkg = {
+    name: 'benchmark-package',
+    version: '1.0.0',
+    description: 'A package used by the module loader benchmarks',
+    scripts: {},
+    dependencies: {},
+    devDependencies: {},
+    main: 'lib/index.js'
+  };
+  for (let i = 0; i < fields; i++) {
+    pkg.scripts[`script-${i}`] = `node scripts/${i}.js --flag="${i}"`;
+    pkg.dependencies[`dependency-${i}`] = `^${i}.0.0`;
+    pkg.devDependencies[`dev-dependency-${i}`] = `~${i}.1.0`;
+  }
+  return JSON.stringify(pkg, null, 2);
+}
+
+function main({ files, fields }) {
+  tmpdir.refresh();
+  const json = createPackageJSON(fields);
+  for (let i = 0; i < files; i++) {
+    const dir = `${benchmarkDirectory}${i}`;
+    fs.mkdirSync(path.join(dir, 'lib'), { recursive: true });
+    fs.writeFileSync(path.join(dir, 'package.json'), json);
+    fs.writeFileSync(path.join(dir, 'lib', 'index.js'), 'module.exports = "";');
+  }
+
+  bench.start();
+  for (let i = 0; i < files; i++)
+    require(`${benchmarkDirectory}${i}`);
+  bench.end(files);
+
+  tmpdir.refresh();
+}
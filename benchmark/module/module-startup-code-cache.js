@@ -0,0 +1,79 @@
+'use strict';
+// Measures the startup time of a process that loads `modules` modules of
+// generated code, with and without --experimental-code-cache.
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const common = require('../common.js');
+
+const tmpdir = require('../../test/common/tmpdir');
+const benchmarkDirectory = path.join(tmpdir.path, 'nodejs-benchmark-module');
+
+const bench = common.createBenchmark(main, {
+  modules: [500],
+  functions: [50],
+  codeCache: ['none', 'cold', 'warm'],
+  runs: [3]
+});
+
+// Each module defines `functions` functions and calls all of them, so that
+// they are compiled eagerly enough to end up in the cache.
+function createModules(modules, functions) {
+  fs.mkdirSync(benchmarkDirectory, { recursive: true });
+  let entrySource = '';
+  for (let i = 0; i < modules; i++) {
+    let source = '';
+    for (let j = 0; j < functions; j++) {
+      source += `function f${j}(a, b) {\n` +
+                `  const values = [a, b, ${i}, ${j}];\n` +
+                '  return values.map((v) => v * 2).reduce((x, y) => x + y);\n' +
+                '}\n';
+    }
+    source += 'let sum = 0;\n';
+    for (let j = 0; j < functions; j++)
+      source += `sum += f${j}(${j}, ${i});\n`;
+    source += 'module.exports = sum;\n';
+    fs.writeFileSync(path.join(benchmarkDirectory, `m${i}.js`), source);
+    entrySource += `require('./m${i}.js');\n`;
+  }
+  const entry = path.join(benchmarkDirectory, 'index.js');
+  fs.writeFileSync(entry, entrySource);
+  return entry;
+}
+
+function run(entry, cacheDir) {
+  const args = cacheDir ?
+    ['--no-warnings', `--experimental-code-cache=${cacheDir}`, entry] :
+    [entry];
+  const child = spawnSync(process.execPath, args);
+  if (child.status !== 0)
+    throw new Error(child.stderr.toString());
+}
+
+function main({ modules, functions, codeCache, runs }) {
+  tmpdir.refresh();
+  const entry = createModules(modules, functions);
+  const cacheDir = codeCache === 'none' ?
+    null : path.join(tmpdir.path, 'code-cache');
+
+  // Warm up the file system cache, and the code cache if requested.
+  run(entry, codeCache === 'warm' ? cacheDir : null);
+
+  bench.start();
+  for (let i = 0; i < runs; i++) {
+    if (codeCache === 'cold')
+      removeDirectory(cacheDir);
+    run(entry, cacheDir);
+  }
+  bench.end(runs);
+
+  tmpdir.refresh();
+}
+
+function removeDirectory(dir) {
+  if (!fs.existsSync(dir))
+    return;
+  for (const name of fs.readdirSync(dir))
+    fs.unlinkSync(path.join(dir, name));
+  fs.rmdirSync(dir);
+}
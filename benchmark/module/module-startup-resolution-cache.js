@@ -0,0 +1,68 @@
+'use strict';
+// Measures the startup time of a process that loads a dependency tree of
+// `modules` packages, with and without --experimental-resolution-cache.
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const common = require('../common.js');
+
+const tmpdir = require('../../test/common/tmpdir');
+const benchmarkDirectory = path.join(tmpdir.path, 'nodejs-benchmark-module');
+
+const bench = common.createBenchmark(main, {
+  modules: [5e3],
+  resolutionCache: ['none', 'cold', 'warm'],
+  runs: [3]
+});
+
+// Creates `modules` packages in node_modules/, where package `i` requires
+// packages `2i + 1` and `2i + 2`, so that the tree is as deep as a typical
+// dependency tree rather than flat.
+function createTree(modules) {
+  const nodeModules = path.join(benchmarkDirectory, 'node_modules');
+  fs.mkdirSync(nodeModules, { recursive: true });
+  for (let i = 0; i < modules; i++) {
+    const dir = path.join(nodeModules, `pkg${i}`);
+    fs.mkdirSync(path.join(dir, 'lib'), { recursive: true });
+    fs.writeFileSync(path.join(dir, 'package.json'),
+                     `{"name": "pkg${i}", "main": "lib/main"}`);
+    let source = '';
+    for (const child of [2 * i + 1, 2 * i + 2]) {
+      if (child < modules)
+        source += `require('pkg${child}');\n`;
+    }
+    fs.writeFileSync(path.join(dir, 'lib', 'main.js'), source);
+  }
+  const entry = path.join(benchmarkDirectory, 'index.js');
+  fs.writeFileSync(entry, 'require(\'pkg0\');\n');
+  return entry;
+}
+
+function run(entry, cacheFile) {
+  const args = cacheFile ?
+    ['--no-warnings', `--experimental-resolution-cache=${cacheFile}`, entry] :
+    [entry];
+  const child = spawnSync(process.execPath, args);
+  if (child.status !== 0)
+    throw new Error(child.stderr.toString());
+}
+
+function main({ modules, resolutionCache, runs }) {
+  tmpdir.refresh();
+  const entry = createTree(modules);
+  const cacheFile = resolutionCache === 'none' ?
+    null : path.join(tmpdir.path, 'resolution-cache.json');
+
+  // Warm up the file system cache, and the resolution cache if requested.
+  run(entry, resolutionCache === 'warm' ? cacheFile : null);
+
+  bench.start();
+  for (let i = 0; i < runs; i++) {
+    if (resolutionCache === 'cold' && fs.existsSync(cacheFile))
+      fs.unlinkSync(cacheFile);
+    run(entry, cacheFile);
+  }
+  bench.end(runs);
+
+  tmpdir.refresh();
+}
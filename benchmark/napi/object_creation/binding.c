@@ -0,0 +1,126 @@
+#include <assert.h>
+#define NAPI_EXPERIMENTAL
+#include <node_api.h>
+
+#define FIELD_COUNT 4
+
+static const char* field_names[FIELD_COUNT] = { "id", "name", "value", "ok" };
+static napi_ref keys[FIELD_COUNT];
+static napi_object_template record_template;
+
+static void RecordValues(napi_env env, uint32_t i, napi_value* values) {
+  napi_status status = napi_create_uint32(env, i, &values[0]);
+  assert(status == napi_ok);
+  status = napi_create_string_latin1(env, "record", NAPI_AUTO_LENGTH,
+                                     &values[1]);
+  assert(status == napi_ok);
+  status = napi_create_double(env, i / 2.0, &values[2]);
+  assert(status == napi_ok);
+  status = napi_get_boolean(env, i % 2 == 0, &values[3]);
+  assert(status == napi_ok);
+}
+
+// Sets the properties one at a time, by their names.
+static napi_value NewNamed(napi_env env, uint32_t i) {
+  napi_value values[FIELD_COUNT], result;
+  napi_status status;
+  int field;
+  RecordValues(env, i, values);
+  status = napi_create_object(env, &result);
+  assert(status == napi_ok);
+  for (field = 0; field < FIELD_COUNT; field++) {
+    status = napi_set_named_property(env, result, field_names[field],
+                                     values[field]);
+    assert(status == napi_ok);
+  }
+  return result;
+}
+
+// Sets the properties one at a time, using cached keys.
+static napi_value NewWithKeys(napi_env env, uint32_t i) {
+  napi_value values[FIELD_COUNT], key, result;
+  napi_status status;
+  int field;
+  RecordValues(env, i, values);
+  status = napi_create_object(env, &result);
+  assert(status == napi_ok);
+  for (field = 0; field < FIELD_COUNT; field++) {
+    status = napi_get_reference_value(env, keys[field], &key);
+    assert(status == napi_ok);
+    status = napi_set_property(env, result, key, values[field]);
+    assert(status == napi_ok);
+  }
+  return result;
+}
+
+// Sets all properties at once, from the template.
+static napi_value NewFromTemplate(napi_env env, uint32_t i) {
+  napi_value values[FIELD_COUNT], result;
+  napi_status status;
+  RecordValues(env, i, values);
+  status = napi_create_object_from_template(env, record_template, values,
+                                            &result);
+  assert(status == napi_ok);
+  return result;
+}
+
+// create(n, method) creates n records the given way, and returns the last one.
+static napi_value Create(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], last = NULL;
+  uint32_t n, method, i;
+  napi_handle_scope scope;
+  napi_escapable_handle_scope outer;
+  napi_status status = napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+  assert(status == napi_ok && argc == 2);
+  status = napi_get_value_uint32(env, argv[0], &n);
+  assert(status == napi_ok);
+  status = napi_get_value_uint32(env, argv[1], &method);
+  assert(status == napi_ok);
+
+  status = napi_open_escapable_handle_scope(env, &outer);
+  assert(status == napi_ok);
+  for (i = 0; i < n; i++) {
+    status = napi_open_handle_scope(env, &scope);
+    assert(status == napi_ok);
+    if (method == 0)
+      last = NewNamed(env, i);
+    else if (method == 1)
+      last = NewWithKeys(env, i);
+    else
+      last = NewFromTemplate(env, i);
+    if (i == n - 1) {
+      status = napi_escape_handle(env, outer, last, &last);
+      assert(status == napi_ok);
+    }
+    status = napi_close_handle_scope(env, scope);
+    assert(status == napi_ok);
+  }
+  status = napi_close_escapable_handle_scope(env, outer);
+  assert(status == napi_ok);
+  return last;
+}
+
+NAPI_MODULE_INIT() {
+  napi_value key_values[FIELD_COUNT], create;
+  napi_status status;
+  int field;
+  for (field = 0; field < FIELD_COUNT; field++) {
+    status = napi_create_property_key_utf8(env, field_names[field],
+                                           NAPI_AUTO_LENGTH,
+                                           &key_values[field]);
+    assert(status == napi_ok);
+    status = napi_create_reference(env, key_values[field], 1, &keys[field]);
+    assert(status == napi_ok);
+  }
+  status = napi_create_object_template(env, FIELD_COUNT, key_values,
+                                       &record_template);
+  assert(status == napi_ok);
+
+  status = napi_create_function(env, "create", NAPI_AUTO_LENGTH, Create, NULL,
+                                &create);
+  assert(status == napi_ok);
+  status = napi_set_named_property(env, exports, "create", create);
+  assert(status == napi_ok);
+  return exports;
+}
@@ -0,0 +1,30 @@
+// Compares creating small result objects in an addon by setting named
+// properties, by setting properties with cached keys, and by instantiating
+// an object template.
+'use strict';
+
+const assert = require('assert');
+const common = require('../../common.js');
+
+let binding;
+try {
+  binding = require(`./build/${common.buildType}/binding`);
+} catch {
+  console.error(`${__filename}: Binding failed to load`);
+  process.exit(0);
+}
+
+const methods = ['named', 'keys', 'template'];
+
+const bench = common.createBenchmark(main, {
+  method: methods,
+  n: [1e6]
+});
+
+function main({ method, n }) {
+  const index = methods.indexOf(method);
+  bench.start();
+  const last = binding.create(n, index);
+  bench.end(n);
+  assert.strictEqual(last.id, n - 1);
+}
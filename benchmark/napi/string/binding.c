@@ -0,0 +1,131 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#define NAPI_EXPERIMENTAL
+#include <node_api.h>
+
+static char* contents = NULL;
+static size_t contents_length = 0;
+
+static void FreeContents(napi_env env, void* data, void* hint) {
+  free(data);
+}
+
+// Sums the bytes so that the string contents are actually read.
+static uint32_t Sum(const char* data, size_t length) {
+  uint32_t sum = 0;
+  size_t i;
+  for (i = 0; i < length; i++)
+    sum += (unsigned char)data[i];
+  return sum;
+}
+
+static napi_value ReturnSum(napi_env env, uint32_t sum) {
+  napi_value result;
+  napi_status status = napi_create_uint32(env, sum, &result);
+  assert(status == napi_ok);
+  return result;
+}
+
+static napi_value GetArg(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value arg;
+  napi_status status = napi_get_cb_info(env, info, &argc, &arg, NULL, NULL);
+  assert(status == napi_ok && argc == 1);
+  return arg;
+}
+
+// Copies the contents of a string, the way an addon has to without views.
+static napi_value GetCopy(napi_env env, napi_callback_info info) {
+  napi_value arg = GetArg(env, info);
+  size_t length;
+  char* buffer;
+  uint32_t sum;
+  napi_status status =
+      napi_get_value_string_latin1(env, arg, NULL, 0, &length);
+  assert(status == napi_ok);
+  buffer = malloc(length + 1);
+  assert(buffer != NULL);
+  status = napi_get_value_string_latin1(env, arg, buffer, length + 1, NULL);
+  assert(status == napi_ok);
+  sum = Sum(buffer, length);
+  free(buffer);
+  return ReturnSum(env, sum);
+}
+
+static napi_value GetView(napi_env env, napi_callback_info info) {
+  napi_value arg = GetArg(env, info);
+  const char* view;
+  size_t length;
+  napi_status status =
+      napi_get_value_string_latin1_view(env, arg, &view, &length);
+  assert(status == napi_ok && view != NULL);
+  return ReturnSum(env, Sum(view, length));
+}
+
+// Creates a string from the contents set with setContents().
+static napi_value CreateCopy(napi_env env, napi_callback_info info) {
+  napi_value result;
+  napi_status status =
+      napi_create_string_latin1(env, contents, contents_length, &result);
+  assert(status == napi_ok);
+  return result;
+}
+
+static napi_value CreateView(napi_env env, napi_callback_info info) {
+  napi_value result;
+  // The contents outlive every string created here, so no finalizer is
+  // needed.
+  napi_status status = napi_create_external_string_latin1(env,
+                                                          contents,
+                                                          contents_length,
+                                                          NULL,
+                                                          NULL,
+                                                          &result);
+  assert(status == napi_ok);
+  return result;
+}
+
+// Returns an external string with the given contents, and keeps a copy of
+// them for the create* functions.
+static napi_value SetContents(napi_env env, napi_callback_info info) {
+  napi_value arg = GetArg(env, info);
+  napi_value result;
+  char* external;
+  napi_status status =
+      napi_get_value_string_latin1(env, arg, NULL, 0, &contents_length);
+  assert(status == napi_ok);
+  free(contents);
+  contents = malloc(contents_length + 1);
+  external = malloc(contents_length + 1);
+  assert(contents != NULL && external != NULL);
+  status = napi_get_value_string_latin1(env,
+                                        arg,
+                                        contents,
+                                        contents_length + 1,
+                                        NULL);
+  assert(status == napi_ok);
+  memcpy(external, contents, contents_length + 1);
+  status = napi_create_external_string_latin1(env,
+                                              external,
+                                              contents_length,
+                                              FreeContents,
+                                              NULL,
+                                              &result);
+  assert(status == napi_ok);
+  return result;
+}
+
+NAPI_MODULE_INIT() {
+  napi_property_descriptor properties[] = {
+    { "getCopy", NULL, GetCopy, NULL, NULL, NULL, napi_default, NULL },
+    { "getView", NULL, GetView, NULL, NULL, NULL, napi_default, NULL },
+    { "createCopy", NULL, CreateCopy, NULL, NULL, NULL, napi_default, NULL },
+    { "createView", NULL, CreateView, NULL, NULL, NULL, napi_default, NULL },
+    { "setContents", NULL, SetContents, NULL, NULL, NULL, napi_default, NULL },
+  };
+  napi_status status = napi_define_properties(
+      env, exports, sizeof(properties) / sizeof(*properties), properties);
+  assert(status == napi_ok);
+  return exports;
+}
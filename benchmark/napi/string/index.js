@@ -0,0 +1,38 @@
+// Compares copying the contents of strings across the N-API boundary with
+// accessing them through views, and creating strings from copies with
+// creating external strings backed by the addon's memory.
+'use strict';
+
+const common = require('../../common.js');
+
+let binding;
+try {
+  binding = require(`./build/${common.buildType}/binding`);
+} catch {
+  console.error(`${__filename}: Binding failed to load`);
+  process.exit(0);
+}
+
+const bench = common.createBenchmark(main, {
+  op: ['get', 'create'],
+  method: ['copy', 'view'],
+  len: [64, 16 * 1024, 1024 * 1024],
+  n: [1e4]
+});
+
+function main({ op, method, len, n }) {
+  const str = binding.setContents('a'.repeat(len));
+  if (op === 'get') {
+    const fn = method === 'copy' ? binding.getCopy : binding.getView;
+    bench.start();
+    for (var i = 0; i < n; i++)
+      fn(str);
+    bench.end(n);
+  } else {
+    const fn = method === 'copy' ? binding.createCopy : binding.createView;
+    bench.start();
+    for (var j = 0; j < n; j++)
+      fn();
+    bench.end(n);
+  }
+}
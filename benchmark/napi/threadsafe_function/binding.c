@@ -0,0 +1,132 @@
+#include <assert.h>
+#include <uv.h>
+#define NAPI_EXPERIMENTAL
+#include <node_api.h>
+
+#define MAX_QUEUE_SIZE 4096
+
+typedef struct {
+  uint32_t count;
+  uv_thread_t thread;
+  napi_ref done;
+} producer_data;
+
+static int item;
+
+// Pushes |count| items from another thread, as fast as the queue permits.
+static void Produce(void* arg) {
+  napi_threadsafe_function tsfn = arg;
+  producer_data* data;
+  uint32_t i;
+  napi_status status = napi_get_threadsafe_function_context(tsfn,
+                                                            (void**)&data);
+  assert(status == napi_ok);
+  for (i = 0; i < data->count; i++) {
+    status = napi_call_threadsafe_function(tsfn, &item, napi_tsfn_blocking);
+    assert(status == napi_ok);
+  }
+  status = napi_release_threadsafe_function(tsfn, napi_tsfn_release);
+  assert(status == napi_ok);
+}
+
+static void CallJsWithCount(napi_env env, napi_value cb, size_t count) {
+  napi_value argv, undefined;
+  napi_status status = napi_create_uint32(env, (uint32_t)count, &argv);
+  assert(status == napi_ok);
+  status = napi_get_undefined(env, &undefined);
+  assert(status == napi_ok);
+  status = napi_call_function(env, undefined, cb, 1, &argv, NULL);
+  assert(status == napi_ok);
+}
+
+static void CallJs(napi_env env, napi_value cb, void* context, void* data) {
+  if (env != NULL)
+    CallJsWithCount(env, cb, 1);
+}
+
+static void CallJsBatch(napi_env env,
+                        napi_value cb,
+                        void* context,
+                        void** data,
+                        size_t count) {
+  if (env != NULL)
+    CallJsWithCount(env, cb, count);
+}
+
+static void Finalize(napi_env env, void* finalize_data, void* context) {
+  producer_data* data = finalize_data;
+  napi_value done, undefined;
+  napi_status status;
+  uv_thread_join(&data->thread);
+  status = napi_get_reference_value(env, data->done, &done);
+  assert(status == napi_ok);
+  status = napi_delete_reference(env, data->done);
+  assert(status == napi_ok);
+  status = napi_get_undefined(env, &undefined);
+  assert(status == napi_ok);
+  status = napi_call_function(env, undefined, done, 0, NULL, NULL);
+  assert(status == napi_ok);
+}
+
+// start(callback, done, count, batchSize) calls |callback| with the number of
+// items it is passed until |count| items have been produced, then calls |done|.
+// A |batchSize| of 0 dispatches the items one at a time.
+static napi_value Start(napi_env env, napi_callback_info info) {
+  static producer_data data;
+  size_t argc = 4;
+  napi_value argv[4], name;
+  uint32_t batch_size;
+  napi_threadsafe_function tsfn;
+  napi_status status;
+
+  status = napi_get_cb_info(env, info, &argc, argv, NULL, NULL);
+  assert(status == napi_ok && argc == 4);
+  status = napi_create_reference(env, argv[1], 1, &data.done);
+  assert(status == napi_ok);
+  status = napi_get_value_uint32(env, argv[2], &data.count);
+  assert(status == napi_ok);
+  status = napi_get_value_uint32(env, argv[3], &batch_size);
+  assert(status == napi_ok);
+  status = napi_create_string_utf8(env, "producer", NAPI_AUTO_LENGTH, &name);
+  assert(status == napi_ok);
+
+  status = napi_create_threadsafe_function(env,
+                                           argv[0],
+                                           NULL,
+                                           name,
+                                           MAX_QUEUE_SIZE,
+                                           1,
+                                           &data,
+                                           Finalize,
+                                           &data,
+                                           CallJs,
+                                           &tsfn);
+  assert(status == napi_ok);
+  if (batch_size > 0) {
+    status = napi_set_threadsafe_function_batching(env,
+                                                   tsfn,
+                                                   batch_size,
+                                                   CallJsBatch);
+    assert(status == napi_ok);
+  }
+
+  if (uv_thread_create(&data.thread, Produce, tsfn) != 0)
+    assert(0 && "failed to start the producer thread");
+
+  return NULL;
+}
+
+NAPI_MODULE_INIT() {
+  napi_value start;
+  napi_status status =
+      napi_create_function(env,
+                           "start",
+                           NAPI_AUTO_LENGTH,
+                           Start,
+                           NULL,
+                           &start);
+  assert(status == napi_ok);
+  status = napi_set_named_property(env, exports, "start", start);
+  assert(status == napi_ok);
+  return exports;
+}
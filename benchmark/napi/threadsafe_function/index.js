@@ -0,0 +1,31 @@
+// Measures how many items per second a thread-safe function delivers to
+// JavaScript from a producer thread, when items are dispatched one at a time
+// and when they are dispatched in batches.
+'use strict';
+
+const assert = require('assert');
+const common = require('../../common.js');
+
+let binding;
+try {
+  binding = require(`./build/${common.buildType}/binding`);
+} catch {
+  console.error(`${__filename}: Binding failed to load`);
+  process.exit(0);
+}
+
+const bench = common.createBenchmark(main, {
+  batchSize: [0, 16, 256],
+  n: [1e6]
+});
+
+function main({ n, batchSize }) {
+  let received = 0;
+  bench.start();
+  binding.start((count) => {
+    received += count;
+  }, () => {
+    assert.strictEqual(received, n);
+    bench.end(n);
+  }, n, batchSize);
+}
@@ -0,0 +1,44 @@
+// Measures how many connections per second a server accepts while many
+// clients connect at the same time, with and without accept batching.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+const PORT = common.PORT;
+
+const bench = common.createBenchmark(main, {
+  acceptBatchSize: [1, 16, 128],
+  conns: [100, 500],
+  dur: [5],
+});
+
+function main({ dur, conns, acceptBatchSize }) {
+  let accepted = 0;
+  let running = true;
+
+  const server = net.createServer((socket) => {
+    accepted++;
+    socket.destroy();
+  });
+
+  server.listen({ port: PORT, acceptBatchSize }, () => {
+    bench.start();
+    for (let i = 0; i < conns; i++)
+      connect();
+
+    setTimeout(() => {
+      running = false;
+      bench.end(accepted);
+      process.exit(0);
+    }, dur * 1000);
+  });
+
+  function connect() {
+    net.connect(PORT)
+      .on('error', () => {})
+      .on('close', () => {
+        if (running)
+          connect();
+      });
+  }
+}
@@ -1,4 +1,6 @@
-// Test the speed of .pipe() with sockets
+// Test the speed of .pipe() with sockets that are written to in small
+// chunks, either with explicit cork()/uncork() calls or relying on the
+// write coalescing of net.Socket, or with neither.
 'use strict';
 
 const common = require('../common.js');
@@ -8,13 +10,14 @@ const PORT = common.PORT;
 const bench = common.createBenchmark(main, {
   len: [4, 8, 16, 32, 64, 128, 512, 1024],
   type: ['buf'],
+  mode: ['cork', 'coalesce', 'none'],
   dur: [5],
 });
 
 var chunk;
 var encoding;
 
-function main({ dur, len, type }) {
+function main({ dur, len, type, mode }) {
   switch (type) {
     case 'buf':
       chunk = Buffer.alloc(len, 'x');
@@ -40,6 +43,7 @@ function main({ dur, len, type }) {
 
   server.listen(PORT, () => {
     const socket = net.connect(PORT);
+    socket.setWriteCoalescing(mode !== 'none');
     socket.on('connect', () => {
       bench.start();
 
@@ -54,9 +58,11 @@ function main({ dur, len, type }) {
       }, dur * 1000);
 
       function send() {
-        socket.cork();
+        if (mode === 'cork')
+          socket.cork();
         while (socket.write(chunk, encoding)) {}
-        socket.uncork();
+        if (mode === 'cork')
+          socket.uncork();
       }
     });
   });
@@ -0,0 +1,55 @@
+// Test the throughput of many concurrent client-to-server connections
+// that each send small chunks, which stresses per-read allocation.
+'use strict';
+
+const common = require('../common.js');
+const net = require('net');
+const PORT = common.PORT;
+
+const bench = common.createBenchmark(main, {
+  conns: [1, 100, 1000],
+  len: [64, 1024, 16384],
+  dur: [5],
+});
+
+function main({ dur, len, conns }) {
+  const chunk = Buffer.alloc(len, 'x');
+  let received = 0;
+  let connected = 0;
+  const sockets = [];
+
+  const server = net.createServer((socket) => {
+    socket.on('data', (data) => {
+      received += data.length;
+    });
+  });
+
+  server.listen(PORT, () => {
+    for (let i = 0; i < conns; i++) {
+      const socket = net.connect(PORT);
+      sockets.push(socket);
+      socket.on('connect', () => {
+        if (++connected === conns)
+          start();
+      });
+    }
+  });
+
+  function start() {
+    bench.start();
+
+    for (const socket of sockets)
+      flow(socket);
+
+    setTimeout(() => {
+      const gbits = (received * 8) / (1024 * 1024 * 1024);
+      bench.end(gbits);
+      process.exit(0);
+    }, dur * 1000);
+  }
+
+  function flow(socket) {
+    while (socket.write(chunk));
+    socket.once('drain', () => flow(socket));
+  }
+}
@@ -0,0 +1,65 @@
+'use strict';
+// Runs a mix of fs, crypto and dns.lookup() calls that all compete for
+// libuv's threadpool, with and without --threadpool-max-size. The calls run
+// in a child process so that the threadpool can be configured for it.
+const { fork } = require('child_process');
+
+if (process.argv[2] === 'child') {
+  child(+process.argv[3], +process.argv[4]);
+} else {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    maxSize: [0, 16],
+    concurrency: [64],
+    n: [2e4],
+  });
+
+  function main({ maxSize, concurrency, n }) {
+    const execArgv = [];
+    if (maxSize > 0)
+      execArgv.push(`--threadpool-max-size=${maxSize}`);
+    const proc = fork(__filename, ['child', concurrency, n], {
+      execArgv,
+      env: { ...process.env, UV_THREADPOOL_SIZE: '4' }
+    });
+    proc.on('message', ({ elapsed }) => {
+      bench.report(n / (elapsed[0] + elapsed[1] / 1e9), elapsed);
+    });
+  }
+}
+
+function child(concurrency, n) {
+  const crypto = require('crypto');
+  const dns = require('dns');
+  const fs = require('fs');
+  const assert = require('assert');
+
+  const tasks = [
+    (cb) => fs.stat(__filename, cb),
+    (cb) => crypto.pbkdf2('secret', 'salt', 1000, 32, 'sha256', cb),
+    (cb) => dns.lookup('localhost', cb),
+  ];
+
+  let started = 0;
+  let finished = 0;
+  const start = process.hrtime();
+
+  function next() {
+    if (started === n)
+      return;
+    tasks[started++ % tasks.length](done);
+  }
+
+  function done(err) {
+    assert.ifError(err);
+    if (++finished === n) {
+      const elapsed = process.hrtime(start);
+      process.send({ elapsed }, () => process.disconnect());
+      return;
+    }
+    next();
+  }
+
+  for (let i = 0; i < Math.min(concurrency, n); i++)
+    next();
+}
@@ -0,0 +1,60 @@
+'use strict';
+// Timers with many distinct durations, such as per-connection idle timeouts
+// or per-request deadlines, end up in many separate timer lists.
+const common = require('../common.js');
+const assert = require('assert');
+
+const bench = common.createBenchmark(main, {
+  operation: ['insert', 'cancel', 'breadth'],
+  n: [1e6],
+});
+
+// Fixed seed, so that every run uses the same durations.
+let seed = 1;
+function randomDuration() {
+  seed = (seed * 16807) % 2147483647;
+  return 1 + seed % 1000;
+}
+
+function main({ operation, n }) {
+  const durations = [];
+  for (let i = 0; i < n; i++)
+    durations.push(randomDuration());
+
+  const timers = [];
+  switch (operation) {
+    case 'insert':
+      bench.start();
+      for (let i = 0; i < n; i++)
+        timers.push(setTimeout(fail, durations[i]));
+      bench.end(n);
+      for (let i = 0; i < n; i++)
+        clearTimeout(timers[i]);
+      break;
+    case 'cancel':
+      for (let i = 0; i < n; i++)
+        timers.push(setTimeout(fail, durations[i]));
+      bench.start();
+      for (let i = 0; i < n; i++)
+        clearTimeout(timers[i]);
+      bench.end(n);
+      break;
+    case 'breadth': {
+      let fired = 0;
+      const cb = () => {
+        if (++fired === n)
+          bench.end(n);
+      };
+      bench.start();
+      for (let i = 0; i < n; i++)
+        setTimeout(cb, durations[i]);
+      break;
+    }
+    default:
+      throw new Error(`Unsupported operation "${operation}"`);
+  }
+}
+
+function fail() {
+  assert.fail(`Timer ${this._idleTimeout} should not call callback`);
+}
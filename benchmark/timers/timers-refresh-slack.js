@@ -0,0 +1,57 @@
+'use strict';
+// Measures the cost of refreshing the idle timeouts of many sockets, as
+// net.Socket does on every read and write, with and without --timer-slack.
+// The timeouts live in a child process that is started with the flag.
+const { fork } = require('child_process');
+
+if (process.argv[2] === 'child') {
+  child(+process.argv[3], +process.argv[4]);
+} else {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    timers: [1e5],
+    slack: [0, 100],
+    n: [5e6],
+  });
+
+  function main({ timers, slack, n }) {
+    const proc = fork(__filename, ['child', timers, n], {
+      execArgv: ['--expose-internals', `--timer-slack=${slack}`]
+    });
+    proc.on('message', ({ elapsed }) => {
+      bench.report(n / (elapsed[0] + elapsed[1] / 1e9), elapsed);
+    });
+  }
+}
+
+function child(timers, n) {
+  const { setUnrefTimeout } = require('internal/timers');
+  const list = [];
+  for (let i = 0; i < timers; i++)
+    list.push(setUnrefTimeout(fail, 60000 + i % 1000));
+
+  // Refresh in batches, so that the event loop's clock moves on in between.
+  const kBatchSize = 10000;
+  let refreshed = 0;
+  let elapsed = [0, 0];
+  (function batch() {
+    const start = process.hrtime();
+    const end = Math.min(refreshed + kBatchSize, n);
+    for (; refreshed < end; refreshed++)
+      list[refreshed % timers].refresh();
+    const time = process.hrtime(start);
+    elapsed = [elapsed[0] + time[0], elapsed[1] + time[1]];
+
+    if (refreshed < n) {
+      setImmediate(batch);
+      return;
+    }
+    for (const timer of list)
+      clearTimeout(timer);
+    process.send({ elapsed }, () => process.disconnect());
+  })();
+}
+
+function fail() {
+  throw new Error('Timeout should not fire');
+}
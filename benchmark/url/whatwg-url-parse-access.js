@@ -0,0 +1,82 @@
+'use strict';
+const common = require('../common.js');
+const URL = require('url').URL;
+const assert = require('assert');
+
+// Parses URLs and reads a subset of their components, the way a proxy or
+// router would.
+const bench = common.createBenchmark(main, {
+  type: common.urlDataTypes,
+  access: ['none', 'pathname', 'href', 'all'],
+  e: [1]
+});
+
+function accessNone(data) {
+  const len = data.length;
+  var result = new URL(data[0]);  // Avoid dead code elimination
+  bench.start();
+  for (var i = 0; i < len; ++i) {
+    result = new URL(data[i]);
+  }
+  bench.end(len);
+  return result;
+}
+
+function accessPathname(data) {
+  const len = data.length;
+  var result = '';
+  bench.start();
+  for (var i = 0; i < len; ++i) {
+    const url = new URL(data[i]);
+    result = url.pathname + url.search;
+  }
+  bench.end(len);
+  return result;
+}
+
+function accessHref(data) {
+  const len = data.length;
+  var result = '';
+  bench.start();
+  for (var i = 0; i < len; ++i) {
+    result = new URL(data[i]).href;
+  }
+  bench.end(len);
+  return result;
+}
+
+function accessAll(data) {
+  const len = data.length;
+  var result = '';
+  bench.start();
+  for (var i = 0; i < len; ++i) {
+    const url = new URL(data[i]);
+    result = url.protocol + url.username + url.password + url.host +
+             url.pathname + url.search + url.hash;
+  }
+  bench.end(len);
+  return result;
+}
+
+function main({ type, access, e }) {
+  const data = common.bakeUrlData(type, e, false, false);
+  var noDead;  // Avoid dead code elimination.
+  switch (access) {
+    case 'none':
+      noDead = accessNone(data);
+      break;
+    case 'pathname':
+      noDead = accessPathname(data);
+      break;
+    case 'href':
+      noDead = accessHref(data);
+      break;
+    case 'all':
+      noDead = accessAll(data);
+      break;
+    default:
+      throw new Error(`Unknown access ${access}`);
+  }
+
+  assert.ok(noDead !== undefined);
+}
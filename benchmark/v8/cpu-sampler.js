@@ -0,0 +1,30 @@
+'use strict';
+
+const common = require('../common.js');
+const v8 = require('v8');
+
+const bench = common.createBenchmark(main, {
+  frequency: [0, 99, 999],
+  n: [1e6]
+});
+
+function work(depth, i) {
+  if (depth === 0)
+    return JSON.parse(JSON.stringify({ i, s: `item ${i}` })).i;
+  return work(depth - 1, i);
+}
+
+function main({ frequency, n }) {
+  if (frequency > 0)
+    v8.startCpuSampler({ frequency });
+
+  bench.start();
+  for (var i = 0; i < n; i++)
+    work(i % 16, i);
+  bench.end(n);
+
+  if (frequency > 0) {
+    v8.stopCpuSampler();
+    v8.getCpuSamplerProfile('pprof');
+  }
+}
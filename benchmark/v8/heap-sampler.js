@@ -0,0 +1,31 @@
+'use strict';
+
+const common = require('../common.js');
+const v8 = require('v8');
+
+const bench = common.createBenchmark(main, {
+  interval: [0, 128 * 1024, 512 * 1024],
+  n: [1e6]
+});
+
+function allocate(i) {
+  return { i, s: `item ${i}`, a: [i, i + 1] };
+}
+
+function main({ interval, n }) {
+  if (interval > 0)
+    v8.startHeapSampler({ interval });
+
+  // Keep a window of the allocated objects alive, so that the sampler has
+  // to track and drop samples as they are collected.
+  const live = new Array(1024);
+  bench.start();
+  for (var i = 0; i < n; i++)
+    live[i % live.length] = allocate(i);
+  bench.end(n);
+
+  if (interval > 0) {
+    v8.getHeapSamplerProfile('pprof');
+    v8.stopHeapSampler();
+  }
+}
@@ -0,0 +1,83 @@
+'use strict';
+
+// Reports the peak resident set size, in MB, of a process that writes a heap
+// snapshot of a heap holding roughly `size` MB of objects. Lower is better.
+
+const common = require('../common.js');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const isChild = process.argv[2] === 'child';
+const bench = isChild ? null : common.createBenchmark(main, {
+  method: ['stream', 'sync', 'sync-gzip', 'background'],
+  size: [64]
+});
+
+function child(method, size, filename) {
+  const v8 = require('v8');
+  const heap = [];
+  for (let i = 0; i < size * 1024; i++)
+    heap.push({ id: i, name: `object ${i}`, data: new Array(32).fill(i) });
+
+  function peakRss() {
+    try {
+      const status = fs.readFileSync('/proc/self/status', 'latin1');
+      return +/VmHWM:\s*(\d+)/.exec(status)[1] * 1024;
+    } catch {
+      return process.memoryUsage().rss;
+    }
+  }
+
+  const start = process.hrtime();
+  function done() {
+    const elapsed = process.hrtime(start);
+    process.stdout.write(JSON.stringify({
+      rss: peakRss(),
+      elapsed,
+      objects: heap.length
+    }));
+  }
+
+  switch (method) {
+    case 'stream':
+      v8.getHeapSnapshot()
+        .pipe(fs.createWriteStream(filename))
+        .on('finish', done);
+      break;
+    case 'sync':
+      v8.writeHeapSnapshot(filename);
+      done();
+      break;
+    case 'sync-gzip':
+      v8.writeHeapSnapshot(`${filename}.gz`, { compress: true });
+      done();
+      break;
+    case 'background':
+      v8.writeHeapSnapshotInBackground(filename, (err) => {
+        if (err) throw err;
+        done();
+      });
+      break;
+    default:
+      throw new Error(`Unexpected method "${method}"`);
+  }
+}
+
+function main({ method, size }) {
+  tmpdir.refresh();
+  const filename = path.join(tmpdir.path, 'bench.heapsnapshot');
+  const { stdout, status } = spawnSync(process.execPath, [
+    __filename, 'child', method, size, filename,
+  ], { encoding: 'utf8' });
+  tmpdir.refresh();
+  if (status !== 0)
+    throw new Error(`Child process exited with status ${status}`);
+
+  const { rss, elapsed } = JSON.parse(stdout);
+  bench.report(rss / (1024 * 1024), elapsed);
+}
+
+if (isChild)
+  child(process.argv[3], +process.argv[4], process.argv[5]);
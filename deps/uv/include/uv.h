@@ -545,7 +545,14 @@ UV_EXTERN int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable);
 
 enum uv_tcp_flags {
   /* Used with uv_tcp_bind, when an IPv6 address is used. */
-  UV_TCP_IPV6ONLY = 1
+  UV_TCP_IPV6ONLY = 1,
+  /*
+   * Sets SO_REUSEPORT (SO_REUSEPORT_LB on FreeBSD) before binding, so that
+   * several sockets can listen on the same address and port and the kernel
+   * distributes incoming connections across them. Fails with UV_ENOTSUP on
+   * platforms where SO_REUSEPORT does not balance the load.
+   */
+  UV_TCP_REUSEPORT = 2
 };
 
 UV_EXTERN int uv_tcp_bind(uv_tcp_t* handle,
@@ -1023,6 +1030,22 @@ UV_EXTERN int uv_queue_work(uv_loop_t* loop,
 
 UV_EXTERN int uv_cancel(uv_req_t* req);
 
+typedef struct {
+  unsigned int size;
+  unsigned int max_size;
+  unsigned int idle_threads;
+  unsigned int queued;
+  unsigned int running;
+  unsigned int slow_io_running;
+  uint64_t submitted;
+  uint64_t completed;
+  uint64_t wait_time;
+  uint64_t run_time;
+} uv_threadpool_stats_t;
+
+UV_EXTERN int uv_threadpool_get_stats(uv_threadpool_stats_t* stats);
+UV_EXTERN int uv_threadpool_set_max_size(unsigned int max_size);
+
 
 struct uv_cpu_times_s {
   uint64_t user;
@@ -25,27 +25,157 @@
 # include "unix/internal.h"
 #endif
 
+#include <assert.h>
 #include <stdlib.h>
 
 #define MAX_THREADPOOL_SIZE 128
 
+/* When the pool may grow beyond its base size, work has to be waiting for a
+ * thread for this long (in nanoseconds) before a thread is added, and added
+ * threads exit again after they have been idle for this long.
+ */
+#define THREADPOOL_GROW_DELAY ((uint64_t) 10 * 1000 * 1000)
+#define THREADPOOL_IDLE_TIMEOUT ((uint64_t) 2 * 1000 * 1000 * 1000)
+
 static uv_once_t once = UV_ONCE_INIT;
+static int initialized;
 static uv_cond_t cond;
+static uv_cond_t monitor_cond;
 static uv_mutex_t mutex;
 static unsigned int idle_threads;
 static unsigned int slow_io_work_running;
 static unsigned int nthreads;
+static unsigned int min_threads;
+static unsigned int max_threads;
+static unsigned int threads_capacity;
 static uv_thread_t* threads;
 static uv_thread_t default_threads[4];
+static uv_thread_t exited_threads[MAX_THREADPOOL_SIZE];
+static unsigned int nexited;
+static uv_thread_t monitor_thread;
+static int monitor_started;
+static uint64_t backlog_start;
+static int exiting;
 static QUEUE exit_message;
 static QUEUE wq;
 static QUEUE run_slow_work_message;
 static QUEUE slow_io_pending_wq;
 
+/* Statistics, protected by `mutex`. `wait_time` and `run_time` are the
+ * number of queued and running work items integrated over time, which is
+ * the sum of the time each item spent waiting or running.
+ */
+static unsigned int queued;
+static unsigned int running;
+static uint64_t submitted;
+static uint64_t completed;
+static uint64_t wait_time;
+static uint64_t run_time;
+static uint64_t stats_time;
+
 static unsigned int slow_work_thread_threshold(void) {
   return (nthreads + 1) / 2;
 }
 
+static void update_stats_time(void) {
+  uint64_t now;
+
+  now = uv_hrtime();
+  wait_time += queued * (now - stats_time);
+  run_time += running * (now - stats_time);
+  stats_time = now;
+}
+
+static void worker(void* arg);
+
+/* Adds a thread to the pool if work has been waiting for one for a while.
+ * `mutex` must be locked.
+ */
+static void maybe_grow(void) {
+  uv_thread_t* new_threads;
+  uint64_t now;
+
+  if (exiting ||
+      nthreads >= max_threads ||
+      idle_threads > 0 ||
+      QUEUE_EMPTY(&wq)) {
+    backlog_start = 0;
+    return;
+  }
+
+  now = uv_hrtime();
+  if (backlog_start == 0) {
+    backlog_start = now;
+    /* Have the monitor check again if nothing else happens in the pool. */
+    uv_cond_signal(&monitor_cond);
+    return;
+  }
+  if (now - backlog_start < THREADPOOL_GROW_DELAY)
+    return;
+  backlog_start = now;
+
+  /* Threads that exited after being idle have released `mutex` and do not
+   * acquire it again, so they can be joined here.
+   */
+  while (nexited > 0)
+    if (uv_thread_join(exited_threads + --nexited))
+      abort();
+
+  if (nthreads == threads_capacity) {
+    new_threads = uv__malloc(MAX_THREADPOOL_SIZE * sizeof(threads[0]));
+    if (new_threads == NULL)
+      return;
+    memcpy(new_threads, threads, nthreads * sizeof(threads[0]));
+    if (threads != default_threads)
+      uv__free(threads);
+    threads = new_threads;
+    threads_capacity = MAX_THREADPOOL_SIZE;
+  }
+
+  if (uv_thread_create(threads + nthreads, worker, NULL) == 0)
+    nthreads++;
+}
+
+/* maybe_grow() is called when work is posted or picked up. If all threads
+ * are blocked, neither of these happens, so this thread calls it again after
+ * THREADPOOL_GROW_DELAY for as long as work is waiting. It only runs while
+ * the pool may grow.
+ */
+static void monitor(void* arg) {
+  uv_mutex_lock(&mutex);
+  while (!exiting) {
+    if (backlog_start == 0)
+      uv_cond_wait(&monitor_cond, &mutex);
+    else
+      uv_cond_timedwait(&monitor_cond, &mutex, THREADPOOL_GROW_DELAY);
+    maybe_grow();
+  }
+  uv_mutex_unlock(&mutex);
+}
+
+/* `mutex` must be locked. */
+static void maybe_start_monitor(void) {
+  if (monitor_started || max_threads <= min_threads)
+    return;
+  if (uv_thread_create(&monitor_thread, monitor, NULL) == 0)
+    monitor_started = 1;
+}
+
+/* Removes the calling thread from the pool. `mutex` must be locked. */
+static void remove_thread(void) {
+  uv_thread_t self;
+  unsigned int i;
+
+  self = uv_thread_self();
+  for (i = 0; i < nthreads; i++)
+    if (uv_thread_equal(threads + i, &self))
+      break;
+  assert(i < nthreads);
+
+  exited_threads[nexited++] = threads[i];
+  threads[i] = threads[--nthreads];
+}
+
 static void uv__cancelled(struct uv__work* w) {
   abort();
 }
@@ -58,8 +188,11 @@ static void worker(void* arg) {
   struct uv__work* w;
   QUEUE* q;
   int is_slow_work;
+  int err;
 
-  uv_sem_post((uv_sem_t*) arg);
+  /* Threads that are added to a running pool are not waited for. */
+  if (arg != NULL)
+    uv_sem_post((uv_sem_t*) arg);
   arg = NULL;
 
   uv_mutex_lock(&mutex);
@@ -73,8 +206,21 @@ static void worker(void* arg) {
             QUEUE_NEXT(&run_slow_work_message) == &wq &&
             slow_io_work_running >= slow_work_thread_threshold())) {
       idle_threads += 1;
-      uv_cond_wait(&cond, &mutex);
+      err = 0;
+      if (nthreads > min_threads)
+        err = uv_cond_timedwait(&cond, &mutex, THREADPOOL_IDLE_TIMEOUT);
+      else
+        uv_cond_wait(&cond, &mutex);
       idle_threads -= 1;
+
+      /* Shrink back towards the base size when there is nothing to do. */
+      if (err == UV_ETIMEDOUT &&
+          nthreads > min_threads &&
+          QUEUE_EMPTY(&wq)) {
+        remove_thread();
+        uv_mutex_unlock(&mutex);
+        return;
+      }
     }
 
     q = QUEUE_HEAD(&wq);
@@ -116,6 +262,11 @@ static void worker(void* arg) {
       }
     }
 
+    update_stats_time();
+    queued--;
+    running++;
+    maybe_grow();
+
     uv_mutex_unlock(&mutex);
 
     w = QUEUE_DATA(q, struct uv__work, wq);
@@ -131,6 +282,9 @@ static void worker(void* arg) {
     /* Lock `mutex` since that is expected at the start of the next
      * iteration. */
     uv_mutex_lock(&mutex);
+    update_stats_time();
+    running--;
+    completed++;
     if (is_slow_work) {
       /* `slow_io_work_running` is protected by `mutex`. */
       slow_io_work_running--;
@@ -141,6 +295,15 @@ static void worker(void* arg) {
 
 static void post(QUEUE* q, enum uv__work_kind kind) {
   uv_mutex_lock(&mutex);
+  if (q == &exit_message) {
+    exiting = 1;
+    uv_cond_signal(&monitor_cond);
+  } else {
+    update_stats_time();
+    queued++;
+    submitted++;
+  }
+
   if (kind == UV__WORK_SLOW_IO) {
     /* Insert into a separate queue. */
     QUEUE_INSERT_TAIL(&slow_io_pending_wq, q);
@@ -156,6 +319,8 @@ static void post(QUEUE* q, enum uv__work_kind kind) {
   QUEUE_INSERT_TAIL(&wq, q);
   if (idle_threads > 0)
     uv_cond_signal(&cond);
+  else if (q != &exit_message)
+    maybe_grow();
   uv_mutex_unlock(&mutex);
 }
 
@@ -173,14 +338,26 @@ UV_DESTRUCTOR(static void cleanup(void)) {
     if (uv_thread_join(threads + i))
       abort();
 
+  for (i = 0; i < nexited; i++)
+    if (uv_thread_join(exited_threads + i))
+      abort();
+
+  if (monitor_started)
+    if (uv_thread_join(&monitor_thread))
+      abort();
+
   if (threads != default_threads)
     uv__free(threads);
 
   uv_mutex_destroy(&mutex);
   uv_cond_destroy(&cond);
+  uv_cond_destroy(&monitor_cond);
 
   threads = NULL;
   nthreads = 0;
+  nexited = 0;
+  monitor_started = 0;
+  initialized = 0;
 }
 #endif
 
@@ -200,17 +377,38 @@ static void init_threads(void) {
     nthreads = MAX_THREADPOOL_SIZE;
 
   threads = default_threads;
+  threads_capacity = ARRAY_SIZE(default_threads);
   if (nthreads > ARRAY_SIZE(default_threads)) {
     threads = uv__malloc(nthreads * sizeof(threads[0]));
+    threads_capacity = nthreads;
     if (threads == NULL) {
       nthreads = ARRAY_SIZE(default_threads);
       threads = default_threads;
+      threads_capacity = nthreads;
     }
   }
 
+  min_threads = nthreads;
+  if (max_threads < min_threads)
+    max_threads = min_threads;
+  nexited = 0;
+  monitor_started = 0;
+  backlog_start = 0;
+  exiting = 0;
+  queued = 0;
+  running = 0;
+  submitted = 0;
+  completed = 0;
+  wait_time = 0;
+  run_time = 0;
+  stats_time = uv_hrtime();
+
   if (uv_cond_init(&cond))
     abort();
 
+  if (uv_cond_init(&monitor_cond))
+    abort();
+
   if (uv_mutex_init(&mutex))
     abort();
 
@@ -229,6 +427,11 @@ static void init_threads(void) {
     uv_sem_wait(&sem);
 
   uv_sem_destroy(&sem);
+
+  uv_mutex_lock(&mutex);
+  maybe_start_monitor();
+  initialized = 1;
+  uv_mutex_unlock(&mutex);
 }
 
 
@@ -236,6 +439,7 @@ static void init_threads(void) {
 static void reset_once(void) {
   uv_once_t child_once = UV_ONCE_INIT;
   memcpy(&once, &child_once, sizeof(child_once));
+  initialized = 0;
 }
 #endif
 
@@ -273,8 +477,11 @@ static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
   uv_mutex_lock(&w->loop->wq_mutex);
 
   cancelled = !QUEUE_EMPTY(&w->wq) && w->work != NULL;
-  if (cancelled)
+  if (cancelled) {
     QUEUE_REMOVE(&w->wq);
+    update_stats_time();
+    queued--;
+  }
 
   uv_mutex_unlock(&w->loop->wq_mutex);
   uv_mutex_unlock(&mutex);
@@ -382,3 +589,47 @@ int uv_cancel(uv_req_t* req) {
 
   return uv__work_cancel(loop, req, wreq);
 }
+
+
+int uv_threadpool_get_stats(uv_threadpool_stats_t* stats) {
+  if (stats == NULL)
+    return UV_EINVAL;
+
+  uv_once(&once, init_once);
+  uv_mutex_lock(&mutex);
+  update_stats_time();
+  stats->size = nthreads;
+  stats->max_size = max_threads;
+  stats->idle_threads = idle_threads;
+  stats->queued = queued;
+  stats->running = running;
+  stats->slow_io_running = slow_io_work_running;
+  stats->submitted = submitted;
+  stats->completed = completed;
+  stats->wait_time = wait_time;
+  stats->run_time = run_time;
+  uv_mutex_unlock(&mutex);
+
+  return 0;
+}
+
+
+int uv_threadpool_set_max_size(unsigned int max_size) {
+  if (max_size > MAX_THREADPOOL_SIZE)
+    return UV_EINVAL;
+
+  /* Before the pool has been started, only remember the size, so that setting
+   * it does not start any threads. init_threads() applies it.
+   */
+  if (!initialized) {
+    max_threads = max_size;
+    return 0;
+  }
+
+  uv_mutex_lock(&mutex);
+  max_threads = max_size < min_threads ? min_threads : max_size;
+  maybe_start_monitor();
+  uv_mutex_unlock(&mutex);
+
+  return 0;
+}
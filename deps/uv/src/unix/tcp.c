@@ -145,6 +145,29 @@ int uv_tcp_init(uv_loop_t* loop, uv_tcp_t* tcp) {
 }
 
 
+static int uv__tcp_reuseport(int fd) {
+#if defined(__linux__) && defined(SO_REUSEPORT)
+  /* Linux >= 3.9 distributes connections across the sockets. */
+  int on;
+
+  on = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)))
+    return UV__ERR(errno);
+  return 0;
+#elif defined(__FreeBSD__) && defined(SO_REUSEPORT_LB)
+  int on;
+
+  on = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT_LB, &on, sizeof(on)))
+    return UV__ERR(errno);
+  return 0;
+#else
+  /* Elsewhere, the last socket to bind gets all connections. */
+  return UV_ENOTSUP;
+#endif
+}
+
+
 int uv__tcp_bind(uv_tcp_t* tcp,
                  const struct sockaddr* addr,
                  unsigned int addrlen,
@@ -164,6 +187,12 @@ int uv__tcp_bind(uv_tcp_t* tcp,
   if (setsockopt(tcp->io_watcher.fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)))
     return UV__ERR(errno);
 
+  if (flags & UV_TCP_REUSEPORT) {
+    err = uv__tcp_reuseport(tcp->io_watcher.fd);
+    if (err)
+      return err;
+  }
+
 #ifndef __OpenBSD__
 #ifdef IPV6_V6ONLY
   if (addr->sa_family == AF_INET6) {
@@ -305,6 +305,10 @@ static int uv_tcp_try_bind(uv_tcp_t* handle,
     if ((flags & UV_TCP_IPV6ONLY) && addr->sa_family != AF_INET6)
       return ERROR_INVALID_PARAMETER;
 
+    /* SO_REUSEPORT does not exist. */
+    if (flags & UV_TCP_REUSEPORT)
+      return ERROR_NOT_SUPPORTED;
+
     sock = socket(addr->sa_family, SOCK_STREAM, 0);
     if (sock == INVALID_SOCKET) {
       return WSAGetLastError();
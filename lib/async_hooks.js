@@ -1,6 +1,6 @@
 'use strict';
 
-const { Reflect } = primordials;
+const { Reflect, SafeMap } = primordials;
 
 const {
   ERR_ASYNC_CALLBACK,
@@ -28,13 +28,18 @@ const {
   emitAfter,
   emitDestroy,
   initHooksExist,
+  captureContextFrame,
+  getContextFrame,
+  setContextFrame,
+  enableContextFrames,
+  disableContextFrames,
 } = internal_async_hooks;
 
 // Get symbols
 const {
   async_id_symbol, trigger_async_id_symbol,
   init_symbol, before_symbol, after_symbol, destroy_symbol,
-  promise_resolve_symbol
+  promise_resolve_symbol, context_frame_symbol
 } = internal_async_hooks.symbols;
 
 // Get constants
@@ -151,6 +156,7 @@ class AsyncResource {
     const asyncId = newAsyncId();
     this[async_id_symbol] = asyncId;
     this[trigger_async_id_symbol] = triggerAsyncId;
+    this[context_frame_symbol] = captureContextFrame();
 
     if (initHooksExist()) {
       emitInit(asyncId, type, triggerAsyncId, this);
@@ -166,7 +172,7 @@ class AsyncResource {
 
   runInAsyncScope(fn, thisArg, ...args) {
     const asyncId = this[async_id_symbol];
-    emitBefore(asyncId, this[trigger_async_id_symbol]);
+    emitBefore(asyncId, this[trigger_async_id_symbol], this);
     try {
       if (thisArg === undefined)
         return fn(...args);
@@ -194,6 +200,83 @@ class AsyncResource {
 }
 
 
+// AsyncLocalStorage //
+
+// A context frame is an immutable Map from AsyncLocalStorage instances to
+// their stores. Entering a store creates a new frame, so frames that were
+// captured by pending resources never change.
+function withStore(frame, storage, store) {
+  const newFrame = new SafeMap(frame);
+  newFrame.set(storage, store);
+  return newFrame;
+}
+
+function withoutStore(frame, storage) {
+  if (frame === undefined || !frame.has(storage))
+    return frame;
+  const newFrame = new SafeMap(frame);
+  newFrame.delete(storage);
+  return newFrame.size === 0 ? undefined : newFrame;
+}
+
+class AsyncLocalStorage {
+  constructor() {
+    this.enabled = false;
+  }
+
+  disable() {
+    if (this.enabled) {
+      this.enabled = false;
+      disableContextFrames();
+    }
+  }
+
+  getStore() {
+    if (!this.enabled)
+      return undefined;
+    const frame = getContextFrame();
+    return frame === undefined ? undefined : frame.get(this);
+  }
+
+  run(store, callback, ...args) {
+    this._enable();
+    const previous = getContextFrame();
+    setContextFrame(withStore(previous, this, store));
+    try {
+      return callback(...args);
+    } finally {
+      setContextFrame(previous);
+    }
+  }
+
+  exit(callback, ...args) {
+    if (!this.enabled)
+      return callback(...args);
+    const previous = getContextFrame();
+    setContextFrame(withoutStore(previous, this));
+    try {
+      return callback(...args);
+    } finally {
+      setContextFrame(previous);
+    }
+  }
+
+  // Replaces the store for the remainder of the current synchronous
+  // execution and for the resources that are created during it.
+  enterWith(store) {
+    this._enable();
+    setContextFrame(withStore(getContextFrame(), this, store));
+  }
+
+  _enable() {
+    if (!this.enabled) {
+      this.enabled = true;
+      enableContextFrames();
+    }
+  }
+}
+
+
 // Placing all exports down here because the exported classes won't export
 // otherwise.
 module.exports = {
@@ -203,4 +286,5 @@ module.exports = {
   triggerAsyncId,
   // Embedder API
   AsyncResource,
+  AsyncLocalStorage,
 };
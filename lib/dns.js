@@ -266,6 +266,23 @@ function resolve(hostname, rrtype, callback) {
   }
 }
 
+const cacheValues = new Float64Array(5);
+
+function getCacheStatistics() {
+  cares.getCacheStatistics(cacheValues);
+  return {
+    hits: cacheValues[0],
+    misses: cacheValues[1],
+    coalesced: cacheValues[2],
+    evictions: cacheValues[3],
+    entries: cacheValues[4]
+  };
+}
+
+function clearCache() {
+  cares.clearCache();
+}
+
 function defaultResolverSetServers(servers) {
   const resolver = new Resolver();
 
@@ -280,6 +297,8 @@ function defaultResolverSetServers(servers) {
 module.exports = {
   lookup,
   lookupService,
+  getCacheStatistics,
+  clearCache,
 
   Resolver,
   setServers: defaultResolverSetServers,
@@ -40,6 +40,16 @@ const { async_hook_fields, async_id_fields, owner_symbol } = async_wrap;
 // case of a fatal exception this stack is emptied after calling each hook's
 // after() callback.
 const { pushAsyncIds: pushAsyncIds_, popAsyncIds: popAsyncIds_ } = async_wrap;
+// async_context_frame[0] is the current context frame, the value in which
+// AsyncLocalStorage instances keep their stores. C++ captures it when native
+// resources and promises are created and restores it around their callbacks.
+// JS resources capture it in context_frame_symbol and emitBefore() and
+// emitAfter() restore it. All of this only happens while
+// async_hook_fields[kContextFrames] is not 0.
+const { async_context_frame, resetContextFrames } = async_wrap;
+// The frames that were current when the JS resources on the async id stack
+// were entered.
+const contextFrameStack = [];
 // For performance reasons, only track Promises when a hook is enabled.
 const { enablePromiseHook, disablePromiseHook } = async_wrap;
 // Properties in active_hooks are used to keep track of the set of hooks being
@@ -76,11 +86,13 @@ const { enqueueMicrotask } = internalBinding('task_queue');
 // for a given step, that step can bail out early.
 const { kInit, kBefore, kAfter, kDestroy, kTotals, kPromiseResolve,
         kCheck, kExecutionAsyncId, kAsyncIdCounter, kTriggerAsyncId,
-        kDefaultTriggerAsyncId, kStackLength } = async_wrap.constants;
+        kDefaultTriggerAsyncId, kStackLength,
+        kContextFrames } = async_wrap.constants;
 
 // Used in AsyncHook and AsyncResource.
 const async_id_symbol = Symbol('asyncId');
 const trigger_async_id_symbol = Symbol('triggerAsyncId');
+const context_frame_symbol = Symbol('contextFrame');
 const init_symbol = Symbol('init');
 const before_symbol = Symbol('before');
 const after_symbol = Symbol('after');
@@ -342,7 +354,7 @@ function emitInitScript(asyncId, type, triggerAsyncId, resource) {
 }
 
 
-function emitBeforeScript(asyncId, triggerAsyncId) {
+function emitBeforeScript(asyncId, triggerAsyncId, resource) {
   // Validate the ids. An id of -1 means it was never set and is visible on the
   // call graph. An id < -1 should never happen in any circumstance. Throw
   // on user calls because async state should still be recoverable.
@@ -351,6 +363,12 @@ function emitBeforeScript(asyncId, triggerAsyncId) {
 
   pushAsyncIds(asyncId, triggerAsyncId);
 
+  if (async_hook_fields[kContextFrames] > 0) {
+    contextFrameStack.push(async_context_frame[0]);
+    async_context_frame[0] =
+      resource === undefined ? undefined : resource[context_frame_symbol];
+  }
+
   if (async_hook_fields[kBefore] > 0)
     emitBeforeNative(asyncId);
 }
@@ -362,6 +380,11 @@ function emitAfterScript(asyncId) {
   if (async_hook_fields[kAfter] > 0)
     emitAfterNative(asyncId);
 
+  // If the frames were enabled after emitBefore(), the stack is empty and
+  // undefined, which was current at that point, is restored.
+  if (async_hook_fields[kContextFrames] > 0)
+    async_context_frame[0] = contextFrameStack.pop();
+
   popAsyncIds(asyncId);
 }
 
@@ -382,6 +405,8 @@ function clearAsyncIdStack() {
   async_id_fields[kExecutionAsyncId] = 0;
   async_id_fields[kTriggerAsyncId] = 0;
   async_hook_fields[kStackLength] = 0;
+  async_context_frame[0] = undefined;
+  contextFrameStack.length = 0;
 }
 
 
@@ -422,6 +447,38 @@ function popAsyncIds(asyncId) {
 }
 
 
+// Context frames //
+
+// Returns the frame that a resource created now should restore when its
+// callbacks run.
+function captureContextFrame() {
+  if (async_hook_fields[kContextFrames] === 0)
+    return undefined;
+  return async_context_frame[0];
+}
+
+function getContextFrame() {
+  return async_context_frame[0];
+}
+
+function setContextFrame(frame) {
+  async_context_frame[0] = frame;
+}
+
+// Called when an AsyncLocalStorage is first used and when it is disabled.
+function enableContextFrames() {
+  if (async_hook_fields[kContextFrames]++ === 0)
+    resetContextFrames();
+}
+
+function disableContextFrames() {
+  if (--async_hook_fields[kContextFrames] === 0) {
+    contextFrameStack.length = 0;
+    resetContextFrames();
+  }
+}
+
+
 function executionAsyncId() {
   return async_id_fields[kExecutionAsyncId];
 }
@@ -439,7 +496,7 @@ module.exports = {
   symbols: {
     async_id_symbol, trigger_async_id_symbol,
     init_symbol, before_symbol, after_symbol, destroy_symbol,
-    promise_resolve_symbol, owner_symbol
+    promise_resolve_symbol, owner_symbol, context_frame_symbol
   },
   constants: {
     kInit, kBefore, kAfter, kDestroy, kTotals, kPromiseResolve
@@ -462,6 +519,11 @@ module.exports = {
   emitAfter: emitAfterScript,
   emitDestroy: emitDestroyScript,
   registerDestroyHook,
+  captureContextFrame,
+  getContextFrame,
+  setContextFrame,
+  enableContextFrames,
+  disableContextFrames,
   nativeHooks: {
     init: emitInitNative,
     before: emitBeforeNative,
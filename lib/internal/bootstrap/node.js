@@ -111,6 +111,7 @@ if (isMainThread) {
   process.hrtime.bigint = wrapped.hrtimeBigInt;
   process.cpuUsage = wrapped.cpuUsage;
   process.memoryUsage = wrapped.memoryUsage;
+  process.threadpoolUsage = wrapped.threadpoolUsage;
   process.kill = wrapped.kill;
   process.exit = wrapped.exit;
 }
@@ -31,6 +31,10 @@ function prepareMainThreadExecution(expandArgv1 = false) {
 
   initializeHeapSnapshotSignalHandlers();
 
+  initializeSampler('--cpu-sampler', 'Cpu', ['frequency', 'duration']);
+
+  initializeSampler('--heap-sampler', 'Heap', ['interval']);
+
   // If the process is spawned with env NODE_CHANNEL_FD, it's probably
   // spawned by our child_process module, then initialize IPC.
   // This attaches some internal event listeners and creates:
@@ -179,7 +183,36 @@ function initializeHeapSnapshotSignalHandlers() {
   const { writeHeapSnapshot } = require('v8');
 
   process.on(signal, () => {
-    writeHeapSnapshot();
+    try {
+      writeHeapSnapshot();
+    } catch (err) {
+      process.emitWarning(`Failed to write heap snapshot: ${err.message}`);
+    }
+  });
+}
+
+// Starts the sampler that is enabled by the `prefix` option, e.g.
+// --cpu-sampler. Each of `settings` is an option of v8.start<name>Sampler()
+// that is taken from the `<prefix>-<setting>` command line option.
+function initializeSampler(prefix, name, settings) {
+  if (!getOptionValue(prefix))
+    return;
+
+  const v8 = require('v8');
+  const options = {};
+  for (const setting of settings)
+    options[setting] = getOptionValue(`${prefix}-${setting}`);
+  v8[`start${name}Sampler`](options);
+
+  const signal = getOptionValue(`${prefix}-signal`);
+  if (!signal)
+    return;
+
+  require('internal/validators').validateSignalName(signal);
+  const format = getOptionValue(`${prefix}-format`);
+
+  process.on(signal, () => {
+    v8[`write${name}SamplerProfile`](undefined, format);
   });
 }
 
@@ -338,7 +371,14 @@ function initializePolicy() {
 }
 
 function initializeCJSLoader() {
-  require('internal/modules/cjs/loader').Module._initPaths();
+  const {
+    Module,
+    initializeResolutionCache
+  } = require('internal/modules/cjs/loader');
+  Module._initPaths();
+  initializeResolutionCache();
+  if (getOptionValue('--experimental-code-cache'))
+    require('internal/modules/code_cache').initializeCodeCache();
 }
 
 function initializeESMLoader() {
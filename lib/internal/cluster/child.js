@@ -92,6 +92,8 @@ cluster._getServer = function(obj, options, cb) {
 
     if (handle)
       shared(reply, handle, indexesKey, cb);  // Shared listen socket.
+    else if (reply.reusePort)
+      reusePort(reply, message, indexesKey, cb);  // SO_REUSEPORT socket.
     else
       rr(reply, indexesKey, cb);              // Round-robin.
   });
@@ -123,6 +125,36 @@ function shared(message, handle, indexesKey, cb) {
   cb(message.errno, handle);
 }
 
+// Listen socket of the worker's own, that shares the address with those of
+// the other workers through SO_REUSEPORT.
+function reusePort(reply, query, indexesKey, cb) {
+  if (reply.errno)
+    return cb(reply.errno, null);
+
+  const { constants } = internalBinding('tcp_wrap');
+  const handle = require('net')._createServerHandle(
+    query.address,
+    reply.sockname.port,
+    query.addressType,
+    undefined,
+    query.flags | constants.UV_TCP_REUSEPORT);
+
+  if (typeof handle === 'number')
+    return cb(handle, null);
+
+  if (reply.steering === 'cpu') {
+    // The filter applies to all sockets of the port, but has to be attached
+    // to one that listens already.
+    const listen = handle.listen;
+    handle.listen = function(backlog) {
+      const err = listen.call(this, backlog);
+      return err || this.attachReusePortCPUFilter();
+    };
+  }
+
+  shared(reply, handle, indexesKey, cb);
+}
+
 // Round-robin. Master distributes handles across workers.
 function rr(message, indexesKey, cb) {
   if (message.errno)
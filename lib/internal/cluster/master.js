@@ -6,6 +6,7 @@ const assert = require('internal/assert');
 const { fork } = require('child_process');
 const path = require('path');
 const EventEmitter = require('events');
+const ReusePortHandle = require('internal/cluster/reuseport_handle');
 const RoundRobinHandle = require('internal/cluster/round_robin_handle');
 const SharedHandle = require('internal/cluster/shared_handle');
 const Worker = require('internal/cluster/worker');
@@ -15,6 +16,7 @@ const cluster = new EventEmitter();
 const intercom = new EventEmitter();
 const SCHED_NONE = 1;
 const SCHED_RR = 2;
+const SCHED_REUSEPORT = 3;
 const { isLegalPort } = require('internal/net');
 const [ minPort, maxPort ] = [ 1024, 65535 ];
 
@@ -28,6 +30,7 @@ cluster.workers = {};
 cluster.settings = {};
 cluster.SCHED_NONE = SCHED_NONE;  // Leave it to the operating system.
 cluster.SCHED_RR = SCHED_RR;      // Master distributes connections.
+cluster.SCHED_REUSEPORT = SCHED_REUSEPORT;  // Kernel distributes connections.
 
 var ids = 0;
 var debugPortOffset = 1;
@@ -36,7 +39,8 @@ var initialized = false;
 // XXX(bnoordhuis) Fold cluster.schedulingPolicy into cluster.settings?
 var schedulingPolicy = {
   'none': SCHED_NONE,
-  'rr': SCHED_RR
+  'rr': SCHED_RR,
+  'reuseport': SCHED_REUSEPORT
 }[process.env.NODE_CLUSTER_SCHED_POLICY];
 
 if (schedulingPolicy === undefined) {
@@ -73,7 +77,8 @@ cluster.setupMaster = function(options) {
 
   initialized = true;
   schedulingPolicy = cluster.schedulingPolicy;  // Freeze policy.
-  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR,
+  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR ||
+         schedulingPolicy === SCHED_REUSEPORT,
          `Bad cluster.schedulingPolicy: ${schedulingPolicy}`);
 
   process.nextTick(setupSettingsNT, settings);
@@ -289,10 +294,16 @@ function queryServer(worker, message) {
     // UDP is exempt from round-robin connection balancing for what should
     // be obvious reasons: it's connectionless. There is nothing to send to
     // the workers except raw datagrams and that's pointless.
-    if (schedulingPolicy !== SCHED_RR ||
+    if (schedulingPolicy === SCHED_NONE ||
         message.addressType === 'udp4' ||
         message.addressType === 'udp6') {
       constructor = SharedHandle;
+    } else if (schedulingPolicy === SCHED_REUSEPORT &&
+               (message.addressType === 4 || message.addressType === 6) &&
+               !(message.fd >= 0)) {
+      // SO_REUSEPORT works for TCP ports only. UNIX sockets and file
+      // descriptors are distributed round-robin.
+      constructor = ReusePortHandle;
     }
 
     handle = new constructor(key,
@@ -300,7 +311,8 @@ function queryServer(worker, message) {
                              message.port,
                              message.addressType,
                              message.fd,
-                             message.flags);
+                             message.flags,
+                             cluster.settings.reusePortSteering);
     handles.set(key, handle);
   }
 
@@ -0,0 +1,58 @@
+'use strict';
+const assert = require('internal/assert');
+const net = require('net');
+const { constants } = internalBinding('tcp_wrap');
+
+module.exports = ReusePortHandle;
+
+// Every worker listens on a socket of its own, and the kernel distributes
+// the connections across them through SO_REUSEPORT. The master only holds
+// on to a socket that is bound to the address but does not listen. That
+// reserves the port, and tells the workers which one to use when they ask
+// for port 0.
+function ReusePortHandle(key, address, port, addressType, fd, flags,
+                         steering) {
+  this.key = key;
+  this.workers = [];
+  this.handle = null;
+  this.errno = 0;
+  this.sockname = null;
+  this.steering = steering;
+
+  const rval = net._createServerHandle(address, port, addressType, fd,
+                                       flags | constants.UV_TCP_REUSEPORT);
+
+  if (typeof rval === 'number') {
+    this.errno = rval;
+  } else {
+    this.handle = rval;
+    this.sockname = {};
+    this.errno = this.handle.getsockname(this.sockname);
+  }
+}
+
+ReusePortHandle.prototype.add = function(worker, send) {
+  assert(!this.workers.includes(worker));
+  this.workers.push(worker);
+  send(this.errno, {
+    reusePort: true,
+    sockname: this.sockname,
+    steering: this.steering
+  }, null);
+};
+
+ReusePortHandle.prototype.remove = function(worker) {
+  const index = this.workers.indexOf(worker);
+
+  if (index === -1)
+    return false; // The worker wasn't sharing this handle.
+
+  this.workers.splice(index, 1);
+
+  if (this.workers.length !== 0)
+    return false;
+
+  this.handle.close();
+  this.handle = null;
+  return true;
+};
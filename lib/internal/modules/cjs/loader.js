@@ -32,7 +32,9 @@ const fs = require('fs');
 const internalFS = require('internal/fs/utils');
 const path = require('path');
 const {
+  clearInternalModuleStatCache,
   internalModuleReadJSON,
+  internalModuleReadPackageJSON,
   internalModuleStat
 } = internalBinding('fs');
 const { safeGetenv } = internalBinding('credentials');
@@ -45,10 +47,17 @@ const { getOptionValue } = require('internal/options');
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
 const preserveSymlinksMain = getOptionValue('--preserve-symlinks-main');
 const experimentalModules = getOptionValue('--experimental-modules');
+const resolutionCacheFile =
+  getOptionValue('--experimental-resolution-cache');
 const manifest = getOptionValue('--experimental-policy') ?
   require('internal/process/policy').manifest :
   null;
-const { compileFunction } = internalBinding('contextify');
+const {
+  compileFunction,
+  createCodeCacheForFunction
+} = internalBinding('contextify');
+const codeCacheDirectory = getOptionValue('--experimental-code-cache');
+let codeCache;
 
 const {
   ERR_INVALID_ARG_VALUE,
@@ -58,7 +67,7 @@ const {
 const { validateString } = require('internal/validators');
 const pendingDeprecation = getOptionValue('--pending-deprecation');
 
-module.exports = { wrapSafe, Module };
+module.exports = { wrapSafe, Module, initializeResolutionCache };
 
 let asyncESM;
 let ModuleJob;
@@ -76,14 +85,21 @@ const relativeResolveCache = Object.create(null);
 
 let requireDepth = 0;
 let statCache = null;
+// The lookups of the Module._findPath() call that is being persisted to the
+// resolution cache, see isPersistedResolutionCurrent().
+let resolutionTrace = null;
+// With --experimental-resolution-cache, stat() results are also kept in a
+// native cache that is shared between threads. It is only used while the
+// process is starting up, because it is never invalidated.
+let useStartupStatCache = false;
 function stat(filename) {
   filename = path.toNamespacedPath(filename);
-  if (statCache !== null) {
-    const result = statCache.get(filename);
-    if (result !== undefined) return result;
+  let result = statCache !== null ? statCache.get(filename) : undefined;
+  if (result === undefined) {
+    result = internalModuleStat(filename, useStartupStatCache);
+    if (statCache !== null) statCache.set(filename, result);
   }
-  const result = internalModuleStat(filename);
-  if (statCache !== null) statCache.set(filename, result);
+  if (resolutionTrace !== null) resolutionTrace.stats[filename] = result;
   return result;
 }
 
@@ -189,15 +205,24 @@ function readPackage(requestPath) {
     return entry;
 
   const jsonPath = path.resolve(requestPath, 'package.json');
-  const json = internalModuleReadJSON(path.toNamespacedPath(jsonPath));
-
-  if (json === undefined) {
-    return false;
-  }
-
+  let json;
   if (manifest) {
+    // Policy integrity checks need the complete source.
+    json = internalModuleReadJSON(path.toNamespacedPath(jsonPath));
+    if (json === undefined) {
+      return false;
+    }
     const jsonURL = pathToFileURL(jsonPath);
     manifest.assertIntegrity(jsonURL, json);
+  } else {
+    // Either [main] scanned natively, or the raw source when JSON.parse()
+    // needs to have the final say.
+    json = internalModuleReadPackageJSON(path.toNamespacedPath(jsonPath));
+    if (json === undefined) {
+      return false;
+    }
+    if (typeof json !== 'string')
+      return packageMainCache[requestPath] = json[0];
   }
 
   try {
@@ -211,6 +236,10 @@ function readPackage(requestPath) {
 
 function tryPackage(requestPath, exts, isMain, originalPath) {
   const pkg = readPackage(requestPath);
+  if (resolutionTrace !== null) {
+    resolutionTrace.packages[requestPath] =
+      typeof pkg === 'string' ? pkg : null;
+  }
 
   if (!pkg) {
     return tryExtensions(path.resolve(requestPath, 'index'), exts, isMain);
@@ -264,9 +293,12 @@ function tryFile(requestPath, isMain) {
 }
 
 function toRealPath(requestPath) {
-  return fs.realpathSync(requestPath, {
+  const filename = fs.realpathSync(requestPath, {
     [internalFS.realpathCacheKey]: realpathCache
   });
+  if (resolutionTrace !== null)
+    resolutionTrace.realpaths[requestPath] = filename;
+  return filename;
 }
 
 // Given a path, check if the file exists with any of the set extensions
@@ -297,6 +329,112 @@ function findLongestRegisteredExtension(filename) {
   return '.js';
 }
 
+// Resolutions loaded from the --experimental-resolution-cache file, keyed
+// like Module._pathCache. Each entry holds the resolved filename together
+// with the results of the stat() and realpath() calls and the package.json
+// "main" fields that the resolution was based on. Files may have been
+// created, moved or deleted, and symlinks retargeted, since the cache was
+// written, so an entry is only used if all of these lookups still give the
+// same results.
+let persistedPathCache = null;
+let persistedPathCacheDirty = false;
+const kResolutionCacheVersion = 3;
+
+function isPersistedResolutionCurrent(entry) {
+  const { stats, realpaths, packages } = entry;
+  for (const filename of Object.keys(stats)) {
+    if (stat(filename) !== stats[filename])
+      return false;
+  }
+  for (const requestPath of Object.keys(realpaths)) {
+    try {
+      if (toRealPath(requestPath) !== realpaths[requestPath])
+        return false;
+    } catch {
+      return false;
+    }
+  }
+  for (const requestPath of Object.keys(packages)) {
+    let pkg;
+    try {
+      pkg = readPackage(requestPath);
+    } catch {
+      // Let the normal resolution report the error.
+      return false;
+    }
+    if ((typeof pkg === 'string' ? pkg : null) !== packages[requestPath])
+      return false;
+  }
+  return true;
+}
+
+function resolutionCacheFlags() {
+  return `${preserveSymlinks}:${preserveSymlinksMain}`;
+}
+
+function initializeResolutionCache() {
+  if (!resolutionCacheFile)
+    return;
+  const { isMainThread } = internalBinding('worker');
+  if (isMainThread) {
+    process.emitWarning('The resolution cache is experimental.',
+                        'ExperimentalWarning');
+  }
+  persistedPathCache = Object.create(null);
+  // The main module and everything it requires synchronously are loaded
+  // before the first tick.
+  useStartupStatCache = true;
+  process.nextTick(() => { useStartupStatCache = false; });
+
+  let data;
+  try {
+    data = JSON.parse(fs.readFileSync(resolutionCacheFile, 'utf8'));
+  } catch {
+    // A missing or unreadable cache file just means starting from scratch.
+  }
+  if (data !== null && typeof data === 'object' &&
+      data.version === kResolutionCacheVersion &&
+      data.flags === resolutionCacheFlags() &&
+      data.paths !== null && typeof data.paths === 'object') {
+    for (const key of Object.keys(data.paths)) {
+      const entry = data.paths[key];
+      if (entry !== null && typeof entry === 'object' &&
+          typeof entry.filename === 'string' &&
+          entry.stats !== null && typeof entry.stats === 'object' &&
+          entry.realpaths !== null && typeof entry.realpaths === 'object' &&
+          entry.packages !== null && typeof entry.packages === 'object') {
+        persistedPathCache[key] = entry;
+      }
+    }
+  }
+
+  // Only the main thread writes the cache back, so that workers do not race
+  // with it.
+  if (isMainThread)
+    process.on('exit', writeResolutionCache);
+}
+
+function writeResolutionCache() {
+  if (!persistedPathCacheDirty)
+    return;
+  persistedPathCacheDirty = false;
+  const data = JSON.stringify({
+    version: kResolutionCacheVersion,
+    flags: resolutionCacheFlags(),
+    paths: persistedPathCache
+  });
+  // Write to a temporary file first so that concurrently starting processes
+  // never see a partially written cache.
+  const tmpFile = `${resolutionCacheFile}.${process.pid}.tmp`;
+  try {
+    fs.writeFileSync(tmpFile, data);
+    fs.renameSync(tmpFile, resolutionCacheFile);
+  } catch {
+    // The cache is only an optimization; failing to write it is not fatal.
+    try { fs.unlinkSync(tmpFile); } catch {}
+  }
+}
+
 Module._findPath = function(request, paths, isMain) {
   if (path.isAbsolute(request)) {
     paths = [''];
@@ -310,6 +448,41 @@ Module._findPath = function(request, paths, isMain) {
   if (entry)
     return entry;
 
+  if (persistedPathCache === null)
+    return findPath(request, paths, isMain, cacheKey);
+
+  const persisted = persistedPathCache[cacheKey];
+  if (persisted !== undefined && isPersistedResolutionCurrent(persisted)) {
+    Module._pathCache[cacheKey] = persisted.filename;
+    return persisted.filename;
+  }
+
+  // Record the lookups that lead to the resolution, so that later runs can
+  // check that they still have the same results.
+  const outerTrace = resolutionTrace;
+  resolutionTrace = {
+    stats: Object.create(null),
+    realpaths: Object.create(null),
+    packages: Object.create(null)
+  };
+  try {
+    const filename = findPath(request, paths, isMain, cacheKey);
+    if (filename) {
+      persistedPathCache[cacheKey] = {
+        filename,
+        stats: resolutionTrace.stats,
+        realpaths: resolutionTrace.realpaths,
+        packages: resolutionTrace.packages
+      };
+      persistedPathCacheDirty = true;
+    }
+    return filename;
+  } finally {
+    resolutionTrace = outerTrace;
+  }
+};
+
+function findPath(request, paths, isMain, cacheKey) {
   var exts;
   var trailingSlash = request.length > 0 &&
     request.charCodeAt(request.length - 1) === CHAR_FORWARD_SLASH;
@@ -370,7 +543,7 @@ Module._findPath = function(request, paths, isMain) {
     }
   }
   return false;
-};
+}
 
 // 'node_modules' character codes reversed
 const nmChars = [ 115, 101, 108, 117, 100, 111, 109, 95, 101, 100, 111, 110 ];
@@ -705,12 +878,18 @@ function wrapSafe(filename, content) {
     });
   }
 
+  let codeCacheEntry;
+  if (codeCacheDirectory) {
+    if (codeCache === undefined)
+      codeCache = require('internal/modules/code_cache');
+    codeCacheEntry = codeCache.lookupCodeCache(filename, content);
+  }
   const compiledWrapper = compileFunction(
     content,
     filename,
     0,
     0,
-    undefined,
+    codeCacheEntry !== undefined ? codeCacheEntry.data : undefined,
     false,
     undefined,
     [],
@@ -723,6 +902,14 @@ function wrapSafe(filename, content) {
     ]
   );
 
+  if (codeCacheEntry !== undefined &&
+      (codeCacheEntry.data === undefined ||
+       compiledWrapper.cachedDataRejected)) {
+    codeCache.scheduleCodeCacheWrite(
+      filename, codeCacheEntry,
+      () => createCodeCacheForFunction(compiledWrapper));
+  }
+
   if (experimentalModules) {
     const { callbackMap } = internalBinding('module_wrap');
     callbackMap.set(compiledWrapper, {
@@ -889,6 +1076,23 @@ function createRequire(filename) {
 
 Module.createRequire = createRequire;
 
+Module.clearResolutionCache = function() {
+  clearInternalModuleStatCache();
+  if (statCache !== null)
+    statCache.clear();
+  realpathCache.clear();
+  for (const key of Object.keys(Module._pathCache))
+    delete Module._pathCache[key];
+  for (const key of Object.keys(packageMainCache))
+    delete packageMainCache[key];
+  for (const key of Object.keys(relativeResolveCache))
+    delete relativeResolveCache[key];
+  if (persistedPathCache !== null) {
+    persistedPathCache = Object.create(null);
+    persistedPathCacheDirty = true;
+  }
+};
+
 Module._initPaths = function() {
   var homeDir;
   var nodePath;
@@ -0,0 +1,198 @@
+'use strict';
+
+// A directory-backed V8 code cache for user modules, enabled with
+// --experimental-code-cache=dir.
+//
+// Each module gets one file in the directory, named after a hash of its path.
+// The file starts with a header recording the path, a hash and the length of
+// the source it was produced from and the V8 cachedDataVersionTag(), so
+// entries for modified files or for other Node.js versions are never handed to
+// V8. The key is computed from the source that is actually being compiled, so
+// a file that changes while it is being read cannot get cache data for other
+// contents. V8 itself also rejects cache data that does not match the source.
+//
+// This module is only loaded when the cache is enabled.
+//
+// Cache data is produced after the module has run, so that it covers the
+// functions that were compiled lazily during execution. Entries are written
+// from an unref'ed timer once startup is over, or on exit if the process does
+// not get that far.
+
+const { Math, SafeMap } = primordials;
+
+const { Buffer } = require('buffer');
+const fs = require('fs');
+const path = require('path');
+const { getOptionValue } = require('internal/options');
+
+const cacheDirectory = getOptionValue('--experimental-code-cache');
+
+// When the cache directory grows beyond this, the least recently written
+// entries are removed until it is back under kEvictionTarget.
+const kMaxCacheSize = 128 * 1024 * 1024;
+const kEvictionTarget = kMaxCacheSize * 3 / 4;
+const kTempFileMaxAge = 60 * 1000;
+const kCacheFileExtension = '.cache';
+
+let enabled = false;
+let versionTag;
+// filename -> { entry, produce }
+const pendingWrites = new SafeMap();
+let flushTimer = null;
+
+function initializeCodeCache() {
+  if (!cacheDirectory)
+    return;
+  const { isMainThread } = internalBinding('worker');
+  if (isMainThread) {
+    process.emitWarning('The code cache is experimental.',
+                        'ExperimentalWarning');
+  }
+  try {
+    fs.mkdirSync(cacheDirectory, { recursive: true });
+  } catch {
+    return;
+  }
+  enabled = true;
+  versionTag = internalBinding('v8').cachedDataVersionTag();
+  process.on('exit', flushCodeCache);
+}
+
+// Two 32-bit FNV-1a hashes with different offset bases.
+function hashString(str) {
+  let a = 0x811c9dc5;
+  let b = 0x050c5d1f;
+  for (let i = 0; i < str.length; i++) {
+    const c = str.charCodeAt(i);
+    a = Math.imul(a ^ c, 0x01000193);
+    b = Math.imul(b ^ c, 0x01000193);
+  }
+  return (a >>> 0).toString(16).padStart(8, '0') +
+         (b >>> 0).toString(16).padStart(8, '0');
+}
+
+// Returns undefined when the cache is disabled, and otherwise an entry whose
+// `data` is the cached data for |source|, which was read from |filename|, or
+// undefined if there is none yet.
+function lookupCodeCache(filename, source) {
+  if (!enabled)
+    return undefined;
+
+  const entry = {
+    key: `${versionTag}\0${hashString(source)}\0${source.length}\0${filename}`,
+    file: path.join(cacheDirectory, hashString(filename) + kCacheFileExtension),
+    data: undefined
+  };
+
+  let contents;
+  try {
+    contents = fs.readFileSync(entry.file);
+  } catch {
+    return entry;
+  }
+  if (contents.length >= 4) {
+    const keyLength = contents.readUInt32LE(0);
+    if (keyLength <= contents.length - 4 &&
+        contents.toString('utf8', 4, 4 + keyLength) === entry.key) {
+      entry.data = contents.subarray(4 + keyLength);
+    }
+  }
+  return entry;
+}
+
+// Schedules cache data to be written for |entry|. |produce| returns a Buffer
+// with the cache data, or undefined if V8 could not produce any.
+function scheduleCodeCacheWrite(filename, entry, produce) {
+  pendingWrites.set(filename, { entry, produce });
+  if (flushTimer === null) {
+    const { setTimeout } = require('timers');
+    flushTimer = setTimeout(flushCodeCache, 0);
+    flushTimer.unref();
+  }
+}
+
+function flushCodeCache() {
+  if (flushTimer !== null) {
+    const { clearTimeout } = require('timers');
+    clearTimeout(flushTimer);
+    flushTimer = null;
+  }
+  if (pendingWrites.size === 0)
+    return;
+
+  let written = 0;
+  for (const { entry, produce } of pendingWrites.values()) {
+    const data = produce();
+    if (data === undefined || data.length === 0)
+      continue;
+    const key = Buffer.from(entry.key, 'utf8');
+    const header = Buffer.allocUnsafe(4);
+    header.writeUInt32LE(key.length, 0);
+    // Write to a temporary file first, so that concurrent processes never
+    // see a partially written entry.
+    const tmp = `${entry.file}.${process.pid}.tmp`;
+    try {
+      fs.writeFileSync(tmp, Buffer.concat([header, key, data]));
+      fs.renameSync(tmp, entry.file);
+      written++;
+    } catch {
+      try { fs.unlinkSync(tmp); } catch {}
+    }
+  }
+  pendingWrites.clear();
+
+  if (written > 0)
+    evictCodeCache();
+}
+
+function evictCodeCache() {
+  let names;
+  try {
+    names = fs.readdirSync(cacheDirectory);
+  } catch {
+    return;
+  }
+
+  const now = Date.now();
+  const entries = [];
+  let total = 0;
+  for (const name of names) {
+    const file = path.join(cacheDirectory, name);
+    let stats;
+    try {
+      stats = fs.statSync(file);
+    } catch {
+      continue;
+    }
+    if (name.endsWith('.tmp')) {
+      // Left behind by a process that died while writing.
+      if (now - stats.mtimeMs > kTempFileMaxAge) {
+        try { fs.unlinkSync(file); } catch {}
+      }
+      continue;
+    }
+    if (!name.endsWith(kCacheFileExtension))
+      continue;
+    entries.push({ file, size: stats.size, mtimeMs: stats.mtimeMs });
+    total += stats.size;
+  }
+
+  if (total <= kMaxCacheSize)
+    return;
+  entries.sort((a, b) => a.mtimeMs - b.mtimeMs);
+  for (const { file, size } of entries) {
+    if (total <= kEvictionTarget)
+      break;
+    try {
+      fs.unlinkSync(file);
+      total -= size;
+    } catch {}
+  }
+}
+
+module.exports = {
+  initializeCodeCache,
+  lookupCodeCache,
+  scheduleCodeCacheWrite,
+  flushCodeCache
+};
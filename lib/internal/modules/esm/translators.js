@@ -22,6 +22,9 @@ const { fileURLToPath, URL } = require('url');
 const { debuglog } = require('internal/util/debuglog');
 const { promisify } = require('internal/util');
 const esmLoader = require('internal/process/esm_loader');
+const { getOptionValue } = require('internal/options');
+const codeCacheDirectory = getOptionValue('--experimental-code-cache');
+let codeCache;
 const {
   ERR_UNKNOWN_BUILTIN_MODULE
 } = require('internal/errors').codes;
@@ -47,7 +50,22 @@ translators.set('module', async function moduleStrategy(url) {
   const source = `${await readFileAsync(new URL(url))}`;
   debug(`Translating StandardModule ${url}`);
   const { ModuleWrap, callbackMap } = internalBinding('module_wrap');
-  const module = new ModuleWrap(source, url);
+  const filename = StringPrototype.startsWith(url, 'file:') ?
+    fileURLToPath(url) : undefined;
+  let codeCacheEntry;
+  if (codeCacheDirectory && filename !== undefined) {
+    if (codeCache === undefined)
+      codeCache = require('internal/modules/code_cache');
+    codeCacheEntry = codeCache.lookupCodeCache(filename, source);
+  }
+  const module = codeCacheEntry !== undefined ?
+    new ModuleWrap(source, url, undefined, 0, 0, codeCacheEntry.data) :
+    new ModuleWrap(source, url);
+  if (codeCacheEntry !== undefined &&
+      (codeCacheEntry.data === undefined || module.cachedDataRejected)) {
+    codeCache.scheduleCodeCacheWrite(filename, codeCacheEntry,
+                                     () => module.createCachedData());
+  }
   callbackMap.set(module, {
     initializeImportMeta,
     importModuleDynamically,
@@ -35,7 +35,8 @@ function wrapProcessMethods(binding) {
     hrtime: _hrtime,
     hrtimeBigInt: _hrtimeBigInt,
     cpuUsage: _cpuUsage,
-    memoryUsage: _memoryUsage
+    memoryUsage: _memoryUsage,
+    threadpoolUsage: _threadpoolUsage
   } = binding;
 
   function _rawDebug(...args) {
@@ -148,6 +149,23 @@ function wrapProcessMethods(binding) {
     };
   }
 
+  const threadpoolValues = new Float64Array(10);
+  function threadpoolUsage() {
+    _threadpoolUsage(threadpoolValues);
+    return {
+      size: threadpoolValues[0],
+      maxSize: threadpoolValues[1],
+      idle: threadpoolValues[2],
+      queued: threadpoolValues[3],
+      running: threadpoolValues[4],
+      slowIORunning: threadpoolValues[5],
+      submitted: threadpoolValues[6],
+      completed: threadpoolValues[7],
+      waitTime: threadpoolValues[8],
+      runTime: threadpoolValues[9]
+    };
+  }
+
   function exit(code) {
     if (code || code === 0)
       process.exitCode = code;
@@ -197,6 +215,7 @@ function wrapProcessMethods(binding) {
     hrtimeBigInt,
     cpuUsage,
     memoryUsage,
+    threadpoolUsage,
     kill,
     exit
   };
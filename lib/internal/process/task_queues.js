@@ -29,7 +29,8 @@ const {
   emitBefore,
   emitAfter,
   emitDestroy,
-  symbols: { async_id_symbol, trigger_async_id_symbol }
+  captureContextFrame,
+  symbols: { async_id_symbol, trigger_async_id_symbol, context_frame_symbol }
 } = require('internal/async_hooks');
 const {
   ERR_INVALID_CALLBACK,
@@ -64,7 +65,7 @@ function processTicksAndRejections() {
   do {
     while (tock = queue.shift()) {
       const asyncId = tock[async_id_symbol];
-      emitBefore(asyncId, tock[trigger_async_id_symbol]);
+      emitBefore(asyncId, tock[trigger_async_id_symbol], tock);
 
       try {
         const callback = tock.callback;
@@ -94,6 +95,7 @@ class TickObject {
     const triggerAsyncId = getDefaultTriggerAsyncId();
     this[async_id_symbol] = asyncId;
     this[trigger_async_id_symbol] = triggerAsyncId;
+    this[context_frame_symbol] = captureContextFrame();
 
     if (initHooksExist()) {
       emitInit(asyncId, 'TickObject', triggerAsyncId, this);
@@ -65,17 +65,21 @@
 // after the first one encountered that does not yet need to timeout will also
 // always be due to timeout at a later time.
 //
-// Less-than constant time operations are thus contained in two places:
-// The PriorityQueue — an efficient binary heap implementation that does all
-// operations in worst-case O(log n) time — which manages the order of expiring
-// Timeout lists and the object map lookup of a specific list by the duration of
-// timers within (or creation of a new list). However, these operations combined
-// have shown to be trivial in comparison to other timers architectures.
+// The lists themselves are ordered by their expiry in a hierarchical timing
+// wheel that lives in C++ (src/timer_wheel.h), where adding and removing a
+// list are constant-time as well. Each list is scheduled in the wheel under a
+// numeric handle, and the lists whose expiry has passed are handed back to
+// JavaScript as batches of handles in the shared `expiredTimers` array. The
+// wheel also decides when the libuv timer needs to fire next, so JavaScript
+// does not have to keep track of the earliest expiry.
 
 const { Math, Object } = primordials;
 
 const {
-  scheduleTimer,
+  scheduleTimersList: scheduleTimersListInWheel,
+  unscheduleTimersList: unscheduleTimersListInWheel,
+  takeExpiredTimers,
+  expiredTimers,
   toggleTimerRef,
   getLibuvNow,
   immediateInfo
@@ -90,7 +94,9 @@ const {
   emitInit,
   emitBefore,
   emitAfter,
-  emitDestroy
+  emitDestroy,
+  captureContextFrame,
+  symbols: { context_frame_symbol }
 } = require('internal/async_hooks');
 
 // Symbols for storing async id state.
@@ -104,7 +110,6 @@ const {
 const { validateNumber } = require('internal/validators');
 
 const L = require('internal/linkedlist');
-const PriorityQueue = require('internal/priority_queue');
 
 const { inspect } = require('internal/util/inspect');
 const debug = require('internal/util/debuglog').debuglog('timer');
@@ -120,17 +125,19 @@ const TIMEOUT_MAX = 2 ** 31 - 1;
 let timerListId = Number.MIN_SAFE_INTEGER;
 
 const kRefed = Symbol('refed');
+const kCoalesced = Symbol('coalesced');
 
 // Create a single linked list instance only once at startup
 const immediateQueue = new ImmediateList();
 
-let nextExpiry = Infinity;
 let refCount = 0;
 
-// This is a priority queue with a custom sorting function that first compares
-// the expiry times of two lists and if they're the same then compares their
-// individual IDs to determine which list was created first.
-const timerListQueue = new PriorityQueue(compareTimersLists, setPosition);
+// Marks a TimersList that is not scheduled in the timer wheel, either because
+// it has expired or because it has been removed.
+const kNotScheduled = -1;
+
+// The scheduled lists, indexed by their timer wheel handle.
+const scheduledTimersLists = [];
 
 // Object map containing linked lists of timers, keyed and sorted by their
 // duration in milliseconds.
@@ -139,10 +146,16 @@ const timerListQueue = new PriorityQueue(compareTimersLists, setPosition);
 // - value = linked list
 const timerListMap = Object.create(null);
 
+// The idle timeouts of sockets are coalesced when --timer-slack is set. Their
+// lists are keyed by expiry instead, see getCoalescedTimersList().
+let timerSlack;
+const coalescedTimerListMap = Object.create(null);
+
 function initAsyncResource(resource, type) {
   const asyncId = resource[async_id_symbol] = newAsyncId();
   const triggerAsyncId =
     resource[trigger_async_id_symbol] = getDefaultTriggerAsyncId();
+  resource[context_frame_symbol] = captureContextFrame();
   if (initHooksExist())
     emitInit(asyncId, type, triggerAsyncId, resource);
 }
@@ -174,6 +187,7 @@ function Timeout(callback, after, args, isRepeat) {
   this._destroyed = false;
 
   this[kRefed] = null;
+  this[kCoalesced] = false;
 
   initAsyncResource(this, 'Timeout');
 }
@@ -190,6 +204,13 @@ Timeout.prototype[inspect.custom] = function(_, options) {
 };
 
 Timeout.prototype.refresh = function() {
+  // A coalesced timer that is still scheduled only records the new start
+  // time. It is moved to a later slot when its current slot expires.
+  if (this[kCoalesced] && this._idleNext !== null && this._idleNext !== this) {
+    this._idleStart = getLibuvNow();
+    return this;
+  }
+
   if (this[kRefed])
     active(this);
   else
@@ -224,7 +245,8 @@ function TimersList(expiry, msecs) {
   this.expiry = expiry;
   this.id = timerListId++;
   this.msecs = msecs;
-  this.priorityQueuePosition = null;
+  this.timerWheelHandle = kNotScheduled;
+  this.coalesced = false;
 }
 
 // Make sure the linked list only shows the minimal necessary information.
@@ -312,17 +334,18 @@ function insert(item, refed, start) {
 
   item._idleStart = start;
 
-  // Use an existing list if there is one, otherwise we need to make a new one.
-  var list = timerListMap[msecs];
-  if (list === undefined) {
-    debug('no %d list was found in insert, creating a new one', msecs);
-    const expiry = start + msecs;
-    timerListMap[msecs] = list = new TimersList(expiry, msecs);
-    timerListQueue.insert(list);
-
-    if (nextExpiry > expiry) {
-      scheduleTimer(msecs);
-      nextExpiry = expiry;
+  var list;
+  if (item[kCoalesced]) {
+    list = getCoalescedTimersList(start + msecs);
+  } else {
+    // Use an existing list if there is one, otherwise we need to make a new
+    // one.
+    list = timerListMap[msecs];
+    if (list === undefined) {
+      debug('no %d list was found in insert, creating a new one', msecs);
+      const expiry = start + msecs;
+      timerListMap[msecs] = list = new TimersList(expiry, msecs);
+      scheduleTimersList(list);
     }
   }
 
@@ -349,11 +372,43 @@ function setUnrefTimeout(callback, after) {
   }
 
   const timer = new Timeout(callback, after, undefined, false);
+  if (timerSlack === undefined)
+    timerSlack = require('internal/options').getOptionValue('--timer-slack');
+  timer[kCoalesced] = timerSlack > 0;
   unrefActive(timer);
 
   return timer;
 }
 
+// Returns the list for coalesced timers expiring at |expiry|. These lists
+// are keyed by their expiry, which is rounded up to a multiple of the slack
+// so that timers expiring close to each other share a list. Timers of any
+// duration can end up in the same list.
+function getCoalescedTimersList(expiry) {
+  expiry = Math.ceil(expiry / timerSlack) * timerSlack;
+  let list = coalescedTimerListMap[expiry];
+  if (list === undefined) {
+    list = coalescedTimerListMap[expiry] = new TimersList(expiry, 0);
+    list.coalesced = true;
+    scheduleTimersList(list);
+  }
+  return list;
+}
+
+// Removes a coalesced timer from its list. Like the other lists when their
+// last refed timer is removed, see unenroll(), a list that this leaves empty
+// is unscheduled.
+function removeCoalescedTimer(item) {
+  // If the timer is the last one in its list, the next node is the list.
+  const list = item._idleNext;
+  L.remove(item);
+  if (list !== null && list.coalesced && L.isEmpty(list)) {
+    unscheduleTimersList(list);
+    if (list === coalescedTimerListMap[list.expiry])
+      delete coalescedTimerListMap[list.expiry];
+  }
+}
+
 // Type checking used by timers.enroll() and Socket#setTimeout()
 function getTimerDuration(msecs, name) {
   validateNumber(msecs, name);
@@ -372,19 +427,21 @@ function getTimerDuration(msecs, name) {
   return msecs;
 }
 
-function compareTimersLists(a, b) {
-  const expiryDiff = a.expiry - b.expiry;
-  if (expiryDiff === 0) {
-    if (a.id < b.id)
-      return -1;
-    if (a.id > b.id)
-      return 1;
-  }
-  return expiryDiff;
+// Lists with the same expiry run in the order of their ids, i.e. the order in
+// which they were created or last rescheduled.
+function scheduleTimersList(list) {
+  const handle = scheduleTimersListInWheel(list.expiry, list.id);
+  scheduledTimersLists[handle] = list;
+  list.timerWheelHandle = handle;
 }
 
-function setPosition(node, pos) {
-  node.priorityQueuePosition = pos;
+function unscheduleTimersList(list) {
+  const handle = list.timerWheelHandle;
+  if (handle === kNotScheduled)
+    return;
+  unscheduleTimersListInWheel(handle);
+  scheduledTimersLists[handle] = undefined;
+  list.timerWheelHandle = kNotScheduled;
 }
 
 function getTimerCallbacks(runNextTicks) {
@@ -431,7 +488,7 @@ function getTimerCallbacks(runNextTicks) {
       prevImmediate = immediate;
 
       const asyncId = immediate[async_id_symbol];
-      emitBefore(asyncId, immediate[trigger_async_id_symbol]);
+      emitBefore(asyncId, immediate[trigger_async_id_symbol], immediate);
 
       try {
         const argv = immediate._argv;
@@ -457,24 +514,40 @@ function getTimerCallbacks(runNextTicks) {
   }
 
 
+  // The batch of expired lists that is being processed. This is kept across
+  // calls so that processing can resume where it stopped if a timer throws.
+  const expiredLists = [];
+  let expiredCount = 0;
+  let expiredIndex = 0;
+
+  function takeExpiredTimersLists() {
+    expiredCount = takeExpiredTimers();
+    expiredIndex = 0;
+    // The handles can be reused for new lists from here on.
+    for (let i = 0; i < expiredCount; i++) {
+      const handle = expiredTimers[i];
+      const list = scheduledTimersLists[handle];
+      scheduledTimersLists[handle] = undefined;
+      list.timerWheelHandle = kNotScheduled;
+      expiredLists[i] = list;
+    }
+    return expiredCount;
+  }
+
   function processTimers(now) {
     debug('process timer lists %d', now);
-    nextExpiry = Infinity;
 
-    let list;
     let ranAtLeastOneList = false;
-    while (list = timerListQueue.peek()) {
-      if (list.expiry > now) {
-        nextExpiry = list.expiry;
-        return refCount > 0 ? nextExpiry : -nextExpiry;
-      }
+    while (expiredIndex < expiredCount || takeExpiredTimersLists() > 0) {
       if (ranAtLeastOneList)
         runNextTicks();
       else
         ranAtLeastOneList = true;
+      const list = expiredLists[expiredIndex];
       listOnTimeout(list, now);
+      expiredLists[expiredIndex++] = undefined;
     }
-    return 0;
+    return refCount > 0 ? 1 : -1;
   }
 
   function listOnTimeout(list, now) {
@@ -487,12 +560,21 @@ function getTimerCallbacks(runNextTicks) {
     while (timer = L.peek(list)) {
       diff = now - timer._idleStart;
 
-      // Check if this loop iteration is too early for the next timer.
-      // This happens if there are more timers scheduled for later in the list.
-      if (diff < msecs) {
+      if (list.coalesced) {
+        // The timer was refreshed after it was added to this list.
+        const timerMsecs = Math.trunc(timer._idleTimeout);
+        if (diff < timerMsecs) {
+          L.append(getCoalescedTimersList(timer._idleStart + timerMsecs),
+                   timer);
+          continue;
+        }
+      } else if (diff < msecs) {
+        // Check if this loop iteration is too early for the next timer.
+        // This happens if there are more timers scheduled for later in the
+        // list.
         list.expiry = Math.max(timer._idleStart + msecs, now + 1);
         list.id = timerListId++;
-        timerListQueue.percolateDown(1);
+        scheduleTimersList(list);
         debug('%d list wait because diff is %d', msecs, diff);
         return;
       }
@@ -519,7 +601,7 @@ function getTimerCallbacks(runNextTicks) {
         continue;
       }
 
-      emitBefore(asyncId, timer[trigger_async_id_symbol]);
+      emitBefore(asyncId, timer[trigger_async_id_symbol], timer);
 
       let start;
       if (timer._repeat)
@@ -554,16 +636,18 @@ function getTimerCallbacks(runNextTicks) {
 
     // If `L.peek(list)` returned nothing, the list was either empty or we have
     // called all of the timer timeouts.
-    // As such, we can remove the list from the object map and
-    // the PriorityQueue.
+    // As such, we can remove the list from the object map. It is no longer
+    // scheduled in the timer wheel.
     debug('%d list empty', msecs);
 
     // The current list may have been removed and recreated since the reference
     // to `list` was created. Make sure they're the same instance of the list
     // before destroying.
-    if (list === timerListMap[msecs]) {
+    if (list.coalesced) {
+      if (list === coalescedTimerListMap[list.expiry])
+        delete coalescedTimerListMap[list.expiry];
+    } else if (list === timerListMap[msecs]) {
       delete timerListMap[msecs];
-      timerListQueue.shift();
     }
   }
 
@@ -580,6 +664,7 @@ module.exports = {
   trigger_async_id_symbol,
   Timeout,
   kRefed,
+  kCoalesced,
   initAsyncResource,
   setUnrefTimeout,
   getTimerDuration,
@@ -593,7 +678,9 @@ module.exports = {
   active,
   unrefActive,
   timerListMap,
-  timerListQueue,
+  coalescedTimerListMap,
+  unscheduleTimersList,
+  removeCoalescedTimer,
   decRefCount,
   incRefCount
 };
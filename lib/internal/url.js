@@ -46,6 +46,7 @@ const {
   encodeAuth,
   toUSVString: _toUSVString,
   parse,
+  parseHref,
   setURLConstructor,
   URL_FLAGS_CANNOT_BE_BASE,
   URL_FLAGS_HAS_FRAGMENT,
@@ -62,9 +63,23 @@ const {
   kPathStart,
   kPort,
   kQuery,
-  kSchemeStart
+  kSchemeStart,
+  kURLComponentFlags,
+  kURLComponentProtocolEnd,
+  kURLComponentUsernameEnd,
+  kURLComponentHostStart,
+  kURLComponentHostEnd,
+  kURLComponentPort,
+  kURLComponentPathnameStart,
+  kURLComponentSearchStart,
+  kURLComponentHashStart,
+  kURLComponentsLength,
+  kURLComponentOmitted
 } = internalBinding('url');
 
+// Filled in by parseHref().
+const urlComponents = new Uint32Array(kURLComponentsLength);
+
 const context = Symbol('context');
 const cannotBeBase = Symbol('cannot-be-base');
 const cannotHaveUsernamePasswordPort =
@@ -104,20 +119,222 @@ function serializeTupleOrigin(scheme, host, port) {
 // URL Standard, with a few differences. It is also the object transported to
 // the C++ binding.
 // Refs: https://url.spec.whatwg.org/#concept-url
+//
+// URLs parsed through parseHref() only store their serialized form and the
+// offsets of their components within it; the components are sliced out of
+// `href` when they are first accessed. Modifying any of them stores all
+// components individually from then on.
 class URLContext {
   constructor() {
     this.flags = 0;
-    this.scheme = ':';
-    this.username = '';
-    this.password = '';
-    this.host = null;
-    this.port = null;
-    this.path = [];
-    this.query = null;
-    this.fragment = null;
+    // The serialized URL, or null if it has to be recomputed.
+    this.href = null;
+    // Offsets into `href` as returned by parseHref(), or null if the
+    // components are stored individually.
+    this.components = null;
+    this._scheme = ':';
+    this._username = '';
+    this._password = '';
+    this._host = null;
+    this._port = null;
+    this._path = [];
+    this._query = null;
+    this._fragment = null;
+  }
+
+  setHref(href, components) {
+    this.flags = components[kURLComponentFlags];
+    this.href = href;
+    this.components = [
+      components[kURLComponentFlags],
+      components[kURLComponentProtocolEnd],
+      components[kURLComponentUsernameEnd],
+      components[kURLComponentHostStart],
+      components[kURLComponentHostEnd],
+      components[kURLComponentPort],
+      components[kURLComponentPathnameStart],
+      components[kURLComponentSearchStart],
+      components[kURLComponentHashStart]
+    ];
+  }
+
+  // Stores all components individually.
+  materialize() {
+    if (this.components === null)
+      return;
+    const { scheme, username, password, host, port, query, fragment } = this;
+    const path = lazyPath(this);
+    this.components = null;
+    this._scheme = scheme;
+    this._username = username;
+    this._password = password;
+    this._host = host;
+    this._port = port;
+    this._path = path;
+    this._query = query;
+    this._fragment = fragment;
+  }
+
+  get scheme() {
+    const components = this.components;
+    if (components === null)
+      return this._scheme;
+    return this.href.slice(0, components[kURLComponentProtocolEnd]);
+  }
+
+  set scheme(value) {
+    this.materialize();
+    this.href = null;
+    this._scheme = value;
+  }
+
+  get username() {
+    const components = this.components;
+    if (components === null)
+      return this._username;
+    if ((components[kURLComponentFlags] & URL_FLAGS_HAS_USERNAME) === 0)
+      return '';
+    return this.href.slice(components[kURLComponentProtocolEnd] + 2,
+                           components[kURLComponentUsernameEnd]);
+  }
+
+  set username(value) {
+    this.materialize();
+    this.href = null;
+    this._username = value;
+  }
+
+  get password() {
+    const components = this.components;
+    if (components === null)
+      return this._password;
+    if ((components[kURLComponentFlags] & URL_FLAGS_HAS_PASSWORD) === 0)
+      return '';
+    return this.href.slice(components[kURLComponentUsernameEnd] + 1,
+                           components[kURLComponentHostStart] - 1);
+  }
+
+  set password(value) {
+    this.materialize();
+    this.href = null;
+    this._password = value;
+  }
+
+  get host() {
+    const components = this.components;
+    if (components === null)
+      return this._host;
+    if ((components[kURLComponentFlags] & URL_FLAGS_HAS_HOST) === 0)
+      return null;
+    return this.href.slice(components[kURLComponentHostStart],
+                           components[kURLComponentHostEnd]);
+  }
+
+  set host(value) {
+    this.materialize();
+    this.href = null;
+    this._host = value;
+  }
+
+  get port() {
+    const components = this.components;
+    if (components === null)
+      return this._port;
+    const port = components[kURLComponentPort];
+    return port === kURLComponentOmitted ? null : port;
+  }
+
+  set port(value) {
+    this.materialize();
+    this.href = null;
+    this._port = value;
+  }
+
+  // The path is a mutable array, so it is not sliced out of `href` for every
+  // access.
+  get path() {
+    this.materialize();
+    return this._path;
+  }
+
+  set path(value) {
+    this.materialize();
+    this.href = null;
+    this._path = value;
+  }
+
+  get query() {
+    const components = this.components;
+    if (components === null)
+      return this._query;
+    const start = components[kURLComponentSearchStart];
+    if (start === kURLComponentOmitted)
+      return null;
+    const hashStart = components[kURLComponentHashStart];
+    return this.href.slice(start + 1, hashStart === kURLComponentOmitted ?
+      this.href.length : hashStart);
+  }
+
+  set query(value) {
+    this.materialize();
+    this.href = null;
+    this._query = value;
+  }
+
+  get fragment() {
+    const components = this.components;
+    if (components === null)
+      return this._fragment;
+    const start = components[kURLComponentHashStart];
+    if (start === kURLComponentOmitted)
+      return null;
+    return this.href.slice(start + 1);
+  }
+
+  set fragment(value) {
+    this.materialize();
+    this.href = null;
+    this._fragment = value;
+  }
+
+  [inspect.custom]() {
+    const obj = Object.create({ constructor: URLContext });
+    obj.flags = this.flags;
+    obj.scheme = this.scheme;
+    obj.username = this.username;
+    obj.password = this.password;
+    obj.host = this.host;
+    obj.port = this.port;
+    obj.path = this.path;
+    obj.query = this.query;
+    obj.fragment = this.fragment;
+    return obj;
   }
 }
 
+// Returns the serialized path of a lazily parsed URL context.
+function lazyPathname(ctx) {
+  const components = ctx.components;
+  let end = components[kURLComponentSearchStart];
+  if (end === kURLComponentOmitted)
+    end = components[kURLComponentHashStart];
+  if (end === kURLComponentOmitted)
+    end = ctx.href.length;
+  return ctx.href.slice(components[kURLComponentPathnameStart], end);
+}
+
+function lazyPath(ctx) {
+  const flags = ctx.components[kURLComponentFlags];
+  if ((flags & URL_FLAGS_HAS_PATH) === 0)
+    return [];
+  const pathname = lazyPathname(ctx);
+  if ((flags & URL_FLAGS_CANNOT_BE_BASE) !== 0)
+    return [pathname];
+  if (pathname === '')
+    return [];
+  return pathname.slice(1).split('/');
+}
+
 class URLSearchParams {
   // URL Standard says the default value is '', but as undefined and '' have
   // the same result, undefined is used to prevent unnecessary parsing.
@@ -243,6 +460,26 @@ function onParseError(flags, input) {
   throw new ERR_INVALID_URL(input);
 }
 
+function parseURL(url, input, base) {
+  const href = parseHref(input, base, urlComponents);
+  if (href === false)
+    throw new ERR_INVALID_URL(input);
+  if (href === undefined) {
+    // The serialized URL is not pure ASCII, so its offsets cannot be used
+    // for slicing. Fall back to creating each component separately.
+    parse(input, -1, base, undefined, onParseComplete.bind(url),
+          onParseError);
+    return;
+  }
+  const ctx = url[context];
+  ctx.setHref(href, urlComponents);
+  if (!url[searchParams]) { // Invoked from URL constructor
+    url[searchParams] = new URLSearchParams();
+    url[searchParams][context] = url;
+  }
+  initSearchParams(url[searchParams], ctx.query);
+}
+
 function onParseProtocolComplete(flags, protocol, username, password,
                                  host, port, path, query, fragment) {
   const ctx = this[context];
@@ -316,8 +553,7 @@ class URL {
       base_context = new URL(base)[context];
     }
     this[context] = new URLContext();
-    parse(input, -1, base_context, undefined, onParseComplete.bind(this),
-          onParseError);
+    parseURL(this, input, base_context);
   }
 
   get [special]() {
@@ -390,6 +626,10 @@ Object.defineProperties(URL.prototype, {
         ...options
       };
       const ctx = this[context];
+      if (ctx.href !== null && options.fragment && !options.unicode &&
+          options.search && options.auth) {
+        return ctx.href;
+      }
       var ret = ctx.scheme;
       if (ctx.host !== null) {
         ret += '//';
@@ -441,8 +681,7 @@ Object.defineProperties(URL.prototype, {
     set(input) {
       // toUSVString is not needed.
       input = `${input}`;
-      parse(input, -1, undefined, undefined, onParseComplete.bind(this),
-            onParseError);
+      parseURL(this, input, undefined);
     }
   },
   origin: {  // readonly
@@ -597,6 +836,11 @@ Object.defineProperties(URL.prototype, {
     configurable: true,
     get() {
       const ctx = this[context];
+      if (ctx.components !== null) {
+        if ((ctx.components[kURLComponentFlags] & URL_FLAGS_HAS_PATH) === 0)
+          return this[cannotBeBase] ? undefined : '';
+        return lazyPathname(ctx);
+      }
       if (this[cannotBeBase])
         return ctx.path[0];
       if (ctx.path.length === 0)
@@ -231,6 +231,11 @@ function initSocketHandle(self) {
 
 const kBytesRead = Symbol('kBytesRead');
 const kBytesWritten = Symbol('kBytesWritten');
+const kAcceptOptions = Symbol('kAcceptOptions');
+const kWriteCoalescing = Symbol('kWriteCoalescing');
+const kCorkedForCoalescing = Symbol('kCorkedForCoalescing');
+// Coalesced writes are written out early once they add up to this many bytes.
+const kWriteCoalescingThreshold = 16 * 1024;
 
 
 function Socket(options) {
@@ -247,6 +252,8 @@ function Socket(options) {
   this._host = null;
   this[kLastWriteQueueSize] = 0;
   this[kTimeout] = null;
+  this[kWriteCoalescing] = false;
+  this[kCorkedForCoalescing] = false;
 
   if (typeof options === 'number')
     options = { fd: options }; // Legacy interface.
@@ -450,6 +457,44 @@ Socket.prototype.setNoDelay = function(enable) {
 };
 
 
+Socket.prototype.setWriteCoalescing = function(enable) {
+  this[kWriteCoalescing] = enable === undefined ? true : !!enable;
+  if (!this[kWriteCoalescing])
+    flushCoalescedWrites(this);
+  return this;
+};
+
+
+Socket.prototype.write = function(chunk, encoding, cb) {
+  // With write coalescing, the socket stays corked until the next tick, so
+  // that the writes of the current tick are handed to _writev() together.
+  if (this[kWriteCoalescing] && !this[kCorkedForCoalescing]) {
+    this[kCorkedForCoalescing] = true;
+    this.cork();
+    process.nextTick(flushCoalescedWrites, this);
+  }
+
+  const ret = stream.Duplex.prototype.write.call(this, chunk, encoding, cb);
+
+  if (this[kCorkedForCoalescing] &&
+      this.writableLength >= kWriteCoalescingThreshold) {
+    flushCoalescedWrites(this);
+  }
+  return ret;
+};
+
+
+function flushCoalescedWrites(socket) {
+  if (socket[kCorkedForCoalescing]) {
+    socket[kCorkedForCoalescing] = false;
+    // Like writes to a corked socket, the writes of a destroyed socket are
+    // discarded.
+    if (!socket.destroyed)
+      socket.uncork();
+  }
+}
+
+
 Socket.prototype.setKeepAlive = function(setting, msecs) {
   if (!this._handle) {
     this.once('connect', () => this.setKeepAlive(setting, msecs));
@@ -1119,6 +1164,33 @@ Object.setPrototypeOf(Server, EventEmitter);
 
 function toNumber(x) { return (x = Number(x)) >= 0 ? x : false; }
 
+function getAcceptOptions(options) {
+  const { acceptBatchSize, deferAccept, fastOpen } = options;
+  if (acceptBatchSize === undefined &&
+      deferAccept === undefined &&
+      fastOpen === undefined) {
+    return null;
+  }
+  if (acceptBatchSize !== undefined)
+    validateInt32(acceptBatchSize, 'options.acceptBatchSize', 1);
+  if (deferAccept !== undefined)
+    validateInt32(deferAccept, 'options.deferAccept', 0);
+  if (fastOpen !== undefined)
+    validateInt32(fastOpen, 'options.fastOpen', 0);
+  return { acceptBatchSize, deferAccept, fastOpen };
+}
+
+function setAcceptOptions(handle, options) {
+  let err = 0;
+  if (options.deferAccept !== undefined)
+    err = handle.setDeferAccept(options.deferAccept);
+  if (err === 0 && options.fastOpen !== undefined)
+    err = handle.setFastOpen(options.fastOpen);
+  if (err === 0 && options.acceptBatchSize !== undefined)
+    handle.setAcceptBatchSize(options.acceptBatchSize);
+  return err;
+}
+
 // Returns handle if it can be created, or error code if it can't
 function createServerHandle(address, port, addressType, fd, flags) {
   var err = 0;
@@ -1155,18 +1227,21 @@ function createServerHandle(address, port, addressType, fd, flags) {
 
   if (address || port || isTCP) {
     debug('bind to', address || 'any');
+    // IPv4 sockets take all flags but UV_TCP_IPV6ONLY.
+    const ipv4Flags = flags & ~TCPConstants.UV_TCP_IPV6ONLY;
     if (!address) {
       // Try binding to ipv6 first
       err = handle.bind6(DEFAULT_IPV6_ADDR, port, flags);
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle(DEFAULT_IPV4_ADDR, port);
+        return createServerHandle(DEFAULT_IPV4_ADDR, port, undefined,
+                                  undefined, ipv4Flags);
       }
     } else if (addressType === 6) {
       err = handle.bind6(address, port, flags);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port, ipv4Flags);
     }
   }
 
@@ -1219,10 +1294,17 @@ function setupListenHandle(address, port, addressType, backlog, fd, flags) {
   this._handle.onconnection = onconnection;
   this._handle[owner_symbol] = this;
 
+  // The handles of round-robin cluster workers and of IPC servers don't take
+  // these options.
+  let err = 0;
+  if (this[kAcceptOptions] && this._handle instanceof TCP)
+    err = setAcceptOptions(this._handle, this[kAcceptOptions]);
+
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
   // the kernel does: backlogsize = roundup_pow_of_two(backlogsize + 1);
   // which will thus give us a backlog of 512 entries.
-  const err = this._handle.listen(backlog || 511);
+  if (err === 0)
+    err = this._handle.listen(backlog || 511);
 
   if (err) {
     var ex = uvExceptionWithHostPort(err, 'listen', address, port);
@@ -1324,6 +1406,7 @@ Server.prototype.listen = function(...args) {
 
   options = options._handle || options.handle || options;
   const flags = getFlags(options.ipv6Only);
+  this[kAcceptOptions] = getAcceptOptions(options);
   // (handle[, backlog][, cb]) where handle is an object with a handle
   if (options instanceof TCP) {
     this._handle = options;
@@ -1452,6 +1535,18 @@ function onconnection(err, clientHandle) {
     return;
   }
 
+  // Connections that were accepted in one batch, see the acceptBatchSize
+  // option of server.listen().
+  if (Array.isArray(clientHandle)) {
+    for (var i = 0; i < clientHandle.length; i++)
+      handleConnection(self, clientHandle[i]);
+    return;
+  }
+
+  handleConnection(self, clientHandle);
+}
+
+function handleConnection(self, clientHandle) {
   if (self.maxConnections && self._connections >= self.maxConnections) {
     clientHandle.close();
     return;
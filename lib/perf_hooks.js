@@ -4,11 +4,13 @@ const { Object } = primordials;
 
 const {
   ELDHistogram: _ELDHistogram,
+  LoopPhaseProfiler: _LoopPhaseProfiler,
   PerformanceEntry,
   mark: _mark,
   clearMark: _clearMark,
   measure: _measure,
   milestones,
+  ioStats,
   observerCounts,
   setupObservers,
   timeOrigin,
@@ -31,9 +33,31 @@ const {
   NODE_PERFORMANCE_MILESTONE_LOOP_START,
   NODE_PERFORMANCE_MILESTONE_LOOP_EXIT,
   NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE,
-  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT
+  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT,
+
+  NODE_PERFORMANCE_LOOP_PHASE_TIMERS,
+  NODE_PERFORMANCE_LOOP_PHASE_OTHER,
+  NODE_PERFORMANCE_LOOP_PHASE_POLL_WAIT,
+  NODE_PERFORMANCE_LOOP_PHASE_POLL,
+  NODE_PERFORMANCE_LOOP_PHASE_CHECK,
+  NODE_PERFORMANCE_LOOP_PHASE_NEXT_TICK,
+
+  NODE_PERFORMANCE_IO_STAT_CALLBACKS,
+  NODE_PERFORMANCE_IO_STAT_CALLBACK_TIME,
+  NODE_PERFORMANCE_IO_STAT_REQUESTS,
+  NODE_PERFORMANCE_IO_STAT_REQUEST_TIME,
+  NODE_PERFORMANCE_IO_STAT_BYTES_READ,
+  NODE_PERFORMANCE_IO_STAT_BYTES_WRITTEN,
+  NODE_PERFORMANCE_IO_STAT_WRITES,
+  NODE_PERFORMANCE_IO_STAT_WRITE_SYSCALLS,
+  NODE_PERFORMANCE_IO_STAT_THREADPOOL_REQUESTS,
+  NODE_PERFORMANCE_IO_STAT_THREADPOOL_QUEUE_TIME,
+  NODE_PERFORMANCE_IO_STAT_THREADPOOL_RUN_TIME,
+  NODE_PERFORMANCE_IO_STAT_INVALID
 } = constants;
 
+const { Providers } = internalBinding('async_wrap');
+
 const { AsyncResource } = require('async_hooks');
 const L = require('internal/linkedlist');
 const kInspect = require('internal/util').customInspectSymbol;
@@ -49,6 +73,7 @@ const {
 
 const { setImmediate } = require('timers');
 const kHandle = Symbol('handle');
+const kPhase = Symbol('phase');
 const kMap = Symbol('map');
 const kCallback = Symbol('callback');
 const kTypes = Symbol('types');
@@ -591,6 +616,105 @@ class ELDHistogram {
   }
 }
 
+class EventLoopPhaseHistogram {
+  constructor(handle, phase) {
+    this[kHandle] = handle;
+    this[kPhase] = phase;
+    this[kMap] = new Map();
+  }
+
+  get min() { return this[kHandle].min(this[kPhase]); }
+  get max() { return this[kHandle].max(this[kPhase]); }
+  get mean() { return this[kHandle].mean(this[kPhase]); }
+  get stddev() { return this[kHandle].stddev(this[kPhase]); }
+  percentile(percentile) {
+    if (typeof percentile !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('percentile', 'number', percentile);
+    }
+    if (percentile <= 0 || percentile > 100) {
+      throw new ERR_INVALID_ARG_VALUE.RangeError('percentile',
+                                                 percentile);
+    }
+    return this[kHandle].percentile(this[kPhase], percentile);
+  }
+  get percentiles() {
+    this[kMap].clear();
+    this[kHandle].percentiles(this[kPhase], this[kMap]);
+    return this[kMap];
+  }
+
+  [kInspect]() {
+    return {
+      min: this.min,
+      max: this.max,
+      mean: this.mean,
+      stddev: this.stddev,
+      percentiles: this.percentiles
+    };
+  }
+}
+
+class EventLoopPhaseMonitor {
+  constructor(handle) {
+    this[kHandle] = handle;
+    this.timers =
+      new EventLoopPhaseHistogram(handle, NODE_PERFORMANCE_LOOP_PHASE_TIMERS);
+    this.other =
+      new EventLoopPhaseHistogram(handle, NODE_PERFORMANCE_LOOP_PHASE_OTHER);
+    this.pollWait =
+      new EventLoopPhaseHistogram(handle,
+                                  NODE_PERFORMANCE_LOOP_PHASE_POLL_WAIT);
+    this.poll =
+      new EventLoopPhaseHistogram(handle, NODE_PERFORMANCE_LOOP_PHASE_POLL);
+    this.check =
+      new EventLoopPhaseHistogram(handle, NODE_PERFORMANCE_LOOP_PHASE_CHECK);
+    this.nextTick =
+      new EventLoopPhaseHistogram(handle,
+                                  NODE_PERFORMANCE_LOOP_PHASE_NEXT_TICK);
+  }
+
+  reset() { this[kHandle].reset(); }
+  enable() { return this[kHandle].enable(); }
+  disable() { return this[kHandle].disable(); }
+}
+
+const ioStatNames = [
+  ['callbacks', NODE_PERFORMANCE_IO_STAT_CALLBACKS],
+  ['callbackTime', NODE_PERFORMANCE_IO_STAT_CALLBACK_TIME],
+  ['requests', NODE_PERFORMANCE_IO_STAT_REQUESTS],
+  ['requestTime', NODE_PERFORMANCE_IO_STAT_REQUEST_TIME],
+  ['bytesRead', NODE_PERFORMANCE_IO_STAT_BYTES_READ],
+  ['bytesWritten', NODE_PERFORMANCE_IO_STAT_BYTES_WRITTEN],
+  ['writes', NODE_PERFORMANCE_IO_STAT_WRITES],
+  ['writeSyscalls', NODE_PERFORMANCE_IO_STAT_WRITE_SYSCALLS],
+  ['threadpoolRequests', NODE_PERFORMANCE_IO_STAT_THREADPOOL_REQUESTS],
+  ['threadpoolQueueTime', NODE_PERFORMANCE_IO_STAT_THREADPOOL_QUEUE_TIME],
+  ['threadpoolRunTime', NODE_PERFORMANCE_IO_STAT_THREADPOOL_RUN_TIME]
+];
+
+// Returns the I/O statistics of every provider type that has seen any
+// activity. This only reads the counters that are kept in native code.
+function getIOStatistics() {
+  const result = {};
+  for (const provider of Object.keys(Providers)) {
+    const offset = Providers[provider] * NODE_PERFORMANCE_IO_STAT_INVALID;
+    const stats = {};
+    let active = false;
+    for (const [name, stat] of ioStatNames) {
+      stats[name] = ioStats[offset + stat];
+      if (stats[name] !== 0)
+        active = true;
+    }
+    if (active)
+      result[provider] = stats;
+  }
+  return result;
+}
+
+function monitorEventLoopPhases() {
+  return new EventLoopPhaseMonitor(new _LoopPhaseProfiler());
+}
+
 function monitorEventLoopDelay(options = {}) {
   if (typeof options !== 'object' || options === null) {
     throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
@@ -609,7 +733,9 @@ function monitorEventLoopDelay(options = {}) {
 module.exports = {
   performance,
   PerformanceObserver,
-  monitorEventLoopDelay
+  monitorEventLoopDelay,
+  monitorEventLoopPhases,
+  getIOStatistics
 };
 
 Object.defineProperty(module.exports, 'constants', {
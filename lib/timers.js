@@ -37,10 +37,12 @@ const {
     kRefCount
   },
   kRefed,
+  kCoalesced,
   initAsyncResource,
   getTimerDuration,
   timerListMap,
-  timerListQueue,
+  unscheduleTimersList,
+  removeCoalescedTimer,
   immediateQueue,
   active,
   unrefActive
@@ -68,7 +70,10 @@ function unenroll(item) {
     item._destroyed = true;
   }
 
-  L.remove(item);
+  if (item[kCoalesced])
+    removeCoalescedTimer(item);
+  else
+    L.remove(item);
 
   // We only delete refed lists because unrefed ones are incredibly likely
   // to come from http and be recreated shortly after.
@@ -81,7 +86,7 @@ function unenroll(item) {
     const list = timerListMap[msecs];
     if (list !== undefined && L.isEmpty(list)) {
       debug('unenroll: list empty');
-      timerListQueue.removeAt(list.priorityQueuePosition);
+      unscheduleTimersList(list);
       delete timerListMap[list.msecs];
     }
 
@@ -17,7 +17,14 @@
 const { ObjectPrototype } = primordials;
 
 const { Buffer } = require('buffer');
-const { validateString } = require('internal/validators');
+const {
+  ERR_CPU_SAMPLER_RUNNING,
+  ERR_HEAP_SAMPLER_RUNNING,
+  ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_ARG_VALUE,
+  ERR_INVALID_CALLBACK
+} = require('internal/errors').codes;
+const { validateInt32, validateString } = require('internal/validators');
 const {
   Serializer: _Serializer,
   Deserializer: _Deserializer
@@ -29,8 +36,18 @@ const { getValidatedPath } = require('internal/fs/utils');
 const { toNamespacedPath } = require('path');
 const {
   createHeapSnapshotStream,
-  triggerHeapSnapshot
+  triggerHeapSnapshot,
+  HeapSnapshotWriteWrap,
+  startSamplingHeapProfiler,
+  stopSamplingHeapProfiler,
+  getSamplingHeapProfile,
+  writeSamplingHeapProfile
 } = internalBinding('heap_utils');
+const {
+  CpuSampler,
+  kCollapsed,
+  kPprof
+} = internalBinding('cpu_sampler');
 const { Readable } = require('stream');
 const { owner_symbol } = require('internal/async_hooks').symbols;
 const {
@@ -40,12 +57,56 @@ const {
 const kHandle = Symbol('kHandle');
 
 
-function writeHeapSnapshot(filename) {
+function getHeapSnapshotOptions(filename, options) {
   if (filename !== undefined) {
     filename = getValidatedPath(filename);
     filename = toNamespacedPath(filename);
   }
-  return triggerHeapSnapshot(filename);
+  if (options === undefined)
+    return { filename, compress: false, fd: undefined };
+  if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+
+  const { compress = false, fd } = options;
+  if (typeof compress !== 'boolean')
+    throw new ERR_INVALID_ARG_TYPE('options.compress', 'boolean', compress);
+  if (fd !== undefined) {
+    validateInt32(fd, 'options.fd', 0);
+    if (filename !== undefined) {
+      throw new ERR_INVALID_ARG_VALUE('options.fd', fd,
+                                      'cannot be used with a filename');
+    }
+  }
+  return { filename, compress, fd };
+}
+
+function writeHeapSnapshot(filename, options) {
+  const target = getHeapSnapshotOptions(filename, options);
+  return triggerHeapSnapshot(target.filename, target.compress, target.fd);
+}
+
+function writeHeapSnapshotInBackground(filename, options, callback) {
+  if (typeof filename === 'function') {
+    callback = filename;
+    filename = undefined;
+    options = undefined;
+  } else if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  if (typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  const target = getHeapSnapshotOptions(filename, options);
+  const req =
+    new HeapSnapshotWriteWrap(target.filename, target.compress, target.fd);
+  req.oncomplete = (err) => {
+    if (err)
+      callback(err);
+    else
+      callback(null, req.target);
+  };
+  return req.target;
 }
 
 class HeapSnapshotStream extends Readable {
@@ -79,6 +140,125 @@ function getHeapSnapshot() {
   return new HeapSnapshotStream(handle);
 }
 
+// The sampler of the last startCpuSampler() call. It is kept after
+// stopCpuSampler() so that its profile can still be read.
+let cpuSampler;
+let cpuSamplerRunning = false;
+let cpuSamplerFrequency;
+
+function startCpuSampler(options = {}) {
+  if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  const { frequency = 99, duration = 60 } = options;
+  validateInt32(frequency, 'options.frequency', 1, 10000);
+  validateInt32(duration, 'options.duration', 1, 86400);
+  if (cpuSamplerRunning)
+    throw new ERR_CPU_SAMPLER_RUNNING();
+
+  cpuSampler = new CpuSampler(frequency, duration);
+  cpuSamplerRunning = true;
+  cpuSamplerFrequency = frequency;
+}
+
+function stopCpuSampler() {
+  if (!cpuSamplerRunning)
+    return;
+  cpuSampler.stop();
+  cpuSamplerRunning = false;
+}
+
+function getSamplerFormat(format) {
+  if (format === undefined || format === 'collapsed')
+    return kCollapsed;
+  if (format === 'pprof')
+    return kPprof;
+  throw new ERR_INVALID_ARG_VALUE('format', format,
+                                  "must be 'collapsed' or 'pprof'");
+}
+
+function getCpuSamplerProfile(format) {
+  format = getSamplerFormat(format);
+  if (cpuSampler === undefined)
+    return undefined;
+  return cpuSampler.getProfile(format);
+}
+
+function writeCpuSamplerProfile(filename, format) {
+  if (filename !== undefined) {
+    filename = getValidatedPath(filename);
+    filename = toNamespacedPath(filename);
+  }
+  format = getSamplerFormat(format);
+  if (cpuSampler === undefined)
+    return undefined;
+  return cpuSampler.writeProfile(filename, format);
+}
+
+function getCpuSamplerStatistics() {
+  if (cpuSampler === undefined)
+    return undefined;
+  const [
+    samples,
+    droppedSamples,
+    aggregationTime,
+    elapsedTime
+  ] = cpuSampler.getStatistics();
+  return {
+    running: cpuSamplerRunning,
+    frequency: cpuSamplerFrequency,
+    samples,
+    droppedSamples,
+    aggregationTime: aggregationTime / 1e6,
+    elapsedTime: elapsedTime / 1e6,
+    overhead: elapsedTime > 0 ? aggregationTime / elapsedTime : 0
+  };
+}
+
+// The sampling interval of the heap sampler, or undefined if it was not
+// started by startHeapSampler(). V8 discards the profile when the sampler
+// is stopped, so unlike the CPU sampler nothing is kept after that.
+let heapSamplerInterval;
+
+function startHeapSampler(options = {}) {
+  if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  const { interval = 512 * 1024, stackDepth = 64 } = options;
+  validateInt32(interval, 'options.interval', 1);
+  validateInt32(stackDepth, 'options.stackDepth', 1, 1024);
+  // V8 has a single sampling heap profiler per isolate, which --heap-prof
+  // and inspector sessions use as well.
+  if (heapSamplerInterval !== undefined ||
+      !startSamplingHeapProfiler(interval, stackDepth)) {
+    throw new ERR_HEAP_SAMPLER_RUNNING();
+  }
+  heapSamplerInterval = interval;
+}
+
+function stopHeapSampler() {
+  if (heapSamplerInterval === undefined)
+    return;
+  stopSamplingHeapProfiler();
+  heapSamplerInterval = undefined;
+}
+
+function getHeapSamplerProfile(format) {
+  const pprof = getSamplerFormat(format) === kPprof;
+  if (heapSamplerInterval === undefined)
+    return undefined;
+  return getSamplingHeapProfile(pprof, heapSamplerInterval);
+}
+
+function writeHeapSamplerProfile(filename, format) {
+  if (filename !== undefined) {
+    filename = getValidatedPath(filename);
+    filename = toNamespacedPath(filename);
+  }
+  const pprof = getSamplerFormat(format) === kPprof;
+  if (heapSamplerInterval === undefined)
+    return undefined;
+  return writeSamplingHeapProfile(filename, pprof, heapSamplerInterval);
+}
+
 // Calling exposed c++ functions directly throws exception as it expected to be
 // called with new operator and caused an assert to fire.
 // Creating JS wrapper so that it gets caught at JS layer.
@@ -269,15 +449,25 @@ function deserialize(buffer) {
 
 module.exports = {
   cachedDataVersionTag,
+  getCpuSamplerProfile,
+  getCpuSamplerStatistics,
+  getHeapSamplerProfile,
   getHeapSnapshot,
   getHeapStatistics,
   getHeapSpaceStatistics,
   setFlagsFromString,
+  startCpuSampler,
+  startHeapSampler,
+  stopCpuSampler,
+  stopHeapSampler,
   Serializer,
   Deserializer,
   DefaultSerializer,
   DefaultDeserializer,
   deserialize,
   serialize,
-  writeHeapSnapshot
+  writeCpuSamplerProfile,
+  writeHeapSamplerProfile,
+  writeHeapSnapshot,
+  writeHeapSnapshotInBackground
 };
@@ -95,6 +95,7 @@
       'lib/internal/child_process.js',
       'lib/internal/cluster/child.js',
       'lib/internal/cluster/master.js',
+      'lib/internal/cluster/reuseport_handle.js',
       'lib/internal/cluster/round_robin_handle.js',
       'lib/internal/cluster/shared_handle.js',
       'lib/internal/cluster/utils.js',
@@ -147,6 +148,7 @@
       'lib/internal/main/worker_thread.js',
       'lib/internal/modules/cjs/helpers.js',
       'lib/internal/modules/cjs/loader.js',
+      'lib/internal/modules/code_cache.js',
       'lib/internal/modules/esm/loader.js',
       'lib/internal/modules/esm/create_dynamic_module.js',
       'lib/internal/modules/esm/default_resolve.js',
@@ -157,7 +159,6 @@
       'lib/internal/options.js',
       'lib/internal/policy/manifest.js',
       'lib/internal/policy/sri.js',
-      'lib/internal/priority_queue.js',
       'lib/internal/process/esm_loader.js',
       'lib/internal/process/execution.js',
       'lib/internal/process/main_thread_only.js',
@@ -522,6 +523,7 @@
         'src/node_config.cc',
         'src/node_constants.cc',
         'src/node_contextify.cc',
+        'src/node_cpu_sampler.cc',
         'src/node_credentials.cc',
         'src/node_domain.cc',
         'src/node_env_var.cc',
@@ -538,16 +540,20 @@
         'src/node_native_module_env.cc',
         'src/node_options.cc',
         'src/node_os.cc',
+        'src/node_package_json.cc',
         'src/node_perf.cc',
         'src/node_platform.cc',
         'src/node_postmortem_metadata.cc',
+        'src/node_pprof.cc',
         'src/node_process_events.cc',
         'src/node_process_methods.cc',
         'src/node_process_object.cc',
         'src/node_serdes.cc',
+        'src/node_snapshotable.cc',
         'src/node_stat_watcher.cc',
         'src/node_symbols.cc',
         'src/node_task_queue.cc',
+        'src/node_threadpool.cc',
         'src/node_trace_events.cc',
         'src/node_types.cc',
         'src/node_url.cc',
@@ -567,6 +573,7 @@
         'src/string_bytes.cc',
         'src/string_decoder.cc',
         'src/tcp_wrap.cc',
+        'src/timer_wheel.cc',
         'src/timers.cc',
         'src/tracing/agent.cc',
         'src/tracing/node_trace_buffer.cc',
@@ -621,13 +628,17 @@
         'src/node_object_wrap.h',
         'src/node_options.h',
         'src/node_options-inl.h',
+        'src/node_package_json.h',
         'src/node_perf.h',
         'src/node_perf_common.h',
         'src/node_platform.h',
+        'src/node_pprof.h',
         'src/node_process.h',
         'src/node_revert.h',
         'src/node_root_certs.h',
+        'src/node_snapshotable.h',
         'src/node_stat_watcher.h',
+        'src/node_threadpool.h',
         'src/node_union_bytes.h',
         'src/node_url.h',
         'src/node_version.h',
@@ -648,6 +659,7 @@
         'src/string_decoder-inl.h',
         'src/string_search.h',
         'src/tcp_wrap.h',
+        'src/timer_wheel.h',
         'src/tracing/agent.h',
         'src/tracing/node_trace_buffer.h',
         'src/tracing/node_trace_writer.h',
@@ -1092,7 +1104,9 @@
         'test/cctest/test_aliased_buffer.cc',
         'test/cctest/test_base64.cc',
         'test/cctest/test_node_postmortem_metadata.cc',
+        'test/cctest/test_package_json.cc',
         'test/cctest/test_environment.cc',
+        'test/cctest/test_timer_wheel.cc',
         'test/cctest/test_linked_binding.cc',
         'test/cctest/test_per_process.cc',
         'test/cctest/test_platform.cc',
@@ -1231,8 +1245,6 @@
         'src/node_snapshot_stub.cc',
         'src/node_code_cache_stub.cc',
         'tools/snapshot/node_mksnapshot.cc',
-        'tools/snapshot/snapshot_builder.cc',
-        'tools/snapshot/snapshot_builder.h',
       ],
 
       'conditions': [
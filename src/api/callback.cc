@@ -1,6 +1,7 @@
 #include "node.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "node_perf.h"
 #include "v8.h"
 
 namespace node {
@@ -37,7 +38,9 @@ InternalCallbackScope::InternalCallbackScope(AsyncWrap* async_wrap)
     : InternalCallbackScope(async_wrap->env(),
                             async_wrap->object(),
                             { async_wrap->get_async_id(),
-                              async_wrap->get_trigger_async_id() }) {}
+                              async_wrap->get_trigger_async_id() }) {
+  EnterContextFrame(async_wrap->context_frame());
+}
 
 InternalCallbackScope::InternalCallbackScope(Environment* env,
                                              Local<Object> object,
@@ -59,6 +62,11 @@ InternalCallbackScope::InternalCallbackScope(Environment* env,
   // If you hit this assertion, you forgot to enter the v8::Context first.
   CHECK_EQ(Environment::GetCurrent(env->isolate()), env);
 
+  if (env->loop_phase_profiler() != nullptr &&
+      env->async_callback_scope_depth() == 1) {
+    env->loop_phase_profiler()->OnCallback();
+  }
+
   if (asyncContext.async_id != 0) {
     // No need to check a return value because the application will exit if
     // an exception occurs.
@@ -74,6 +82,15 @@ InternalCallbackScope::~InternalCallbackScope() {
   Close();
 }
 
+void InternalCallbackScope::EnterContextFrame(Local<Value> frame) {
+  if (failed_ ||
+      env_->async_hooks()->fields()[AsyncHooks::kContextFrames] == 0) {
+    return;
+  }
+  outer_context_frame_ = AsyncWrap::GetContextFrame(env_);
+  AsyncWrap::SetContextFrame(env_, frame);
+}
+
 void InternalCallbackScope::Close() {
   if (closed_) return;
   closed_ = true;
@@ -86,6 +103,11 @@ void InternalCallbackScope::Close() {
   if (pushed_ids_)
     env_->async_hooks()->pop_async_id(async_context_.async_id);
 
+  if (!outer_context_frame_.IsEmpty() &&
+      env_->async_hooks()->fields()[AsyncHooks::kContextFrames] > 0) {
+    AsyncWrap::SetContextFrame(env_, outer_context_frame_);
+  }
+
   if (failed_) return;
 
   if (async_context_.async_id != 0) {
@@ -96,6 +118,8 @@ void InternalCallbackScope::Close() {
     return;
   }
 
+  performance::LoopPhaseScope phase_scope(
+      env_, performance::NODE_PERFORMANCE_LOOP_PHASE_NEXT_TICK);
   TickInfo* tick_info = env_->tick_info();
 
   if (!env_->can_call_into_js()) return;
@@ -135,7 +159,8 @@ MaybeLocal<Value> InternalMakeCallback(Environment* env,
                                        const Local<Function> callback,
                                        int argc,
                                        Local<Value> argv[],
-                                       async_context asyncContext) {
+                                       async_context asyncContext,
+                                       Local<Value> context_frame) {
   CHECK(!recv.IsEmpty());
 #ifdef DEBUG
   for (int i = 0; i < argc; i++)
@@ -143,6 +168,8 @@ MaybeLocal<Value> InternalMakeCallback(Environment* env,
 #endif
 
   InternalCallbackScope scope(env, recv, asyncContext);
+  if (!context_frame.IsEmpty())
+    scope.EnterContextFrame(context_frame);
   if (scope.Failed()) {
     return MaybeLocal<Value>();
   }
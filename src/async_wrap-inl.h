@@ -50,6 +50,32 @@ inline double AsyncWrap::get_trigger_async_id() const {
 }
 
 
+inline v8::Local<v8::Value> AsyncWrap::context_frame() const {
+  if (context_frame_.IsEmpty())
+    return v8::Undefined(env()->isolate());
+  return PersistentToLocal::Strong(context_frame_);
+}
+
+
+inline v8::Local<v8::Value> AsyncWrap::GetContextFrame(Environment* env) {
+  v8::Local<v8::Array> frames = env->async_context_frame();
+  v8::Local<v8::Value> frame;
+  if (frames.IsEmpty() ||
+      !frames->Get(env->context(), kCurrentContextFrame).ToLocal(&frame)) {
+    return v8::Undefined(env->isolate());
+  }
+  return frame;
+}
+
+
+inline void AsyncWrap::SetContextFrame(Environment* env,
+                                       v8::Local<v8::Value> frame) {
+  v8::Local<v8::Array> frames = env->async_context_frame();
+  if (frames.IsEmpty()) return;
+  USE(frames->Set(env->context(), kCurrentContextFrame, frame));
+}
+
+
 inline AsyncWrap::AsyncScope::AsyncScope(AsyncWrap* wrap)
     : wrap_(wrap) {
   Environment* env = wrap->env();
@@ -29,6 +29,7 @@
 #include "v8.h"
 #include "v8-profiler.h"
 
+using v8::Array;
 using v8::Context;
 using v8::DontDelete;
 using v8::EscapableHandleScope;
@@ -69,6 +70,10 @@ static const char* const provider_names[] = {
 };
 
 
+// The resource object that is passed to init() hooks for promises.
+static constexpr int kIsChainedPromiseField = 0;
+static constexpr int kPromiseWrapInternalFieldCount = 1;
+
 struct AsyncWrapObject : public AsyncWrap {
   static inline void New(const FunctionCallbackInfo<Value>& args) {
     Environment* env = Environment::GetCurrent(args);
@@ -175,55 +180,183 @@ void AsyncWrap::EmitAfter(Environment* env, double async_id) {
        env->async_hooks_after_function());
 }
 
-class PromiseWrap : public AsyncWrap {
+// Promises are not AsyncWraps. Their async ids are stored on the promise
+// itself, so that tracking them does not allocate anything besides the
+// property values. A resource object for the init() hooks and a weak handle
+// for the destroy() hooks and trace events are only created when needed.
+class PromiseDestroyParam {
  public:
-  PromiseWrap(Environment* env, Local<Object> object, bool silent)
-      : AsyncWrap(env, object, PROVIDER_PROMISE, kInvalidAsyncId, silent) {
-    MakeWeak();
+  PromiseDestroyParam(Environment* env,
+                      Local<Promise> promise,
+                      double async_id)
+      : env_(env),
+        async_id_(async_id),
+        promise_(env->isolate(), promise) {
+    promise_.SetWeak(this, WeakCallback, WeakCallbackType::kParameter);
+    env->AddCleanupHook(CleanupHook, this);
   }
 
-  SET_NO_MEMORY_INFO()
-  SET_MEMORY_INFO_NAME(PromiseWrap)
-  SET_SELF_SIZE(PromiseWrap)
-
-  static constexpr int kIsChainedPromiseField = 1;
-  static constexpr int kInternalFieldCount = 2;
-
-  static PromiseWrap* New(Environment* env,
-                          Local<Promise> promise,
-                          PromiseWrap* parent_wrap,
-                          bool silent);
-  static void getIsChainedPromise(Local<String> property,
-                                  const PropertyCallbackInfo<Value>& info);
+ private:
+  static void WeakCallback(const WeakCallbackInfo<PromiseDestroyParam>& info) {
+    std::unique_ptr<PromiseDestroyParam> p { info.GetParameter() };
+    p->env_->RemoveCleanupHook(CleanupHook, p.get());
+    TRACE_EVENT_NESTABLE_ASYNC_END0(
+        TRACING_CATEGORY_NODE1(async_hooks),
+        "PROMISE", static_cast<int64_t>(p->async_id_));
+    // Destroy hooks are emitted in batches from an immediate.
+    AsyncWrap::EmitDestroy(p->env_, p->async_id_);
+  }
+
+  // The Environment may go away before the promise is collected.
+  static void CleanupHook(void* arg) {
+    delete static_cast<PromiseDestroyParam*>(arg);
+  }
+
+  Environment* env_;
+  double async_id_;
+  Global<Promise> promise_;
 };
 
-PromiseWrap* PromiseWrap::New(Environment* env,
-                              Local<Promise> promise,
-                              PromiseWrap* parent_wrap,
-                              bool silent) {
-  Local<Object> obj;
-  if (!env->promise_wrap_template()->NewInstance(env->context()).ToLocal(&obj))
-    return nullptr;
-  obj->SetInternalField(PromiseWrap::kIsChainedPromiseField,
-                        parent_wrap != nullptr ? v8::True(env->isolate())
-                                               : v8::False(env->isolate()));
-  CHECK_NULL(promise->GetAlignedPointerFromInternalField(0));
-  promise->SetInternalField(0, obj);
-  return new PromiseWrap(env, obj, silent);
-}
-
-void PromiseWrap::getIsChainedPromise(Local<String> property,
-                                      const PropertyCallbackInfo<Value>& info) {
-  info.GetReturnValue().Set(
-    info.Holder()->GetInternalField(kIsChainedPromiseField));
+static inline bool AsyncHooksTracingEnabled() {
+  return *TRACE_EVENT_API_GET_CATEGORY_GROUP_ENABLED(
+      TRACING_CATEGORY_NODE1(async_hooks)) != 0;
 }
 
-static PromiseWrap* extractPromiseWrap(Local<Promise> promise) {
-  Local<Value> resource_object_value = promise->GetInternalField(0);
-  if (resource_object_value->IsObject()) {
-    return Unwrap<PromiseWrap>(resource_object_value.As<Object>());
+static void GetIsChainedPromise(Local<String> property,
+                                const PropertyCallbackInfo<Value>& info) {
+  info.GetReturnValue().Set(
+      info.Holder()->GetInternalField(kIsChainedPromiseField));
+}
+
+static bool GetPromiseAsyncIds(Environment* env,
+                               Local<Promise> promise,
+                               double* async_id,
+                               double* trigger_async_id) {
+  Local<Context> context = env->context();
+  Local<Value> id;
+  Local<Value> trigger_id;
+  if (!promise->GetPrivate(
+          context, env->promise_async_id_private_symbol()).ToLocal(&id) ||
+      !id->IsNumber() ||
+      !promise->GetPrivate(
+          context,
+          env->promise_trigger_async_id_private_symbol()).ToLocal(
+              &trigger_id) ||
+      !trigger_id->IsNumber()) {
+    return false;
+  }
+  *async_id = id.As<Number>()->Value();
+  *trigger_async_id = trigger_id.As<Number>()->Value();
+  return true;
+}
+
+// Assigns async ids to |promise|. If |silent| is false, the init() hooks are
+// emitted for it, with a resource object that is stored in the promise's
+// internal field.
+static bool InitPromise(Environment* env,
+                        Local<Promise> promise,
+                        Local<Value> parent,
+                        bool silent,
+                        double* async_id,
+                        double* trigger_async_id) {
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  AsyncHooks* async_hooks = env->async_hooks();
+
+  // Set the parent promise's async id as this promise's triggerAsyncId.
+  double parent_async_id;
+  double parent_trigger_async_id;
+  if (parent->IsPromise()) {
+    if (!GetPromiseAsyncIds(env, parent.As<Promise>(),
+                            &parent_async_id, &parent_trigger_async_id) &&
+        !InitPromise(env, parent.As<Promise>(), Undefined(isolate), true,
+                     &parent_async_id, &parent_trigger_async_id)) {
+      return false;
+    }
+    *trigger_async_id = parent_async_id;
+  } else {
+    *trigger_async_id = env->get_default_trigger_async_id();
+  }
+  *async_id = env->new_async_id();
+
+  if (promise->SetPrivate(context,
+                          env->promise_async_id_private_symbol(),
+                          Number::New(isolate, *async_id)).IsNothing() ||
+      promise->SetPrivate(context,
+                          env->promise_trigger_async_id_private_symbol(),
+                          Number::New(isolate, *trigger_async_id))
+          .IsNothing()) {
+    return false;
+  }
+
+  const bool trace_events = AsyncHooksTracingEnabled();
+  if (trace_events) {
+    auto data = tracing::TracedValue::Create();
+    data->SetInteger("executionAsyncId",
+                     static_cast<int64_t>(env->execution_async_id()));
+    data->SetInteger("triggerAsyncId",
+                     static_cast<int64_t>(*trigger_async_id));
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
+        TRACING_CATEGORY_NODE1(async_hooks),
+        "PROMISE", static_cast<int64_t>(*async_id),
+        "data", std::move(data));
+  }
+
+  // Deleted when the promise is collected or the Environment is cleaned up.
+  if (trace_events || async_hooks->fields()[AsyncHooks::kDestroy] > 0)
+    new PromiseDestroyParam(env, promise, *async_id);
+
+  if (silent || async_hooks->fields()[AsyncHooks::kInit] == 0)
+    return true;
+
+  Local<Object> resource;
+  if (!env->promise_wrap_template()->NewInstance(context).ToLocal(&resource))
+    return false;
+  resource->SetInternalField(kIsChainedPromiseField,
+                             v8::Boolean::New(isolate, parent->IsPromise()));
+  promise->SetInternalField(0, resource);
+  AsyncWrap::EmitAsyncInit(
+      env, resource,
+      async_hooks->provider_string(AsyncWrap::PROVIDER_PROMISE),
+      *async_id, *trigger_async_id);
+  return true;
+}
+
+// Propagates the AsyncLocalStorage context frame through promise reactions.
+// The frame is stored on the promise itself, so unlike the async_hooks path
+// below this does not need any calls into JS.
+static void ContextFramePromiseHook(Environment* env,
+                                    PromiseHookType type,
+                                    Local<Promise> promise) {
+  Local<Context> context = env->context();
+  Local<Array> frames = env->async_context_frame();
+  if (type == PromiseHookType::kInit) {
+    Local<Value> frame = AsyncWrap::GetContextFrame(env);
+    if (!frame->IsUndefined()) {
+      USE(promise->SetPrivate(
+          context, env->context_frame_private_symbol(), frame));
+    }
+  } else if (type == PromiseHookType::kBefore) {
+    Local<Value> frame;
+    if (!promise->GetPrivate(
+            context, env->context_frame_private_symbol()).ToLocal(&frame)) {
+      return;
+    }
+    USE(frames->Set(context,
+                    AsyncWrap::kPromiseOuterContextFrame,
+                    AsyncWrap::GetContextFrame(env)));
+    AsyncWrap::SetContextFrame(env, frame);
+  } else if (type == PromiseHookType::kAfter) {
+    Local<Value> frame;
+    if (!frames->Get(context,
+                     AsyncWrap::kPromiseOuterContextFrame).ToLocal(&frame)) {
+      return;
+    }
+    AsyncWrap::SetContextFrame(env, frame);
+    USE(frames->Set(context,
+                    AsyncWrap::kPromiseOuterContextFrame,
+                    Undefined(env->isolate())));
   }
-  return nullptr;
 }
 
 static void PromiseHook(PromiseHookType type, Local<Promise> promise,
@@ -235,49 +368,40 @@ static void PromiseHook(PromiseHookType type, Local<Promise> promise,
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "EnvPromiseHook", env);
 
-  PromiseWrap* wrap = extractPromiseWrap(promise);
-  if (type == PromiseHookType::kInit || wrap == nullptr) {
-    bool silent = type != PromiseHookType::kInit;
+  if (env->async_hooks()->fields()[AsyncHooks::kContextFrames] > 0)
+    ContextFramePromiseHook(env, type, promise);
+  if (!env->async_hooks()->promise_tracking_enabled()) return;
 
-    // set parent promise's async Id as this promise's triggerAsyncId
-    if (parent->IsPromise()) {
-      // parent promise exists, current promise
-      // is a chained promise, so we set parent promise's id as
-      // current promise's triggerAsyncId
-      Local<Promise> parent_promise = parent.As<Promise>();
-      PromiseWrap* parent_wrap = extractPromiseWrap(parent_promise);
-      if (parent_wrap == nullptr) {
-        parent_wrap = PromiseWrap::New(env, parent_promise, nullptr, true);
-        if (parent_wrap == nullptr) return;
-      }
-
-      AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(parent_wrap);
-      wrap = PromiseWrap::New(env, promise, parent_wrap, silent);
-    } else {
-      wrap = PromiseWrap::New(env, promise, nullptr, silent);
+  double async_id;
+  double trigger_async_id;
+  if (type == PromiseHookType::kInit ||
+      !GetPromiseAsyncIds(env, promise, &async_id, &trigger_async_id)) {
+    bool silent = type != PromiseHookType::kInit;
+    if (!InitPromise(env, promise, parent, silent,
+                     &async_id, &trigger_async_id)) {
+      return;
     }
   }
 
-  if (wrap == nullptr) return;
-
   if (type == PromiseHookType::kBefore) {
-    env->async_hooks()->push_async_ids(
-      wrap->get_async_id(), wrap->get_trigger_async_id());
-    wrap->EmitTraceEventBefore();
-    AsyncWrap::EmitBefore(wrap->env(), wrap->get_async_id());
+    env->async_hooks()->push_async_ids(async_id, trigger_async_id);
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(
+        TRACING_CATEGORY_NODE1(async_hooks),
+        "PROMISE_CALLBACK", static_cast<int64_t>(async_id));
+    AsyncWrap::EmitBefore(env, async_id);
   } else if (type == PromiseHookType::kAfter) {
-    wrap->EmitTraceEventAfter(wrap->provider_type(), wrap->get_async_id());
-    AsyncWrap::EmitAfter(wrap->env(), wrap->get_async_id());
-    if (env->execution_async_id() == wrap->get_async_id()) {
+    AsyncWrap::EmitTraceEventAfter(AsyncWrap::PROVIDER_PROMISE, async_id);
+    AsyncWrap::EmitAfter(env, async_id);
+    if (env->execution_async_id() == async_id) {
       // This condition might not be true if async_hooks was enabled during
       // the promise callback execution.
       // Popping it off the stack can be skipped in that case, because it is
       // known that it would correspond to exactly one call with
       // PromiseHookType::kBefore that was not witnessed by the PromiseHook.
-      env->async_hooks()->pop_async_id(wrap->get_async_id());
+      env->async_hooks()->pop_async_id(async_id);
     }
   } else if (type == PromiseHookType::kResolve) {
-    AsyncWrap::EmitPromiseResolve(wrap->env(), wrap->get_async_id());
+    AsyncWrap::EmitPromiseResolve(env, async_id);
   }
 }
 
@@ -317,27 +441,49 @@ static void SetupHooks(const FunctionCallbackInfo<Value>& args) {
     ctor->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "PromiseWrap"));
     Local<ObjectTemplate> promise_wrap_template = ctor->InstanceTemplate();
     promise_wrap_template->SetInternalFieldCount(
-        PromiseWrap::kInternalFieldCount);
+        kPromiseWrapInternalFieldCount);
     promise_wrap_template->SetAccessor(
         FIXED_ONE_BYTE_STRING(env->isolate(), "isChainedPromise"),
-        PromiseWrap::getIsChainedPromise);
+        GetIsChainedPromise);
     env->set_promise_wrap_template(promise_wrap_template);
   }
 }
 
 
+// The per-Isolate API provides no way of knowing whether there are multiple
+// users of the PromiseHook. That hopefully goes away when V8 introduces
+// a per-context API.
+static void UpdatePromiseHook(Environment* env) {
+  AsyncHooks* async_hooks = env->async_hooks();
+  bool needed = async_hooks->promise_tracking_enabled() ||
+                async_hooks->fields()[AsyncHooks::kContextFrames] > 0;
+  env->isolate()->SetPromiseHook(needed ? PromiseHook : nullptr);
+}
+
+
 static void EnablePromiseHook(const FunctionCallbackInfo<Value>& args) {
-  args.GetIsolate()->SetPromiseHook(PromiseHook);
+  Environment* env = Environment::GetCurrent(args);
+  env->async_hooks()->set_promise_tracking_enabled(true);
+  UpdatePromiseHook(env);
 }
 
 
 static void DisablePromiseHook(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+  env->async_hooks()->set_promise_tracking_enabled(false);
+  UpdatePromiseHook(env);
+}
 
-  // The per-Isolate API provides no way of knowing whether there are multiple
-  // users of the PromiseHook. That hopefully goes away when V8 introduces
-  // a per-context API.
-  isolate->SetPromiseHook(nullptr);
+
+// Called by JS after it has changed fields_[kContextFrames] from 0 to 1 or
+// from 1 to 0. In both cases, any frame that is still around belongs to
+// AsyncLocalStorage instances that have been disabled.
+static void ResetContextFrames(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Array> frames = env->async_context_frame();
+  for (uint32_t i = 0; i < AsyncWrap::kContextFrameSlotsCount; i++)
+    frames->Set(env->context(), i, Undefined(env->isolate())).Check();
+  UpdatePromiseHook(env);
 }
 
 
@@ -470,6 +616,7 @@ void AsyncWrap::Initialize(Local<Object> target,
   env->SetMethod(target, "queueDestroyAsyncId", QueueDestroyAsyncId);
   env->SetMethod(target, "enablePromiseHook", EnablePromiseHook);
   env->SetMethod(target, "disablePromiseHook", DisablePromiseHook);
+  env->SetMethod(target, "resetContextFrames", ResetContextFrames);
   env->SetMethod(target, "registerDestroyHook", RegisterDestroyHook);
 
   PropertyAttribute ReadOnlyDontDelete =
@@ -507,6 +654,13 @@ void AsyncWrap::Initialize(Local<Object> target,
               env->async_ids_stack_string(),
               env->async_hooks()->async_ids_stack().GetJSArray()).Check();
 
+  // Slot kCurrentContextFrame holds the current AsyncLocalStorage context
+  // frame. It is read and written directly from JS.
+  Local<Array> async_context_frame =
+      Array::New(isolate, AsyncWrap::kContextFrameSlotsCount);
+  env->set_async_context_frame(async_context_frame);
+  FORCE_SET_TARGET_FIELD(target, "async_context_frame", async_context_frame);
+
   target->Set(context,
               FIXED_ONE_BYTE_STRING(env->isolate(), "owner_symbol"),
               env->owner_symbol()).Check();
@@ -528,6 +682,7 @@ void AsyncWrap::Initialize(Local<Object> target,
   SET_HOOKS_CONSTANT(kAsyncIdCounter);
   SET_HOOKS_CONSTANT(kDefaultTriggerAsyncId);
   SET_HOOKS_CONSTANT(kStackLength);
+  SET_HOOKS_CONSTANT(kContextFrames);
 #undef SET_HOOKS_CONSTANT
   FORCE_SET_TARGET_FIELD(target, "constants", constants);
 
@@ -570,20 +725,13 @@ AsyncWrap::AsyncWrap(Environment* env,
                      Local<Object> object,
                      ProviderType provider,
                      double execution_async_id)
-    : AsyncWrap(env, object, provider, execution_async_id, false) {}
-
-AsyncWrap::AsyncWrap(Environment* env,
-                     Local<Object> object,
-                     ProviderType provider,
-                     double execution_async_id,
-                     bool silent)
     : BaseObject(env, object),
       provider_type_(provider) {
   CHECK_NE(provider, PROVIDER_NONE);
   CHECK_GE(object->InternalFieldCount(), 1);
 
   // Use AsyncReset() call to execute the init() callbacks.
-  AsyncReset(execution_async_id, silent);
+  AsyncReset(execution_async_id);
 }
 
 AsyncWrap::AsyncWrap(Environment* env, v8::Local<v8::Object> object)
@@ -649,6 +797,16 @@ void AsyncWrap::AsyncReset(Local<Object> resource, double execution_async_id,
                                                      : execution_async_id;
   trigger_async_id_ = env()->get_default_trigger_async_id();
 
+  if (env()->async_hooks()->fields()[AsyncHooks::kContextFrames] > 0) {
+    Local<Value> frame = GetContextFrame(env());
+    if (frame->IsUndefined())
+      context_frame_.Reset();
+    else
+      context_frame_.Reset(env()->isolate(), frame);
+  } else {
+    context_frame_.Reset();
+  }
+
   switch (provider_type()) {
 #define V(PROVIDER)                                                           \
     case PROVIDER_ ## PROVIDER:                                               \
@@ -713,15 +871,23 @@ MaybeLocal<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
                                           Local<Value>* argv) {
   EmitTraceEventBefore();
 
+  Environment* env = this->env();
   ProviderType provider = provider_type();
   async_context context { get_async_id(), get_trigger_async_id() };
+  uint64_t start = uv_hrtime();
   MaybeLocal<Value> ret = InternalMakeCallback(
-      env(), object(), cb, argc, argv, context);
+      env, object(), cb, argc, argv, context, context_frame());
 
   // This is a static call with cached values because the `this` object may
   // no longer be alive at this point.
   EmitTraceEventAfter(provider, context.async_id);
 
+  performance::performance_state* state = env->performance_state();
+  state->RecordIO(provider, performance::NODE_PERFORMANCE_IO_STAT_CALLBACKS);
+  state->RecordIO(provider,
+                  performance::NODE_PERFORMANCE_IO_STAT_CALLBACK_TIME,
+                  uv_hrtime() - start);
+
   return ret;
 }
 
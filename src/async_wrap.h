@@ -163,6 +163,24 @@ class AsyncWrap : public BaseObject {
 
   inline double get_trigger_async_id() const;
 
+  // The context frame that was current when this resource was last reset, or
+  // undefined. It is made current again while the resource's callbacks run.
+  inline v8::Local<v8::Value> context_frame() const;
+
+  // The context frame is the value in which AsyncLocalStorage instances keep
+  // their stores. It is shared with JS through the async_context_frame array,
+  // and is only tracked while AsyncHooks::kContextFrames is not 0.
+  enum ContextFrameSlots {
+    kCurrentContextFrame,
+    // The frame that was current when the running promise reaction started.
+    // Promise reactions never nest, so a single slot is enough.
+    kPromiseOuterContextFrame,
+    kContextFrameSlotsCount
+  };
+  static inline v8::Local<v8::Value> GetContextFrame(Environment* env);
+  static inline void SetContextFrame(Environment* env,
+                                     v8::Local<v8::Value> frame);
+
   void AsyncReset(v8::Local<v8::Object> resource,
                   double execution_async_id = kInvalidAsyncId,
                   bool silent = false);
@@ -211,17 +229,11 @@ class AsyncWrap : public BaseObject {
   };
 
  private:
-  friend class PromiseWrap;
-
-  AsyncWrap(Environment* env,
-            v8::Local<v8::Object> promise,
-            ProviderType provider,
-            double execution_async_id,
-            bool silent);
   ProviderType provider_type_;
   // Because the values may be Reset(), cannot be made const.
   double async_id_ = kInvalidAsyncId;
   double trigger_async_id_;
+  v8::Global<v8::Value> context_frame_;
 };
 
 }  // namespace node
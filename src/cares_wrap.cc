@@ -29,10 +29,15 @@
 #include "util-inl.h"
 #include "uv.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
+#include <list>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #ifdef __POSIX__
@@ -57,8 +62,10 @@ namespace node {
 namespace cares_wrap {
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -85,6 +92,13 @@ inline uint32_t cares_get_32bit(const unsigned char* p) {
          static_cast<uint32_t>(p[3]);
 }
 
+inline void cares_set_32bit(unsigned char* p, uint32_t value) {
+  p[0] = value >> 24;
+  p[1] = value >> 16;
+  p[2] = value >> 8;
+  p[3] = value;
+}
+
 const int ns_t_cname_or_a = -1;
 
 #define DNS_ESETSRVPENDING -1000
@@ -170,6 +184,17 @@ class ChannelWrap : public AsyncWrap {
   }
   inline int active_query_count() { return active_query_count_; }
   inline node_ares_task_list* task_list() { return &task_list_; }
+  // Identifies the servers set through setServers() in DNS cache keys.
+  inline const std::string& servers_key() const { return servers_key_; }
+  inline void set_servers_key(std::string&& key) {
+    servers_key_ = std::move(key);
+  }
+  // The callback pointers of queries that wait for an identical query in
+  // flight, by DNS cache key.
+  inline std::unordered_map<std::string, std::vector<void*>>*
+      pending_queries() {
+    return &pending_queries_;
+  }
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     if (timer_handle_ != nullptr)
@@ -190,6 +215,8 @@ class ChannelWrap : public AsyncWrap {
   bool library_inited_;
   int active_query_count_;
   node_ares_task_list task_list_;
+  std::string servers_key_;
+  std::unordered_map<std::string, std::vector<void*>> pending_queries_;
 };
 
 ChannelWrap::ChannelWrap(Environment* env,
@@ -226,8 +253,13 @@ class GetAddrInfoReqWrap : public ReqWrap<uv_getaddrinfo_t> {
 
   bool verbatim() const { return verbatim_; }
 
+  // The key of the result in the DNS cache, if the cache is enabled.
+  const std::string& cache_key() const { return cache_key_; }
+  void set_cache_key(std::string&& key) { cache_key_ = std::move(key); }
+
  private:
   const bool verbatim_;
+  std::string cache_key_;
 };
 
 GetAddrInfoReqWrap::GetAddrInfoReqWrap(Environment* env,
@@ -253,6 +285,183 @@ GetNameInfoReqWrap::GetNameInfoReqWrap(Environment* env,
 }
 
 
+// A cache of dns.lookup() and resolver results that is shared by all
+// Environments of the process. It is enabled by --dns-cache-size.
+class DNSCache {
+ public:
+  struct Entry {
+    int status = 0;
+    uint64_t stored_at = 0;
+    uint64_t expires_at = 0;
+    // The addresses of a dns.lookup() result, in the order in which
+    // getaddrinfo() returned them.
+    std::vector<std::string> addresses;
+    // The raw reply to a resolver query.
+    std::vector<unsigned char> reply;
+  };
+
+  enum Stat {
+    kHits,
+    kMisses,
+    kCoalesced,
+    kEvictions,
+    kEntries,
+    kStatCount
+  };
+
+  inline bool enabled() const {
+    return per_process::cli_options->dns_cache_size > 0;
+  }
+
+  // Copies the entry for |key| into |entry| if it has not expired yet.
+  bool Get(const std::string& key, Entry* entry) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.first.expires_at <= uv_hrtime()) {
+      lru_.erase(it->second.second);
+      entries_.erase(it);
+      it = entries_.end();
+    }
+    if (it == entries_.end()) {
+      stats_[kMisses]++;
+      return false;
+    }
+    stats_[kHits]++;
+    lru_.splice(lru_.begin(), lru_, it->second.second);
+    *entry = it->second.first;
+    return true;
+  }
+
+  // Stores |entry| for |ttl| seconds.
+  void Put(const std::string& key, Entry&& entry, uint32_t ttl) {
+    if (ttl == 0)
+      return;
+    Mutex::ScopedLock lock(mutex_);
+    entry.stored_at = uv_hrtime();
+    entry.expires_at = entry.stored_at + ttl * static_cast<uint64_t>(1e9);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.second);
+      it->second.first = std::move(entry);
+      return;
+    }
+    while (entries_.size() >= per_process::cli_options->dns_cache_size) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+      stats_[kEvictions]++;
+    }
+    lru_.push_front(key);
+    entries_.emplace(key, std::make_pair(std::move(entry), lru_.begin()));
+  }
+
+  void Clear() {
+    Mutex::ScopedLock lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+  }
+
+  void RecordCoalesced() {
+    Mutex::ScopedLock lock(mutex_);
+    stats_[kCoalesced]++;
+  }
+
+  void GetStats(double* stats) {
+    Mutex::ScopedLock lock(mutex_);
+    for (int i = 0; i < kEntries; i++)
+      stats[i] = static_cast<double>(stats_[i]);
+    stats[kEntries] = static_cast<double>(entries_.size());
+  }
+
+  // dns.lookup() calls that wait for an identical call of the same
+  // Environment that is already in flight. They are keyed by the
+  // Environment, too, because they are completed on its thread.
+  using PendingLookups =
+      std::vector<std::unique_ptr<GetAddrInfoReqWrap>>;
+
+  // Returns false if there is no identical call in flight. |req_wrap| is
+  // then left alone, and the caller is expected to call FinishLookup()
+  // once its own call is done.
+  bool JoinLookup(const std::string& key,
+                  std::unique_ptr<GetAddrInfoReqWrap>* req_wrap) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = pending_lookups_.find({(*req_wrap)->env(), key});
+    if (it == pending_lookups_.end()) {
+      pending_lookups_.emplace(
+          std::make_pair((*req_wrap)->env(), key), PendingLookups());
+      return false;
+    }
+    stats_[kCoalesced]++;
+    it->second.push_back(std::move(*req_wrap));
+    return true;
+  }
+
+  PendingLookups FinishLookup(Environment* env, const std::string& key) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = pending_lookups_.find({env, key});
+    CHECK(it != pending_lookups_.end());
+    PendingLookups waiting = std::move(it->second);
+    pending_lookups_.erase(it);
+    return waiting;
+  }
+
+ private:
+  Mutex mutex_;
+  // Most recently used keys first.
+  std::list<std::string> lru_;
+  std::unordered_map<std::string,
+                     std::pair<Entry, std::list<std::string>::iterator>>
+      entries_;
+  std::map<std::pair<Environment*, std::string>, PendingLookups>
+      pending_lookups_;
+  uint64_t stats_[kEntries] = {};
+};
+
+DNSCache dns_cache;
+
+// Skips the possibly compressed domain name at |*p|.
+bool SkipName(const unsigned char* end, const unsigned char** p) {
+  while (*p < end) {
+    const unsigned char length = **p;
+    if ((length & 0xc0) == 0xc0) {
+      *p += 2;
+      return *p <= end;
+    }
+    if ((length & 0xc0) != 0)
+      return false;
+    *p += 1 + length;
+    if (length == 0)
+      return *p <= end;
+  }
+  return false;
+}
+
+// Calls |fn| with a pointer to the TTL of each record in the answer section
+// of the DNS reply |buf|. Returns false if the reply is malformed.
+template <typename Fn>
+bool ForEachAnswerTTL(unsigned char* buf, int len, Fn fn) {
+  if (len < NS_HFIXEDSZ)
+    return false;
+  const unsigned char* end = buf + len;
+  const unsigned char* p = buf + NS_HFIXEDSZ;
+  const unsigned int qdcount = cares_get_16bit(buf + 4);
+  const unsigned int ancount = cares_get_16bit(buf + 6);
+  for (unsigned int i = 0; i < qdcount; i++) {
+    if (!SkipName(end, &p) || end - p < NS_QFIXEDSZ)
+      return false;
+    p += NS_QFIXEDSZ;
+  }
+  for (unsigned int i = 0; i < ancount; i++) {
+    if (!SkipName(end, &p) || end - p < NS_RRFIXEDSZ)
+      return false;
+    fn(buf + (p - buf) + 4);
+    p += NS_RRFIXEDSZ + cares_get_16bit(p + 8);
+    if (p > end)
+      return false;
+  }
+  return true;
+}
+
+
 /* This is called once per second by loop->timer. It is used to constantly */
 /* call back into c-ares for possibly processing timeouts. */
 void ChannelWrap::AresTimeout(uv_timer_t* handle) {
@@ -608,8 +817,83 @@ class QueryWrap : public AsyncWrap {
     TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
       TRACING_CATEGORY_NODE2(dns, native), trace_name_, this,
       "name", TRACE_STR_COPY(name));
-    ares_query(channel_->cares_channel(), name, dnsclass, type, Callback,
-               MakeCallbackPointer());
+    if (!dns_cache.enabled()) {
+      ares_query(channel_->cares_channel(), name, dnsclass, type, Callback,
+                 MakeCallbackPointer());
+      return;
+    }
+
+    std::string key = "query:" + channel_->servers_key() + ":" +
+                      std::to_string(dnsclass) + ":" + std::to_string(type) +
+                      ":" + name;
+    DNSCache::Entry entry;
+    if (dns_cache.Get(key, &entry)) {
+      if (entry.status != ARES_SUCCESS) {
+        Callback(MakeCallbackPointer(), entry.status, 0, nullptr, 0);
+        return;
+      }
+      // Count the TTLs down by the time the reply spent in the cache.
+      const uint32_t age = (uv_hrtime() - entry.stored_at) / 1e9;
+      CHECK(ForEachAnswerTTL(entry.reply.data(),
+                             static_cast<int>(entry.reply.size()),
+                             [&](unsigned char* p) {
+        const uint32_t ttl = cares_get_32bit(p);
+        cares_set_32bit(p, ttl > age ? ttl - age : 0);
+      }));
+      Callback(MakeCallbackPointer(), ARES_SUCCESS, 0,
+               entry.reply.data(), static_cast<int>(entry.reply.size()));
+      return;
+    }
+
+    auto pending = channel_->pending_queries()->find(key);
+    if (pending != channel_->pending_queries()->end()) {
+      dns_cache.RecordCoalesced();
+      pending->second.push_back(MakeCallbackPointer());
+      return;
+    }
+    channel_->pending_queries()->emplace(key,
+                                         std::vector<void*> {
+                                           MakeCallbackPointer()
+                                         });
+    ares_query(channel_->cares_channel(), name, dnsclass, type,
+               CachingCallback, new CachingQuery { channel_, key });
+  }
+
+  struct CachingQuery {
+    ChannelWrap* channel;
+    std::string key;
+  };
+
+  // Stores the reply in the DNS cache, and passes it on to all queries
+  // that have been waiting for it.
+  static void CachingCallback(void* arg, int status, int timeouts,
+                              unsigned char* answer_buf, int answer_len) {
+    std::unique_ptr<CachingQuery> query { static_cast<CachingQuery*>(arg) };
+
+    uint32_t ttl = 0;
+    DNSCache::Entry entry;
+    entry.status = status;
+    if (status == ARES_SUCCESS) {
+      // Use the smallest TTL of the records in the answer.
+      ttl = UINT32_MAX;
+      if (!ForEachAnswerTTL(answer_buf, answer_len, [&](unsigned char* p) {
+            ttl = std::min(ttl, cares_get_32bit(p));
+          })) {
+        ttl = 0;
+      }
+      entry.reply.assign(answer_buf, answer_buf + answer_len);
+    } else if (status == ARES_ENOTFOUND || status == ARES_ENODATA) {
+      ttl = per_process::cli_options->dns_cache_negative_ttl;
+    }
+    if (ttl != UINT32_MAX)
+      dns_cache.Put(query->key, std::move(entry), ttl);
+
+    auto pending = query->channel->pending_queries()->find(query->key);
+    CHECK(pending != query->channel->pending_queries()->end());
+    std::vector<void*> waiting = std::move(pending->second);
+    query->channel->pending_queries()->erase(pending);
+    for (void* waiter : waiting)
+      Callback(waiter, status, timeouts, answer_buf, answer_len);
   }
 
   struct ResponseData {
@@ -1806,9 +2090,11 @@ static void Query(const FunctionCallbackInfo<Value>& args) {
 }
 
 
-void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
-  std::unique_ptr<GetAddrInfoReqWrap> req_wrap {
-      static_cast<GetAddrInfoReqWrap*>(req->data)};
+// Makes the callback for a dns.lookup() call that resulted in |status| and
+// |addresses|, in the order in which getaddrinfo() returned them.
+void FinishGetAddrInfo(std::unique_ptr<GetAddrInfoReqWrap> req_wrap,
+                       int status,
+                       const std::vector<std::string>& addresses) {
   Environment* env = req_wrap->env();
 
   HandleScope handle_scope(env->isolate());
@@ -1826,25 +2112,13 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
     Local<Array> results = Array::New(env->isolate());
 
     auto add = [&] (bool want_ipv4, bool want_ipv6) {
-      for (auto p = res; p != nullptr; p = p->ai_next) {
-        CHECK_EQ(p->ai_socktype, SOCK_STREAM);
-
-        const char* addr;
-        if (want_ipv4 && p->ai_family == AF_INET) {
-          addr = reinterpret_cast<char*>(
-              &(reinterpret_cast<struct sockaddr_in*>(p->ai_addr)->sin_addr));
-        } else if (want_ipv6 && p->ai_family == AF_INET6) {
-          addr = reinterpret_cast<char*>(
-              &(reinterpret_cast<struct sockaddr_in6*>(p->ai_addr)->sin6_addr));
-        } else {
+      for (const std::string& address : addresses) {
+        const bool is_ipv6 = address.find(':') != std::string::npos;
+        if (is_ipv6 ? !want_ipv6 : !want_ipv4)
           continue;
-        }
-
-        char ip[INET6_ADDRSTRLEN];
-        if (uv_inet_ntop(p->ai_family, addr, ip, sizeof(ip)))
-          continue;
-
-        Local<String> s = OneByteString(env->isolate(), ip);
+        Local<String> s = OneByteString(env->isolate(),
+                                        address.data(),
+                                        address.size());
         results->Set(env->context(), n, s).Check();
         n++;
       }
@@ -1862,8 +2136,6 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
     argv[1] = results;
   }
 
-  uv_freeaddrinfo(res);
-
   TRACE_EVENT_NESTABLE_ASYNC_END2(
       TRACING_CATEGORY_NODE2(dns, native), "lookup", req_wrap.get(),
       "count", n, "verbatim", verbatim);
@@ -1873,6 +2145,58 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
 }
 
 
+void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
+  std::unique_ptr<GetAddrInfoReqWrap> req_wrap {
+      static_cast<GetAddrInfoReqWrap*>(req->data)};
+
+  std::vector<std::string> addresses;
+  if (status == 0) {
+    for (auto p = res; p != nullptr; p = p->ai_next) {
+      CHECK_EQ(p->ai_socktype, SOCK_STREAM);
+
+      const char* addr;
+      if (p->ai_family == AF_INET) {
+        addr = reinterpret_cast<char*>(
+            &(reinterpret_cast<struct sockaddr_in*>(p->ai_addr)->sin_addr));
+      } else if (p->ai_family == AF_INET6) {
+        addr = reinterpret_cast<char*>(
+            &(reinterpret_cast<struct sockaddr_in6*>(p->ai_addr)->sin6_addr));
+      } else {
+        continue;
+      }
+
+      char ip[INET6_ADDRSTRLEN];
+      if (uv_inet_ntop(p->ai_family, addr, ip, sizeof(ip)))
+        continue;
+
+      addresses.emplace_back(ip);
+    }
+  }
+
+  uv_freeaddrinfo(res);
+
+  if (req_wrap->cache_key().empty())
+    return FinishGetAddrInfo(std::move(req_wrap), status, addresses);
+
+  // getaddrinfo() does not tell how long its results are valid for.
+  uint32_t ttl = 0;
+  if (status == 0 && !addresses.empty())
+    ttl = per_process::cli_options->dns_cache_lookup_ttl;
+  else if (status == UV_EAI_NONAME || status == UV_EAI_NODATA)
+    ttl = per_process::cli_options->dns_cache_negative_ttl;
+  DNSCache::Entry entry;
+  entry.status = status;
+  entry.addresses = addresses;
+  dns_cache.Put(req_wrap->cache_key(), std::move(entry), ttl);
+
+  DNSCache::PendingLookups waiting =
+      dns_cache.FinishLookup(req_wrap->env(), req_wrap->cache_key());
+  FinishGetAddrInfo(std::move(req_wrap), status, addresses);
+  for (std::unique_ptr<GetAddrInfoReqWrap>& waiter : waiting)
+    FinishGetAddrInfo(std::move(waiter), status, addresses);
+}
+
+
 void AfterGetNameInfo(uv_getnameinfo_t* req,
                       int status,
                       const char* hostname,
@@ -1981,14 +2305,44 @@ void GetAddrInfo(const FunctionCallbackInfo<Value>& args) {
       "family",
       family == AF_INET ? "ipv4" : family == AF_INET6 ? "ipv6" : "unspec");
 
+  if (dns_cache.enabled()) {
+    std::string key = "lookup:" + std::to_string(family) + ":" +
+                      std::to_string(flags) + ":" + hostname.out();
+    DNSCache::Entry entry;
+    if (dns_cache.Get(key, &entry)) {
+      struct CachedLookup {
+        std::unique_ptr<GetAddrInfoReqWrap> req_wrap;
+        DNSCache::Entry entry;
+      };
+      CachedLookup* lookup = new CachedLookup {
+        std::move(req_wrap), std::move(entry)
+      };
+      env->SetImmediate([](Environment* env, void* data) {
+        std::unique_ptr<CachedLookup> lookup {
+            static_cast<CachedLookup*>(data)};
+        FinishGetAddrInfo(std::move(lookup->req_wrap),
+                          lookup->entry.status,
+                          lookup->entry.addresses);
+      }, lookup, req_wrap_obj);
+      return args.GetReturnValue().Set(0);
+    }
+    if (dns_cache.JoinLookup(key, &req_wrap))
+      return args.GetReturnValue().Set(0);
+    req_wrap->set_cache_key(std::move(key));
+  }
+
   int err = req_wrap->Dispatch(uv_getaddrinfo,
                                AfterGetAddrInfo,
                                *hostname,
                                nullptr,
                                &hints);
-  if (err == 0)
+  if (err == 0) {
     // Release ownership of the pointer allowing the ownership to be transferred
     USE(req_wrap.release());
+  } else if (!req_wrap->cache_key().empty()) {
+    // Nothing can have joined the call yet.
+    CHECK(dns_cache.FinishLookup(env, req_wrap->cache_key()).empty());
+  }
 
   args.GetReturnValue().Set(err);
 }
@@ -2079,11 +2433,14 @@ void SetServers(const FunctionCallbackInfo<Value>& args) {
 
   if (len == 0) {
     int rv = ares_set_servers(channel->cares_channel(), nullptr);
+    if (rv == ARES_SUCCESS)
+      channel->set_servers_key("none");
     return args.GetReturnValue().Set(rv);
   }
 
   std::vector<ares_addr_port_node> servers(len);
   ares_addr_port_node* last = nullptr;
+  std::string servers_key;
 
   int err;
 
@@ -2125,6 +2482,7 @@ void SetServers(const FunctionCallbackInfo<Value>& args) {
     if (err)
       break;
 
+    servers_key += "[" + std::string(*ip) + "]:" + std::to_string(port) + ",";
     cur->next = nullptr;
 
     if (last != nullptr)
@@ -2138,8 +2496,10 @@ void SetServers(const FunctionCallbackInfo<Value>& args) {
   else
     err = ARES_EBADSTR;
 
-  if (err == ARES_SUCCESS)
+  if (err == ARES_SUCCESS) {
     channel->set_is_servers_default(false);
+    channel->set_servers_key(std::move(servers_key));
+  }
 
   args.GetReturnValue().Set(err);
 }
@@ -2154,6 +2514,20 @@ void Cancel(const FunctionCallbackInfo<Value>& args) {
   ares_cancel(channel->cares_channel());
 }
 
+void GetCacheStatistics(const FunctionCallbackInfo<Value>& args) {
+  // Get the double array pointer from the Float64Array argument.
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), DNSCache::kStatCount);
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = static_cast<double*>(ab->GetContents().Data());
+  dns_cache.GetStats(fields);
+}
+
+void ClearCache(const FunctionCallbackInfo<Value>& args) {
+  dns_cache.Clear();
+}
+
 const char EMSG_ESETSRVPENDING[] = "There are pending queries.";
 void StrError(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -2176,6 +2550,8 @@ void Initialize(Local<Object> target,
   env->SetMethodNoSideEffect(target, "canonicalizeIP", CanonicalizeIP);
 
   env->SetMethod(target, "strerror", StrError);
+  env->SetMethod(target, "getCacheStatistics", GetCacheStatistics);
+  env->SetMethod(target, "clearCache", ClearCache);
 
   target->Set(env->context(), FIXED_ONE_BYTE_STRING(env->isolate(), "AF_INET"),
               Integer::New(env->isolate(), AF_INET)).Check();
@@ -10,10 +10,12 @@
 
 namespace node {
 
+using v8::Array;
 using v8::Boolean;
 using v8::Context;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::Object;
 using v8::Value;
@@ -46,6 +48,16 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
 
   Local<Value> client_handle;
 
+  if (status == 0 && wrap_data->accept_batch_size_ > 1 &&
+      wrap_data->pending_connections_.size() >=
+          wrap_data->accept_batch_size_) {
+    // libuv has already accepted the connection into the server's
+    // accepted_fd, but stops polling the server until DeliverConnections()
+    // calls uv_accept() to take it over.
+    wrap_data->accept_deferred_ = true;
+    return;
+  }
+
   if (status == 0) {
     // Instantiate the client javascript object and handle.
     Local<Object> client_obj;
@@ -63,9 +75,23 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
     if (uv_accept(handle, client))
       return;
 
+    if (wrap_data->accept_batch_size_ > 1) {
+      wrap_data->pending_connections_.emplace_back(env->isolate(), client_obj);
+      if (wrap_data->pending_connections_.size() == 1) {
+        env->SetImmediate([](Environment* env, void* data) {
+          static_cast<WrapType*>(data)->DeliverConnections();
+        }, wrap_data, wrap_data->object());
+      }
+      return;
+    }
+
     // Successful accept. Call the onconnection callback in JavaScript land.
     client_handle = client_obj;
   } else {
+    // Keep the connections that were accepted before the error in order.
+    wrap_data->DeliverConnections();
+    if (!HandleWrap::IsAlive(wrap_data))
+      return;
     client_handle = Undefined(env->isolate());
   }
 
@@ -74,6 +100,44 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
 }
 
 
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::DeliverConnections() {
+  if (pending_connections_.empty())
+    return;
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env()->context());
+
+  std::vector<Local<Value>> clients;
+  clients.reserve(pending_connections_.size());
+  for (v8::Global<Object>& client : pending_connections_)
+    clients.push_back(client.Get(isolate));
+  pending_connections_.clear();
+
+  if (IsHandleClosing()) {
+    // The server was closed in the meantime.
+    for (Local<Value> client : clients) {
+      WrapType* wrap = Unwrap<WrapType>(client.As<Object>());
+      if (wrap != nullptr)
+        wrap->Close();
+    }
+    return;
+  }
+
+  Local<Value> argv[] = {
+    Integer::New(isolate, 0),
+    Array::New(isolate, clients.data(), clients.size())
+  };
+  MakeCallback(env()->onconnection_string(), arraysize(argv), argv);
+
+  if (accept_deferred_ && !IsHandleClosing()) {
+    accept_deferred_ = false;
+    OnConnection(reinterpret_cast<uv_stream_t*>(&handle_), 0);
+  }
+}
+
+
 template <typename WrapType, typename UVType>
 void ConnectionWrap<WrapType, UVType>::AfterConnect(uv_connect_t* req,
                                                     int status) {
@@ -7,6 +7,8 @@
 #include "stream_wrap.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 
 template <typename WrapType, typename UVType>
@@ -20,7 +22,20 @@ class ConnectionWrap : public LibuvStreamWrap {
                  v8::Local<v8::Object> object,
                  ProviderType provider);
 
+  // Hands the connections accepted so far to JS in a single onconnection
+  // call, and then takes over the connection that libuv accepted while the
+  // batch was full, if any.
+  void DeliverConnections();
+
   UVType handle_;
+  // With a batch size larger than 1, accepted connections are collected and
+  // handed to JS as an array once the current poll phase is over, and no
+  // more than that many connections are accepted per loop iteration.
+  size_t accept_batch_size_ = 1;
+
+ private:
+  std::vector<v8::Global<v8::Object>> pending_connections_;
+  bool accept_deferred_ = false;
 };
 
 }  // namespace node
@@ -185,6 +185,14 @@ inline void AsyncHooks::clear_async_id_stack() {
   fields_[kStackLength] = 0;
 }
 
+inline bool AsyncHooks::promise_tracking_enabled() const {
+  return promise_tracking_enabled_;
+}
+
+inline void AsyncHooks::set_promise_tracking_enabled(bool enabled) {
+  promise_tracking_enabled_ = enabled;
+}
+
 // The DefaultTriggerAsyncIdScope(AsyncWrap*) constructor is defined in
 // async_wrap-inl.h to avoid a circular dependency.
 
@@ -448,6 +456,14 @@ inline uint64_t Environment::timer_base() const {
   return timer_base_;
 }
 
+inline TimerWheel* Environment::timer_wheel() {
+  return &timer_wheel_;
+}
+
+inline AliasedUint32Array& Environment::expired_timers() {
+  return expired_timers_;
+}
+
 inline std::shared_ptr<KVStore> Environment::env_vars() {
   return env_vars_;
 }
@@ -623,6 +639,10 @@ Environment::file_handle_read_wrap_freelist() {
   return file_handle_read_wrap_freelist_;
 }
 
+inline ReadBufferPool* Environment::read_buffer_pool() {
+  return &read_buffer_pool_;
+}
+
 inline std::shared_ptr<EnvironmentOptions> Environment::options() {
   return options_;
 }
@@ -833,6 +853,16 @@ inline performance::performance_state* Environment::performance_state() {
   return performance_state_.get();
 }
 
+inline performance::LoopPhaseProfiler* Environment::loop_phase_profiler()
+    const {
+  return loop_phase_profiler_;
+}
+
+inline void Environment::set_loop_phase_profiler(
+    performance::LoopPhaseProfiler* profiler) {
+  loop_phase_profiler_ = profiler;
+}
+
 inline std::unordered_map<std::string, uint64_t>*
     Environment::performance_marks() {
   return &performance_marks_;
@@ -942,6 +972,32 @@ inline v8::Local<v8::ArrayBuffer> AllocatedBuffer::ToArrayBuffer() {
                               v8::ArrayBufferCreationMode::kInternalized);
 }
 
+inline bool ReadBufferPool::IsDetached() const {
+  return !array_buffer_.IsEmpty() &&
+         array_buffer_.Get(env_->isolate())->ByteLength() == 0;
+}
+
+inline bool ReadBufferPool::Owns(const uv_buf_t& buf) const {
+  return lent_ && buf.base >= data_ && buf.base < data_ + size_;
+}
+
+inline void ReadBufferPool::Release(const uv_buf_t& buf) {
+  CHECK(Owns(buf));
+  lent_ = false;
+}
+
+inline uint64_t ReadBufferPool::hits() const {
+  return hits_;
+}
+
+inline uint64_t ReadBufferPool::misses() const {
+  return misses_;
+}
+
+inline uint64_t ReadBufferPool::slabs() const {
+  return slabs_;
+}
+
 inline void Environment::ThrowError(const char* errmsg) {
   ThrowError(v8::Exception::Error, errmsg);
 }
@@ -9,6 +9,7 @@
 #include "node_internals.h"
 #include "node_native_module.h"
 #include "node_options-inl.h"
+#include "node_perf.h"
 #include "node_process.h"
 #include "node_v8_platform-inl.h"
 #include "node_worker.h"
@@ -272,6 +273,7 @@ Environment::Environment(IsolateData* isolate_data,
       immediate_info_(context->GetIsolate()),
       tick_info_(context->GetIsolate()),
       timer_base_(uv_now(isolate_data->event_loop())),
+      expired_timers_(isolate_, kExpiredTimersBatchSize),
       exec_argv_(exec_args),
       argv_(args),
       should_abort_on_uncaught_toggle_(isolate_, 1),
@@ -280,6 +282,7 @@ Environment::Environment(IsolateData* isolate_data,
       thread_id_(thread_id == kNoThreadId ? AllocateThreadId() : thread_id),
       fs_stats_field_array_(isolate_, kFsStatsBufferLength),
       fs_stats_field_bigint_array_(isolate_, kFsStatsBufferLength),
+      read_buffer_pool_(this),
       context_(context->GetIsolate(), context) {
   // We'll be creating new objects so make sure we've entered the context.
   HandleScope handle_scope(isolate());
@@ -661,9 +664,17 @@ void Environment::RunAndClearNativeImmediates() {
 
 void Environment::ScheduleTimer(int64_t duration_ms) {
   if (started_cleanup_) return;
+  timer_wakeup_ = uv_now(event_loop()) - timer_base() + duration_ms;
   uv_timer_start(timer_handle(), RunTimers, duration_ms, 0);
 }
 
+void Environment::ScheduleTimerAt(int64_t expiry_ms) {
+  if (timer_wakeup_ != -1 && timer_wakeup_ <= expiry_ms)
+    return;
+  int64_t duration_ms = expiry_ms - (uv_now(event_loop()) - timer_base());
+  ScheduleTimer(duration_ms > 0 ? duration_ms : 1);
+}
+
 void Environment::ToggleTimerRef(bool ref) {
   if (started_cleanup_) return;
 
@@ -678,68 +689,67 @@ void Environment::RunTimers(uv_timer_t* handle) {
   Environment* env = Environment::from_timer_handle(handle);
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "RunTimers", env);
+  performance::LoopPhaseScope phase_scope(
+      env, performance::NODE_PERFORMANCE_LOOP_PHASE_TIMERS);
 
+  env->timer_wakeup_ = -1;
   if (!env->can_call_into_js())
     return;
 
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
-  Local<Object> process = env->process_object();
-  InternalCallbackScope scope(env, process, {0, 0});
-
-  Local<Function> cb = env->timers_callback_function();
-  MaybeLocal<Value> ret;
   Local<Value> arg = env->GetNow();
-  // This code will loop until all currently due timers will process. It is
-  // impossible for us to end up in an infinite loop due to how the JS-side
-  // is structured.
-  do {
-    TryCatchScope try_catch(env);
-    try_catch.SetVerbose(true);
-    ret = cb->Call(env->context(), process, 1, &arg);
-  } while (ret.IsEmpty() && env->can_call_into_js());
-
-  // NOTE(apapirovski): If it ever becomes possible that `call_into_js` above
-  // is reset back to `true` after being previously set to `false` then this
-  // code becomes invalid and needs to be rewritten. Otherwise catastrophic
-  // timers corruption will occur and all timers behaviour will become
-  // entirely unpredictable.
-  if (ret.IsEmpty())
-    return;
-
-  // To allow for less JS-C++ boundary crossing, the value returned from JS
-  // serves a few purposes:
-  // 1. If it's 0, no more timers exist and the handle should be unrefed
-  // 2. If it's > 0, the value represents the next timer's expiry and there
-  //    is at least one timer remaining that is refed.
-  // 3. If it's < 0, the absolute value represents the next timer's expiry
-  //    and there are no timers that are refed.
-  int64_t expiry_ms =
-      ret.ToLocalChecked()->IntegerValue(env->context()).FromJust();
-
+  TimerWheel* wheel = env->timer_wheel();
+  wheel->Advance(arg->IntegerValue(env->context()).FromJust());
   uv_handle_t* h = reinterpret_cast<uv_handle_t*>(handle);
 
-  if (expiry_ms != 0) {
-    int64_t duration_ms =
-        llabs(expiry_ms) - (uv_now(env->event_loop()) - env->timer_base());
-
-    env->ScheduleTimer(duration_ms > 0 ? duration_ms : 1);
-
-    if (expiry_ms > 0)
+  // The wheel wakes up early when one of its coarser slots has to be
+  // redistributed, there is no need to call into JS for that.
+  if (wheel->has_expired()) {
+    Local<Object> process = env->process_object();
+    InternalCallbackScope scope(env, process, {0, 0});
+
+    Local<Function> cb = env->timers_callback_function();
+    MaybeLocal<Value> ret;
+    // This code will loop until all currently due timers will process. It is
+    // impossible for us to end up in an infinite loop due to how the JS-side
+    // is structured.
+    do {
+      TryCatchScope try_catch(env);
+      try_catch.SetVerbose(true);
+      ret = cb->Call(env->context(), process, 1, &arg);
+    } while (ret.IsEmpty() && env->can_call_into_js());
+
+    // NOTE(apapirovski): If it ever becomes possible that `call_into_js`
+    // above is reset back to `true` after being previously set to `false`
+    // then this code becomes invalid and needs to be rewritten. Otherwise
+    // catastrophic timers corruption will occur and all timers behaviour will
+    // become entirely unpredictable.
+    if (ret.IsEmpty())
+      return;
+
+    // The value returned from JS is > 0 if at least one of the remaining
+    // timers is refed, and < 0 otherwise.
+    if (ret.ToLocalChecked()->IntegerValue(env->context()).FromJust() > 0)
       uv_ref(h);
     else
       uv_unref(h);
-  } else {
-    uv_unref(h);
   }
-}
 
+  int64_t expiry_ms = wheel->NextWakeup();
+  if (expiry_ms != -1)
+    env->ScheduleTimerAt(expiry_ms);
+  else
+    uv_unref(h);
+}
 
 void Environment::CheckImmediate(uv_check_t* handle) {
   Environment* env = Environment::from_immediate_check_handle(handle);
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "CheckImmediate", env);
+  performance::LoopPhaseScope phase_scope(
+      env, performance::NODE_PERFORMANCE_LOOP_PHASE_CHECK);
 
   if (env->immediate_info()->count() == 0)
     return;
@@ -959,6 +969,7 @@ inline size_t Environment::SelfSize() const {
   size -= sizeof(async_hooks_);
   size -= sizeof(tick_info_);
   size -= sizeof(immediate_info_);
+  size -= sizeof(expired_timers_);
   return size;
 }
 
@@ -982,6 +993,8 @@ void Environment::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("async_hooks", async_hooks_);
   tracker->TrackField("immediate_info", immediate_info_);
   tracker->TrackField("tick_info", tick_info_);
+  tracker->TrackField("expired_timers", expired_timers_);
+  tracker->TrackField("read_buffer_pool", read_buffer_pool_);
 
 #define V(PropertyName, TypeName)                                              \
   tracker->TrackField(#PropertyName, PropertyName());
@@ -1050,6 +1063,89 @@ AsyncRequest::~AsyncRequest() {
   CHECK_NULL(async_);
 }
 
+ReadBufferPool::ReadBufferPool(Environment* env) : env_(env) {}
+
+ReadBufferPool::~ReadBufferPool() {
+  if (array_buffer_.IsEmpty())
+    free(data_);
+}
+
+uv_buf_t ReadBufferPool::Allocate(size_t suggested_size) {
+  if (lent_) {
+    // Another read is still in progress (e.g. an fs read on the threadpool).
+    misses_++;
+    return env_->AllocateManaged(suggested_size).release();
+  }
+
+  size_t available = size_ - used_;
+  if (data_ == nullptr ||
+      available < std::min(suggested_size, kMinChunkSize) ||
+      IsDetached()) {
+    // Start a new slab. The previous one, if it has been exposed to JS,
+    // stays alive for as long as slices of it are referenced from JS.
+    if (array_buffer_.IsEmpty())
+      free(data_);
+    array_buffer_.Reset();
+    data_ = Malloc(kSlabSize);
+    size_ = kSlabSize;
+    used_ = 0;
+    available = size_;
+    misses_++;
+    slabs_++;
+  } else {
+    hits_++;
+  }
+
+  lent_ = true;
+  return uv_buf_init(data_ + used_,
+                     static_cast<unsigned int>(
+                         std::min(suggested_size, available)));
+}
+
+Local<ArrayBuffer> ReadBufferPool::Commit(const uv_buf_t& buf,
+                                          size_t nread,
+                                          size_t* offset) {
+  CHECK(Owns(buf));
+  CHECK_LE(nread, buf.len);
+  lent_ = false;
+  Isolate* isolate = env_->isolate();
+
+  if (IsDetached()) {
+    // The slab was detached, e.g. by an addon, while the read was pending.
+    // Its memory is still alive, so the data can be copied out of it.
+    AllocatedBuffer copy = env_->AllocateManaged(nread);
+    memcpy(copy.data(), buf.base, nread);
+    array_buffer_.Reset();
+    data_ = nullptr;
+    size_ = used_ = 0;
+    *offset = 0;
+    return copy.ToArrayBuffer();
+  }
+
+  if (array_buffer_.IsEmpty()) {
+    Local<Object> obj;
+    if (!Buffer::New(env_, data_, size_,
+                     [](char* data, void* hint) { free(data); },
+                     nullptr).ToLocal(&obj)) {
+      // The slab has been freed.
+      data_ = nullptr;
+      size_ = used_ = 0;
+      *offset = 0;
+      return Local<ArrayBuffer>();
+    }
+    array_buffer_.Reset(isolate, obj.As<v8::Uint8Array>()->Buffer());
+  }
+
+  *offset = buf.base - data_;
+  // Keep the next chunk 8-byte aligned, like the JS Buffer pool does.
+  used_ = std::min(RoundUp<size_t>(*offset + nread, 8), size_);
+  return array_buffer_.Get(isolate);
+}
+
+void ReadBufferPool::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("slab", size_);
+}
+
 // Not really any better place than env.cc at this moment.
 void BaseObject::DeleteMe(void* data) {
   BaseObject* self = static_cast<BaseObject*>(data);
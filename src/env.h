@@ -36,6 +36,7 @@
 #include "node_main_instance.h"
 #include "node_options.h"
 #include "req_wrap.h"
+#include "timer_wheel.h"
 #include "util.h"
 #include "uv.h"
 #include "v8.h"
@@ -62,6 +63,7 @@ class FileHandleReadWrap;
 }
 
 namespace performance {
+class LoopPhaseProfiler;
 class performance_state;
 }
 
@@ -124,11 +126,14 @@ constexpr size_t kFsStatsBufferLength = kFsStatsFieldsNumber * 2;
 #define PER_ISOLATE_PRIVATE_SYMBOL_PROPERTIES(V)                              \
   V(alpn_buffer_private_symbol, "node:alpnBuffer")                            \
   V(arrow_message_private_symbol, "node:arrowMessage")                        \
+  V(context_frame_private_symbol, "node:contextFrame")                        \
   V(contextify_context_private_symbol, "node:contextify:context")             \
   V(contextify_global_private_symbol, "node:contextify:global")               \
   V(decorated_private_symbol, "node:decorated")                               \
   V(napi_env, "node:napi:env")                                                \
   V(napi_wrapper, "node:napi:wrapper")                                        \
+  V(promise_async_id_private_symbol, "node:promiseAsyncId")                   \
+  V(promise_trigger_async_id_private_symbol, "node:promiseTriggerAsyncId")    \
   V(sab_lifetimepartner_symbol, "node:sharedArrayBufferLifetimePartner")      \
 
 // Symbols are per-isolate primitives but Environment proxies them
@@ -376,6 +381,7 @@ constexpr size_t kFsStatsBufferLength = kFsStatsFieldsNumber * 2;
 
 #define ENVIRONMENT_STRONG_PERSISTENT_VALUES(V)                                \
   V(as_callback_data, v8::Object)                                              \
+  V(async_context_frame, v8::Array)                                            \
   V(async_hooks_after_function, v8::Function)                                  \
   V(async_hooks_before_function, v8::Function)                                 \
   V(async_hooks_binding, v8::Object)                                           \
@@ -546,6 +552,65 @@ struct AllocatedBuffer {
   friend class Environment;
 };
 
+// A per-Environment slab from which stream reads are served. Instead of
+// allocating (and then shrinking) a fresh chunk of memory for every read,
+// reads land in a shared slab and JS receives slices of a single ArrayBuffer
+// that backs it, similar to the pool used by `Buffer.allocUnsafe()`.
+// Only one chunk can be lent out at a time; if a second read is started
+// before the first one is finished, it falls back to a regular allocation.
+class ReadBufferPool : public MemoryRetainer {
+ public:
+  static constexpr size_t kSlabSize = 128 * 1024;
+  // Chunks smaller than this are not handed out; a new slab is started
+  // instead, so that the number of read syscalls stays reasonable.
+  static constexpr size_t kMinChunkSize = 8 * 1024;
+
+  explicit ReadBufferPool(Environment* env);
+  ~ReadBufferPool();
+
+  // Returns a chunk of at most `suggested_size` bytes.
+  uv_buf_t Allocate(size_t suggested_size);
+  // Returns true if `buf` has been returned by `Allocate()` and points into
+  // the current slab. Such buffers must not be freed by the caller.
+  inline bool Owns(const uv_buf_t& buf) const;
+  // Marks the first `nread` bytes of the lent-out chunk `buf` as used and
+  // returns the ArrayBuffer backing the slab. `*offset` is set to the
+  // offset of `buf.base` within that ArrayBuffer. Returns an empty handle if
+  // an exception is pending.
+  v8::Local<v8::ArrayBuffer> Commit(const uv_buf_t& buf,
+                                    size_t nread,
+                                    size_t* offset);
+  // Returns the lent-out chunk `buf` to the pool without using it.
+  inline void Release(const uv_buf_t& buf);
+
+  inline uint64_t hits() const;
+  inline uint64_t misses() const;
+  inline uint64_t slabs() const;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(ReadBufferPool)
+  SET_SELF_SIZE(ReadBufferPool)
+
+ private:
+  // Returns true if the slab has been exposed to JS and detached since.
+  inline bool IsDetached() const;
+
+  Environment* env_;
+  // The pool owns the slab until it is first exposed to JS; afterwards, it is
+  // freed once `array_buffer_` is garbage collected. `array_buffer_` is an
+  // external ArrayBuffer, so that postMessage() copies it instead of taking
+  // over its memory, which the pool may still be reading into.
+  v8::Global<v8::ArrayBuffer> array_buffer_;
+  char* data_ = nullptr;
+  size_t size_ = 0;
+  size_t used_ = 0;
+  bool lent_ = false;
+
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t slabs_ = 0;
+};
+
 class AsyncRequest : public MemoryRetainer {
  public:
   AsyncRequest() = default;
@@ -608,6 +673,7 @@ class AsyncHooks : public MemoryRetainer {
     kTotals,
     kCheck,
     kStackLength,
+    kContextFrames,
     kFieldsCount,
   };
 
@@ -632,6 +698,12 @@ class AsyncHooks : public MemoryRetainer {
   inline bool pop_async_id(double async_id);
   inline void clear_async_id_stack();  // Used in fatal exceptions.
 
+  // Whether the PromiseHook should track promises for async_hooks, i.e.
+  // whether any hooks are enabled. It may also be installed for
+  // AsyncLocalStorage, which is tracked by fields_[kContextFrames].
+  inline bool promise_tracking_enabled() const;
+  inline void set_promise_tracking_enabled(bool enabled);
+
   AsyncHooks(const AsyncHooks&) = delete;
   AsyncHooks& operator=(const AsyncHooks&) = delete;
 
@@ -666,6 +738,7 @@ class AsyncHooks : public MemoryRetainer {
   AliasedUint32Array fields_;
   // Attached to a Float64Array that tracks the state of async resources.
   AliasedFloat64Array async_id_fields_;
+  bool promise_tracking_enabled_ = false;
 
   void grow_async_ids_stack();
 };
@@ -901,6 +974,11 @@ class Environment : public MemoryRetainer {
   inline ImmediateInfo* immediate_info();
   inline TickInfo* tick_info();
   inline uint64_t timer_base() const;
+  // Orders the timer lists of lib/internal/timers.js by expiry. Lists whose
+  // expiry has passed are handed to JS through expired_timers(), in batches.
+  inline TimerWheel* timer_wheel();
+  inline AliasedUint32Array& expired_timers();
+  static constexpr size_t kExpiredTimersBatchSize = 256;
   inline std::shared_ptr<KVStore> env_vars();
   inline void set_env_vars(std::shared_ptr<KVStore> env_vars);
 
@@ -982,7 +1060,12 @@ class Environment : public MemoryRetainer {
   inline std::vector<std::unique_ptr<fs::FileHandleReadWrap>>&
       file_handle_read_wrap_freelist();
 
+  inline ReadBufferPool* read_buffer_pool();
+
   inline performance::performance_state* performance_state();
+  inline performance::LoopPhaseProfiler* loop_phase_profiler() const;
+  inline void set_loop_phase_profiler(
+      performance::LoopPhaseProfiler* profiler);
   inline std::unordered_map<std::string, uint64_t>* performance_marks();
 
   void CollectUVExceptionInfo(v8::Local<v8::Value> context,
@@ -1134,6 +1217,9 @@ class Environment : public MemoryRetainer {
 
   v8::Local<v8::Value> GetNow();
   void ScheduleTimer(int64_t duration);
+  // Makes sure that RunTimers() runs no later than |expiry|, which is relative
+  // to timer_base().
+  void ScheduleTimerAt(int64_t expiry);
   void ToggleTimerRef(bool ref);
 
   inline void AddCleanupHook(void (*fn)(void*), void* arg);
@@ -1208,6 +1294,10 @@ class Environment : public MemoryRetainer {
   ImmediateInfo immediate_info_;
   TickInfo tick_info_;
   const uint64_t timer_base_;
+  TimerWheel timer_wheel_;
+  AliasedUint32Array expired_timers_;
+  // When the timer handle is due, relative to timer_base_, or -1.
+  int64_t timer_wakeup_ = -1;
   std::shared_ptr<KVStore> env_vars_;
   bool printed_error_ = false;
   bool emit_env_nonstring_warning_ = true;
@@ -1252,6 +1342,7 @@ class Environment : public MemoryRetainer {
   AliasedInt32Array stream_base_state_;
 
   std::unique_ptr<performance::performance_state> performance_state_;
+  performance::LoopPhaseProfiler* loop_phase_profiler_ = nullptr;
   std::unordered_map<std::string, uint64_t> performance_marks_;
 
   bool has_run_bootstrapping_code_ = false;
@@ -1298,6 +1389,8 @@ class Environment : public MemoryRetainer {
   std::vector<std::unique_ptr<fs::FileHandleReadWrap>>
       file_handle_read_wrap_freelist_;
 
+  ReadBufferPool read_buffer_pool_;
+
   worker::Worker* worker_context_ = nullptr;
 
   static void RunTimers(uv_timer_t* handle);
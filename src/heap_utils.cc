@@ -1,19 +1,29 @@
 #include "diagnosticfilename-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_buffer.h"
+#include "node_internals.h"
+#include "node_pprof.h"
 #include "stream_base-inl.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
+#include "zlib.h"
 
+#include <fcntl.h>
+
+using v8::AllocationProfile;
 using v8::Array;
 using v8::Boolean;
 using v8::Context;
 using v8::EmbedderGraph;
 using v8::EscapableHandleScope;
 using v8::FunctionCallbackInfo;
+using v8::Function;
 using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
 using v8::HeapSnapshot;
+using v8::Int32;
 using v8::Isolate;
 using v8::JSON;
 using v8::Local;
@@ -22,6 +32,7 @@ using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 namespace node {
@@ -205,9 +216,11 @@ void BuildEmbedderGraph(const FunctionCallbackInfo<Value>& args) {
 }
 
 namespace {
-class FileOutputStream : public v8::OutputStream {
+// Writes the serialized snapshot to a file descriptor as V8 produces it, so
+// that only one chunk is held in memory at a time.
+class FdOutputStream : public v8::OutputStream {
  public:
-  explicit FileOutputStream(FILE* stream) : stream_(stream) {}
+  explicit FdOutputStream(uv_file fd) : fd_(fd) {}
 
   int GetChunkSize() override {
     return 65536;  // big chunks == faster
@@ -216,19 +229,110 @@ class FileOutputStream : public v8::OutputStream {
   void EndOfStream() override {}
 
   WriteResult WriteAsciiChunk(char* data, int size) override {
-    const size_t len = static_cast<size_t>(size);
-    size_t off = 0;
+    while (size > 0) {
+      uv_fs_t req;
+      uv_buf_t buf = uv_buf_init(data, size);
+      int written = uv_fs_write(nullptr, &req, fd_, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (written < 0) {
+        error_ = written;
+        return kAbort;
+      }
+      data += written;
+      size -= written;
+    }
+    return kContinue;
+  }
+
+  int error() const { return error_; }
+
+ private:
+  uv_file fd_;
+  int error_ = 0;
+};
+
+// Compresses the serialized snapshot with gzip and passes the compressed
+// chunks on to another stream.
+class GzipOutputStream : public v8::OutputStream {
+ public:
+  explicit GzipOutputStream(v8::OutputStream* out)
+      : out_(out), buffer_(out->GetChunkSize()) {
+    memset(&strm_, 0, sizeof(strm_));
+    // A window of 15 bits plus 16 selects the gzip format.
+    CHECK_EQ(deflateInit2(&strm_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16,
+                          8, Z_DEFAULT_STRATEGY),
+             Z_OK);
+  }
+
+  ~GzipOutputStream() override {
+    deflateEnd(&strm_);
+  }
+
+  int GetChunkSize() override {
+    return out_->GetChunkSize();
+  }
 
-    while (off < len && !feof(stream_) && !ferror(stream_))
-      off += fwrite(data + off, 1, len - off, stream_);
+  void EndOfStream() override {
+    if (Deflate(nullptr, 0, Z_FINISH) == kContinue)
+      out_->EndOfStream();
+  }
 
-    return off == len ? kContinue : kAbort;
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    return Deflate(data, size, Z_NO_FLUSH);
   }
 
  private:
-  FILE* stream_;
+  WriteResult Deflate(char* data, int size, int flush) {
+    strm_.next_in = reinterpret_cast<Bytef*>(data);
+    strm_.avail_in = size;
+    do {
+      strm_.next_out = reinterpret_cast<Bytef*>(buffer_.data());
+      strm_.avail_out = buffer_.size();
+      CHECK_NE(deflate(&strm_, flush), Z_STREAM_ERROR);
+      int have = buffer_.size() - strm_.avail_out;
+      if (have > 0 && out_->WriteAsciiChunk(buffer_.data(), have) == kAbort)
+        return kAbort;
+    } while (strm_.avail_out == 0);
+    return kContinue;
+  }
+
+  v8::OutputStream* out_;
+  std::vector<char> buffer_;
+  z_stream strm_;
 };
 
+// Returns 0 or a libuv error code.
+int SerializeSnapshot(const HeapSnapshot* snapshot,
+                      uv_file fd,
+                      bool compress) {
+  FdOutputStream out(fd);
+  if (compress) {
+    GzipOutputStream gzip(&out);
+    snapshot->Serialize(&gzip, HeapSnapshot::kJSON);
+  } else {
+    snapshot->Serialize(&out, HeapSnapshot::kJSON);
+  }
+  return out.error();
+}
+
+uv_file OpenSnapshotFile(const char* filename) {
+  uv_fs_t req;
+  int fd = uv_fs_open(nullptr,
+                      &req,
+                      filename,
+                      O_WRONLY | O_CREAT | O_TRUNC,
+                      0666,
+                      nullptr);
+  uv_fs_req_cleanup(&req);
+  return fd;
+}
+
+void CloseSnapshotFile(uv_file fd) {
+  uv_fs_t req;
+  uv_fs_close(nullptr, &req, fd, nullptr);
+  uv_fs_req_cleanup(&req);
+}
+
 class HeapSnapshotStream : public AsyncWrap,
                            public StreamBase,
                            public v8::OutputStream {
@@ -260,14 +364,14 @@ class HeapSnapshotStream : public AsyncWrap,
   WriteResult WriteAsciiChunk(char* data, int size) override {
     int len = size;
     while (len != 0) {
-      uv_buf_t buf = EmitAlloc(size);
+      uv_buf_t buf = EmitAlloc(len);
       ssize_t avail = len;
       if (static_cast<ssize_t>(buf.len) < avail)
         avail = buf.len;
       memcpy(buf.base, data, avail);
       data += avail;
       len -= avail;
-      EmitRead(size, buf);
+      EmitRead(avail, buf);
     }
     return kContinue;
   }
@@ -319,25 +423,268 @@ class HeapSnapshotStream : public AsyncWrap,
   const HeapSnapshot* snapshot_;
 };
 
-inline void TakeSnapshot(Isolate* isolate, v8::OutputStream* out) {
+inline int TakeSnapshot(Isolate* isolate, uv_file fd, bool compress) {
   const HeapSnapshot* const snapshot =
       isolate->GetHeapProfiler()->TakeHeapSnapshot();
-  snapshot->Serialize(out, HeapSnapshot::kJSON);
+  int err = SerializeSnapshot(snapshot, fd, compress);
   const_cast<HeapSnapshot*>(snapshot)->Delete();
+  return err;
 }
 
-inline bool WriteSnapshot(Isolate* isolate, const char* filename) {
-  FILE* fp = fopen(filename, "w");
-  if (fp == nullptr)
+// Returns a libuv error code, and sets |*syscall| to the call that failed.
+inline int WriteSnapshot(Isolate* isolate,
+                         const char* filename,
+                         bool compress,
+                         const char** syscall) {
+  uv_file fd = OpenSnapshotFile(filename);
+  if (fd < 0) {
+    *syscall = "open";
+    return fd;
+  }
+  int err = TakeSnapshot(isolate, fd, compress);
+  CloseSnapshotFile(fd);
+  *syscall = "write";
+  return err;
+}
+
+// Serializing a snapshot reads the snapshot itself, but also the state of
+// the heap profiler's allocation tracker, which is modified on the main thread
+// while heap objects are tracked. That happens with --track-heap-objects or
+// through the inspector, so serialization only moves off the main thread
+// when neither of them is in use. The inspector also waits for background
+// serialization to finish before it starts tracking, see
+// WaitForBackgroundSnapshotWrites().
+inline bool CanSerializeInBackground(Environment* env) {
+  if (env->isolate_data()->options()->track_heap_objects)
+    return false;
+#if HAVE_INSPECTOR
+  if (env->inspector_agent()->IsActive())
+    return false;
+#endif
+  return true;
+}
+
+// The number of snapshots of all threads that are serialized on the
+// threadpool right now.
+Mutex background_writes_mutex;
+ConditionVariable background_writes_done;
+size_t background_writes = 0;
+
+// Takes a heap snapshot on the main thread, which cannot be avoided, and
+// serializes it to a file on the threadpool. Serialization is usually the
+// larger part of the work. If it is not safe to serialize concurrently, see
+// CanSerializeInBackground(), it is done on the main thread right before the
+// callback is called instead.
+class HeapSnapshotWriteWrap : public AsyncWrap, public ThreadPoolWork {
+ public:
+  HeapSnapshotWriteWrap(Environment* env,
+                        Local<Object> object,
+                        const HeapSnapshot* snapshot,
+                        std::string filename,
+                        uv_file fd,
+                        bool compress)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_HEAPSNAPSHOT),
+        ThreadPoolWork(env, AsyncWrap::PROVIDER_HEAPSNAPSHOT),
+        snapshot_(snapshot),
+        filename_(std::move(filename)),
+        fd_(fd),
+        compress_(compress),
+        background_(CanSerializeInBackground(env)) {
+    if (background_)
+      AddBackgroundWrite();
+  }
+
+  ~HeapSnapshotWriteWrap() override {
+    if (snapshot_ != nullptr)
+      const_cast<HeapSnapshot*>(snapshot_)->Delete();
+  }
+
+  void DoThreadPoolWork() override {
+    if (background_) {
+      Write();
+      RemoveBackgroundWrite();
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<HeapSnapshotWriteWrap> self(this);
+    // DoThreadPoolWork() did not run if the work was cancelled.
+    if (background_ && status == UV_ECANCELED)
+      RemoveBackgroundWrite();
+    if (!background_ && status == 0)
+      Write();
+    const_cast<HeapSnapshot*>(snapshot_)->Delete();
+    snapshot_ = nullptr;
+
+    Environment* env = this->env();
+    if (status == UV_ECANCELED || !env->can_call_into_js())
+      return;
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    Local<Value> argv[] = { v8::Null(isolate) };
+    if (status != 0) {
+      argv[0] = UVException(isolate, status, "uv_queue_work");
+    } else if (err_ != 0) {
+      argv[0] = UVException(isolate, err_, syscall_, nullptr,
+                            filename_.empty() ? nullptr : filename_.c_str());
+    }
+    MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(HeapSnapshotWriteWrap)
+  SET_SELF_SIZE(HeapSnapshotWriteWrap)
+
+ private:
+  static void AddBackgroundWrite() {
+    Mutex::ScopedLock lock(background_writes_mutex);
+    background_writes++;
+  }
+
+  static void RemoveBackgroundWrite() {
+    Mutex::ScopedLock lock(background_writes_mutex);
+    if (--background_writes == 0)
+      background_writes_done.Broadcast(lock);
+  }
+
+  void Write() {
+    bool close = false;
+    if (fd_ < 0) {
+      fd_ = OpenSnapshotFile(filename_.c_str());
+      if (fd_ < 0) {
+        err_ = fd_;
+        syscall_ = "open";
+        return;
+      }
+      close = true;
+    }
+    err_ = SerializeSnapshot(snapshot_, fd_, compress_);
+    syscall_ = "write";
+    if (close)
+      CloseSnapshotFile(fd_);
+  }
+
+  const HeapSnapshot* snapshot_;
+  std::string filename_;
+  uv_file fd_;
+  bool compress_;
+  bool background_;
+  int err_ = 0;
+  const char* syscall_ = nullptr;
+};
+
+// Folds the call tree of a sampled allocation profile into one entry per
+// stack, holding the estimated number and total size of the objects that
+// were allocated there and are still alive.
+class AllocationProfileSerializer {
+ public:
+  AllocationProfileSerializer(Isolate* isolate, bool pprof, int64_t interval)
+      : isolate_(isolate), pprof_(pprof) {
+    if (pprof_) {
+      builder_.AddSampleType("objects", "count");
+      builder_.AddSampleType("space", "bytes");
+      builder_.SetPeriod("space", "bytes", interval);
+      builder_.SetTime(
+          static_cast<int64_t>(GetCurrentTimeInMicroseconds() * 1000), 0);
+    }
+  }
+
+  std::string Serialize(AllocationProfile* profile) {
+    // The root node stands for the empty stack and has no allocations of
+    // its own: V8 attributes allocations outside of JavaScript to children
+    // such as (V8 API) or (GC).
+    const AllocationProfile::Node* root = profile->GetRootNode();
+    for (const AllocationProfile::Node* child : root->children)
+      AddNode(child);
+    return pprof_ ? builder_.Serialize() : std::move(out_);
+  }
+
+ private:
+  void AddNode(const AllocationProfile::Node* node) {
+    std::string name;
+    if (!node->name.IsEmpty())
+      name = *Utf8Value(isolate_, node->name);
+    if (name.empty())
+      name = "(anonymous)";
+    std::string url;
+    if (!node->script_name.IsEmpty())
+      url = *Utf8Value(isolate_, node->script_name);
+
+    size_t prefix_length = prefix_.size();
+    if (pprof_) {
+      locations_.push_back(
+          builder_.AddLocation(name, url, node->line_number));
+    } else {
+      // The same format as the collapsed stacks of the CPU sampler.
+      if (prefix_length > 0)
+        prefix_ += ';';
+      prefix_ += name;
+      if (!url.empty())
+        prefix_ += ' ' + url + ':' + std::to_string(node->line_number);
+    }
+
+    int64_t count = 0;
+    int64_t size = 0;
+    for (const AllocationProfile::Allocation& allocation : node->allocations) {
+      count += allocation.count;
+      size += static_cast<int64_t>(allocation.size) * allocation.count;
+    }
+    if (count > 0) {
+      if (pprof_) {
+        std::vector<uint64_t> leaf_first(locations_.rbegin(),
+                                         locations_.rend());
+        builder_.AddSample(leaf_first, { count, size });
+      } else {
+        out_ += prefix_ + ' ' + std::to_string(size) + '\n';
+      }
+    }
+
+    for (const AllocationProfile::Node* child : node->children)
+      AddNode(child);
+
+    if (pprof_)
+      locations_.pop_back();
+    else
+      prefix_.resize(prefix_length);
+  }
+
+  Isolate* isolate_;
+  bool pprof_;
+  pprof::ProfileBuilder builder_;
+  // Location ids of the current stack, outermost frame first.
+  std::vector<uint64_t> locations_;
+  // Frames of the current stack, in the collapsed format.
+  std::string prefix_;
+  std::string out_;
+};
+
+// Returns false if the sampling heap profiler is not running.
+bool SerializeAllocationProfile(Isolate* isolate,
+                                bool pprof,
+                                int64_t interval,
+                                std::string* out) {
+  HandleScope scope(isolate);
+  std::unique_ptr<AllocationProfile> profile(
+      isolate->GetHeapProfiler()->GetAllocationProfile());
+  if (!profile)
     return false;
-  FileOutputStream stream(fp);
-  TakeSnapshot(isolate, &stream);
-  fclose(fp);
+  AllocationProfileSerializer serializer(isolate, pprof, interval);
+  *out = serializer.Serialize(profile.get());
   return true;
 }
 
 }  // namespace
 
+void WaitForBackgroundSnapshotWrites() {
+  Mutex::ScopedLock lock(background_writes_mutex);
+  while (background_writes > 0)
+    background_writes_done.Wait(lock);
+}
+
 void CreateHeapSnapshotStream(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   HandleScope scope(env->isolate());
@@ -354,16 +701,29 @@ void CreateHeapSnapshotStream(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(out->object());
 }
 
+// The arguments are the filename, whether to compress the snapshot, and a
+// file descriptor to write to instead of a file.
 void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = args.GetIsolate();
 
   Local<Value> filename_v = args[0];
+  bool compress = args[1]->IsTrue();
 
+  if (args[2]->IsInt32()) {
+    int err = TakeSnapshot(isolate, args[2].As<Int32>()->Value(), compress);
+    if (err != 0)
+      return env->ThrowUVException(err, "write");
+    return args.GetReturnValue().Set(args[2]);
+  }
+
+  const char* syscall;
   if (filename_v->IsUndefined()) {
-    DiagnosticFilename name(env, "Heap", "heapsnapshot");
-    if (!WriteSnapshot(isolate, *name))
-      return;
+    DiagnosticFilename name(env, "Heap",
+                            compress ? "heapsnapshot.gz" : "heapsnapshot");
+    int err = WriteSnapshot(isolate, *name, compress, &syscall);
+    if (err != 0)
+      return env->ThrowUVException(err, syscall, nullptr, *name);
     if (String::NewFromUtf8(isolate, *name, v8::NewStringType::kNormal)
             .ToLocal(&filename_v)) {
       args.GetReturnValue().Set(filename_v);
@@ -373,11 +733,106 @@ void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
 
   BufferValue path(isolate, filename_v);
   CHECK_NOT_NULL(*path);
-  if (!WriteSnapshot(isolate, *path))
-    return;
+  int err = WriteSnapshot(isolate, *path, compress, &syscall);
+  if (err != 0)
+    return env->ThrowUVException(err, syscall, nullptr, *path);
   return args.GetReturnValue().Set(filename_v);
 }
 
+// Takes the same arguments as TriggerHeapSnapshot(). The target, i.e. the
+// filename or the file descriptor, is available as the `target` property
+// of the new object.
+void HeapSnapshotWriteWrap::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK(args.IsConstructCall());
+
+  Local<Value> target = args[0];
+  bool compress = args[1]->IsTrue();
+  std::string filename;
+  uv_file fd = -1;
+  if (args[2]->IsInt32()) {
+    fd = args[2].As<Int32>()->Value();
+    target = args[2];
+  } else if (target->IsUndefined()) {
+    DiagnosticFilename name(env, "Heap",
+                            compress ? "heapsnapshot.gz" : "heapsnapshot");
+    filename = *name;
+    if (!String::NewFromUtf8(isolate, *name, v8::NewStringType::kNormal)
+             .ToLocal(&target)) {
+      return;
+    }
+  } else {
+    BufferValue path(isolate, target);
+    CHECK_NOT_NULL(*path);
+    filename = *path;
+  }
+  if (args.This()->Set(env->context(),
+                       FIXED_ONE_BYTE_STRING(isolate, "target"),
+                       target).IsNothing()) {
+    return;
+  }
+
+  const HeapSnapshot* const snapshot =
+      isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  CHECK_NOT_NULL(snapshot);
+  HeapSnapshotWriteWrap* wrap = new HeapSnapshotWriteWrap(
+      env, args.This(), snapshot, std::move(filename), fd, compress);
+  wrap->ScheduleWork();
+}
+
+// The arguments are the sampling interval in bytes and the maximum number of
+// frames of each stack. Returns false if a sampling heap profiler is already
+// running, e.g. because of --heap-prof or an inspector session.
+void StartSamplingHeapProfiler(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsInt32());
+  uint64_t interval = args[0].As<Uint32>()->Value();
+  int depth = args[1].As<Int32>()->Value();
+  args.GetReturnValue().Set(
+      isolate->GetHeapProfiler()->StartSamplingHeapProfiler(interval, depth));
+}
+
+void StopSamplingHeapProfiler(const FunctionCallbackInfo<Value>& args) {
+  args.GetIsolate()->GetHeapProfiler()->StopSamplingHeapProfiler();
+}
+
+// The arguments are whether to return a pprof profile instead of collapsed
+// stacks, and the sampling interval. Returns undefined if the sampling heap
+// profiler is not running.
+void GetSamplingHeapProfile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  bool pprof = args[0]->IsTrue();
+  CHECK(args[1]->IsUint32());
+  std::string profile;
+  if (!SerializeAllocationProfile(env->isolate(),
+                                  pprof,
+                                  args[1].As<Uint32>()->Value(),
+                                  &profile)) {
+    return;
+  }
+
+  pprof::ReturnProfile(env, args, profile, pprof);
+}
+
+// Takes the filename followed by the arguments of GetSamplingHeapProfile().
+void WriteSamplingHeapProfile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  bool pprof = args[1]->IsTrue();
+  CHECK(args[2]->IsUint32());
+  std::string profile;
+  if (!SerializeAllocationProfile(isolate,
+                                  pprof,
+                                  args[2].As<Uint32>()->Value(),
+                                  &profile)) {
+    return;
+  }
+
+  pprof::WriteProfile(env, args, args[0], "Heap", &profile, pprof);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -393,6 +848,29 @@ void Initialize(Local<Object> target,
   env->SetMethodNoSideEffect(target,
                              "createHeapSnapshotStream",
                              CreateHeapSnapshotStream);
+  env->SetMethod(target,
+                 "startSamplingHeapProfiler",
+                 StartSamplingHeapProfiler);
+  env->SetMethod(target,
+                 "stopSamplingHeapProfiler",
+                 StopSamplingHeapProfiler);
+  env->SetMethodNoSideEffect(target,
+                             "getSamplingHeapProfile",
+                             GetSamplingHeapProfile);
+  env->SetMethod(target,
+                 "writeSamplingHeapProfile",
+                 WriteSamplingHeapProfile);
+
+  Local<String> write_wrap_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "HeapSnapshotWriteWrap");
+  Local<FunctionTemplate> ww =
+      env->NewFunctionTemplate(HeapSnapshotWriteWrap::New);
+  ww->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  ww->InstanceTemplate()->SetInternalFieldCount(1);
+  ww->SetClassName(write_wrap_string);
+  target->Set(env->context(),
+              write_wrap_string,
+              ww->GetFunction(env->context()).ToLocalChecked()).Check();
 
   // Create FunctionTemplate for HeapSnapshotStream
   Local<FunctionTemplate> os = FunctionTemplate::New(env->isolate());
@@ -262,6 +262,8 @@ class ChannelImpl final : public v8_inspector::V8Inspector::Channel,
     node_dispatcher_->parseCommand(value.get(), &call_id, &method);
     if (v8_inspector::V8InspectorSession::canDispatchMethod(
             Utf8ToStringView(method)->string())) {
+      if (method == "HeapProfiler.startTrackingHeapObjects")
+        heap::WaitForBackgroundSnapshotWrites();
       session_->dispatchProtocolMessage(message);
     } else {
       node_dispatcher_->dispatch(call_id, method, std::move(value),
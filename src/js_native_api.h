@@ -494,6 +494,51 @@ NAPI_EXTERN napi_status napi_add_finalizer(napi_env env,
                                            napi_finalize finalize_cb,
                                            void* finalize_hint,
                                            napi_ref* result);
+
+// Strings backed by memory outside of the JavaScript heap
+NAPI_EXTERN napi_status
+napi_create_external_string_latin1(napi_env env,
+                                   char* str,
+                                   size_t length,
+                                   napi_finalize finalize_cb,
+                                   void* finalize_hint,
+                                   napi_value* result);
+NAPI_EXTERN napi_status
+napi_create_external_string_utf16(napi_env env,
+                                  char16_t* str,
+                                  size_t length,
+                                  napi_finalize finalize_cb,
+                                  void* finalize_hint,
+                                  napi_value* result);
+NAPI_EXTERN napi_status
+napi_get_value_string_latin1_view(napi_env env,
+                                  napi_value value,
+                                  const char** result,
+                                  size_t* length);
+NAPI_EXTERN napi_status
+napi_get_value_string_utf16_view(napi_env env,
+                                 napi_value value,
+                                 const char16_t** result,
+                                 size_t* length);
+
+// Fast object creation
+NAPI_EXTERN napi_status napi_create_property_key_utf8(napi_env env,
+                                                      const char* utf8name,
+                                                      size_t length,
+                                                      napi_value* result);
+NAPI_EXTERN napi_status
+napi_create_object_template(napi_env env,
+                            size_t key_count,
+                            const napi_value* keys,
+                            napi_object_template* result);
+NAPI_EXTERN napi_status
+napi_create_object_from_template(napi_env env,
+                                 napi_object_template object_template,
+                                 const napi_value* values,
+                                 napi_value* result);
+NAPI_EXTERN napi_status
+napi_delete_object_template(napi_env env,
+                            napi_object_template object_template);
 #endif  // NAPI_EXPERIMENTAL
 
 EXTERN_C_END
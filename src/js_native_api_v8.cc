@@ -1,6 +1,7 @@
 #include <climits>  // INT_MAX
 #include <cmath>
 #include <algorithm>
+#include <string>
 #define NAPI_EXPERIMENTAL
 #include "env-inl.h"
 #include "js_native_api_v8.h"
@@ -672,6 +673,144 @@ inline napi_status Wrap(napi_env env,
   return GET_RETURN_STATUS(env);
 }
 
+// String resource backed by memory that is owned by the addon. V8 disposes
+// of the resource while the garbage collector is running or the isolate is
+// being torn down, when calls back into the engine are not allowed. The
+// finalizer is therefore called with a NULL env, and may only release the
+// memory.
+template <typename ResourceType, typename TypeName>
+class ExternalString : public ResourceType {
+ public:
+  ExternalString(v8::Isolate* isolate,
+                 TypeName* data,
+                 size_t length,
+                 napi_finalize finalize_cb,
+                 void* finalize_hint)
+      : isolate_(isolate),
+        data_(data),
+        length_(length),
+        finalize_cb_(finalize_cb),
+        finalize_hint_(finalize_hint) {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(byte_length());
+  }
+
+  ~ExternalString() override {
+    if (finalize_cb_ != nullptr)
+      finalize_cb_(nullptr, data_, finalize_hint_);
+    isolate_->AdjustAmountOfExternalAllocatedMemory(-byte_length());
+  }
+
+  const TypeName* data() const override {
+    return data_;
+  }
+
+  size_t length() const override {
+    return length_;
+  }
+
+  int64_t byte_length() const {
+    return length_ * sizeof(TypeName);
+  }
+
+  // Deletes the resource without calling the finalizer, for when V8 did not
+  // take ownership of it.
+  void Abandon() {
+    finalize_cb_ = nullptr;
+    delete this;
+  }
+
+ private:
+  v8::Isolate* isolate_;
+  TypeName* data_;
+  size_t length_;
+  napi_finalize finalize_cb_;
+  void* finalize_hint_;
+};
+
+typedef ExternalString<v8::String::ExternalOneByteStringResource, char>
+    ExternalOneByteString;
+typedef ExternalString<v8::String::ExternalStringResource, uint16_t>
+    ExternalTwoByteString;
+
+inline v8::MaybeLocal<v8::String> NewExternal(v8::Isolate* isolate,
+                                              ExternalOneByteString* resource) {
+  return v8::String::NewExternalOneByte(isolate, resource);
+}
+
+inline v8::MaybeLocal<v8::String> NewExternal(v8::Isolate* isolate,
+                                              ExternalTwoByteString* resource) {
+  return v8::String::NewExternalTwoByte(isolate, resource);
+}
+
+template <typename StringType, typename TypeName>
+napi_status NewExternalString(napi_env env,
+                              TypeName* str,
+                              size_t length,
+                              napi_finalize finalize_cb,
+                              void* finalize_hint,
+                              napi_value* result) {
+  StringType* resource = new StringType(env->isolate,
+                                        str,
+                                        length,
+                                        finalize_cb,
+                                        finalize_hint);
+  v8::MaybeLocal<v8::String> str_maybe = NewExternal(env->isolate, resource);
+  if (str_maybe.IsEmpty()) {
+    resource->Abandon();
+    return napi_set_last_error(env, napi_generic_failure);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(str_maybe.ToLocalChecked());
+  return napi_clear_last_error(env);
+}
+
+// The keys of a napi_object_template, and the template from which objects
+// with exactly those properties are instantiated. All instances share the
+// same hidden class, so that the code consuming them can stay monomorphic.
+class ObjectShape {
+ public:
+  ObjectShape(v8::Isolate* isolate,
+              v8::Local<v8::ObjectTemplate> object_template,
+              const std::vector<v8::Local<v8::Name>>& keys)
+      : _template(isolate, object_template),
+        _keys(keys.size()) {
+    for (size_t i = 0; i < keys.size(); i++) {
+      _keys[i].Reset(isolate, keys[i]);
+    }
+  }
+
+  v8::MaybeLocal<v8::Object> NewInstance(napi_env env,
+                                         const napi_value* values) {
+    v8::Isolate* isolate = env->isolate;
+    v8::Local<v8::Context> context = env->context();
+    v8::Local<v8::Object> obj;
+    if (!_template.Get(isolate)->NewInstance(context).ToLocal(&obj)) {
+      return v8::MaybeLocal<v8::Object>();
+    }
+
+    if (values != nullptr) {
+      for (size_t i = 0; i < _keys.size(); i++) {
+        if (values[i] == nullptr) {
+          continue;
+        }
+        v8::Maybe<bool> set_maybe = obj->CreateDataProperty(
+            context,
+            _keys[i].Get(isolate),
+            v8impl::V8LocalValueFromJsValue(values[i]));
+        if (!set_maybe.FromMaybe(false)) {
+          return v8::MaybeLocal<v8::Object>();
+        }
+      }
+    }
+
+    return obj;
+  }
+
+ private:
+  v8impl::Persistent<v8::ObjectTemplate> _template;
+  std::vector<v8impl::Persistent<v8::Name>> _keys;
+};
+
 }  // end of anonymous namespace
 
 }  // end of namespace v8impl
@@ -1303,6 +1442,91 @@ napi_status napi_create_object(napi_env env, napi_value* result) {
   return napi_clear_last_error(env);
 }
 
+// Creates an internalized string for use as a property key. Keeping the key
+// around, e.g. in a napi_ref, and passing it to napi_set_property() avoids
+// looking up the key by its name for every access, as
+// napi_set_named_property() has to.
+napi_status napi_create_property_key_utf8(napi_env env,
+                                          const char* utf8name,
+                                          size_t length,
+                                          napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+
+  v8::Local<v8::String> key;
+  CHECK_NEW_FROM_UTF8_LEN(env, key, utf8name, length);
+
+  *result = v8impl::JsValueFromV8LocalValue(key);
+  return napi_clear_last_error(env);
+}
+
+napi_status napi_create_object_template(napi_env env,
+                                        size_t key_count,
+                                        const napi_value* keys,
+                                        napi_object_template* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env,
+      key_count == 0 || keys != nullptr,
+      napi_invalid_arg);
+
+  v8::Isolate* isolate = env->isolate;
+  v8::Local<v8::ObjectTemplate> object_template =
+      v8::ObjectTemplate::New(isolate);
+  std::vector<v8::Local<v8::Name>> names(key_count);
+
+  for (size_t i = 0; i < key_count; i++) {
+    CHECK_ARG(env, keys[i]);
+    v8::Local<v8::Value> key = v8impl::V8LocalValueFromJsValue(keys[i]);
+    RETURN_STATUS_IF_FALSE(env, key->IsName(), napi_name_expected);
+    names[i] = key.As<v8::Name>();
+    for (size_t j = 0; j < i; j++) {
+      RETURN_STATUS_IF_FALSE(env,
+          !names[j]->StrictEquals(names[i]),
+          napi_invalid_arg);
+    }
+    object_template->Set(names[i], v8::Undefined(isolate));
+  }
+
+  *result = reinterpret_cast<napi_object_template>(
+      new v8impl::ObjectShape(isolate, object_template, names));
+  return napi_clear_last_error(env);
+}
+
+// Creates an object with the properties of the template, and sets them to
+// the corresponding entries of values. Properties whose value is NULL are left
+// undefined. values must hold one entry for each key of the template, or be
+// NULL.
+napi_status napi_create_object_from_template(
+    napi_env env,
+    napi_object_template object_template,
+    const napi_value* values,
+    napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, object_template);
+  CHECK_ARG(env, result);
+
+  v8::MaybeLocal<v8::Object> maybe_obj =
+      reinterpret_cast<v8impl::ObjectShape*>(object_template)->NewInstance(
+          env, values);
+  CHECK_MAYBE_EMPTY(env, maybe_obj, napi_generic_failure);
+
+  *result = v8impl::JsValueFromV8LocalValue(maybe_obj.ToLocalChecked());
+  return GET_RETURN_STATUS(env);
+}
+
+napi_status napi_delete_object_template(napi_env env,
+                                        napi_object_template object_template) {
+  // Omit NAPI_PREAMBLE and GET_RETURN_STATUS because V8 calls here cannot throw
+  // JS exceptions.
+  CHECK_ENV(env);
+  CHECK_ARG(env, object_template);
+
+  delete reinterpret_cast<v8impl::ObjectShape*>(object_template);
+
+  return napi_clear_last_error(env);
+}
+
 napi_status napi_create_array(napi_env env, napi_value* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, result);
@@ -1390,6 +1614,47 @@ napi_status napi_create_string_utf16(napi_env env,
   return napi_clear_last_error(env);
 }
 
+napi_status napi_create_external_string_latin1(napi_env env,
+                                               char* str,
+                                               size_t length,
+                                               napi_finalize finalize_cb,
+                                               void* finalize_hint,
+                                               napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, str);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env,
+      (length == NAPI_AUTO_LENGTH) || length <= INT_MAX,
+      napi_invalid_arg);
+
+  if (length == NAPI_AUTO_LENGTH)
+    length = strlen(str);
+
+  return v8impl::NewExternalString<v8impl::ExternalOneByteString>(
+      env, str, length, finalize_cb, finalize_hint, result);
+}
+
+napi_status napi_create_external_string_utf16(napi_env env,
+                                              char16_t* str,
+                                              size_t length,
+                                              napi_finalize finalize_cb,
+                                              void* finalize_hint,
+                                              napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, str);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env,
+      (length == NAPI_AUTO_LENGTH) || length <= INT_MAX,
+      napi_invalid_arg);
+
+  if (length == NAPI_AUTO_LENGTH)
+    length = std::char_traits<char16_t>::length(str);
+
+  return v8impl::NewExternalString<v8impl::ExternalTwoByteString>(
+      env, reinterpret_cast<uint16_t*>(str), length, finalize_cb,
+      finalize_hint, result);
+}
+
 napi_status napi_create_double(napi_env env,
                                double value,
                                napi_value* result) {
@@ -2146,6 +2411,69 @@ napi_status napi_get_value_string_utf16(napi_env env,
   return napi_clear_last_error(env);
 }
 
+// Returns a read-only view of the contents of a JavaScript string that is
+// backed by a LATIN-1 buffer outside of the JavaScript heap, without copying
+// them. If the contents of the string are not available that way, result is
+// set to NULL and the string must be copied with
+// napi_get_value_string_latin1() instead. The view remains valid for as long
+// as the string is alive.
+napi_status napi_get_value_string_latin1_view(napi_env env,
+                                              napi_value value,
+                                              const char** result,
+                                              size_t* length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, length);
+
+  v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
+  RETURN_STATUS_IF_FALSE(env, val->IsString(), napi_string_expected);
+
+  v8::String::Encoding encoding;
+  v8::String::ExternalStringResourceBase* resource =
+      val.As<v8::String>()->GetExternalStringResourceBase(&encoding);
+  if (resource != nullptr && encoding == v8::String::ONE_BYTE_ENCODING) {
+    auto one_byte =
+        static_cast<v8::String::ExternalOneByteStringResource*>(resource);
+    *result = one_byte->data();
+    *length = one_byte->length();
+  } else {
+    *result = nullptr;
+    *length = 0;
+  }
+
+  return napi_clear_last_error(env);
+}
+
+// Like napi_get_value_string_latin1_view(), but for strings that are backed
+// by a UTF-16 buffer. The length is the number of 2-byte code units.
+napi_status napi_get_value_string_utf16_view(napi_env env,
+                                             napi_value value,
+                                             const char16_t** result,
+                                             size_t* length) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, value);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, length);
+
+  v8::Local<v8::Value> val = v8impl::V8LocalValueFromJsValue(value);
+  RETURN_STATUS_IF_FALSE(env, val->IsString(), napi_string_expected);
+
+  v8::String::Encoding encoding;
+  v8::String::ExternalStringResourceBase* resource =
+      val.As<v8::String>()->GetExternalStringResourceBase(&encoding);
+  if (resource != nullptr && encoding == v8::String::TWO_BYTE_ENCODING) {
+    auto two_byte = static_cast<v8::String::ExternalStringResource*>(resource);
+    *result = reinterpret_cast<const char16_t*>(two_byte->data());
+    *length = two_byte->length();
+  } else {
+    *result = nullptr;
+    *length = 0;
+  }
+
+  return napi_clear_last_error(env);
+}
+
 napi_status napi_coerce_to_bool(napi_env env,
                                 napi_value value,
                                 napi_value* result) {
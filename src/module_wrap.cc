@@ -2,7 +2,9 @@
 
 #include "env.h"
 #include "memory_tracker-inl.h"
+#include "node_internals.h"
 #include "node_errors.h"
+#include "node_package_json.h"
 #include "node_url.h"
 #include "util-inl.h"
 #include "node_contextify.h"
@@ -22,6 +24,9 @@ using node::contextify::ContextifyContext;
 using node::url::URL;
 using node::url::URL_FLAGS_FAILED;
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::ArrayBufferView;
+using v8::Boolean;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -118,8 +123,11 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
   Local<Integer> line_offset;
   Local<Integer> column_offset;
 
-  if (argc == 5) {
-    // new ModuleWrap(source, url, context?, lineOffset, columnOffset)
+  Local<ArrayBufferView> cached_data_buf;
+
+  if (argc >= 5) {
+    // new ModuleWrap(source, url, context?, lineOffset, columnOffset,
+    //                cachedData?)
     if (args[2]->IsUndefined()) {
       context = that->CreationContext();
     } else {
@@ -136,6 +144,11 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
 
     CHECK(args[4]->IsNumber());
     column_offset = args[4].As<Integer>();
+
+    if (argc > 5 && !args[5]->IsUndefined()) {
+      CHECK(args[5]->IsArrayBufferView());
+      cached_data_buf = args[5].As<ArrayBufferView>();
+    }
   } else {
     // new ModuleWrap(source, url)
     context = that->CreationContext();
@@ -146,6 +159,7 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
   ShouldNotAbortOnUncaughtScope no_abort_scope(env);
   TryCatchScope try_catch(env);
   Local<Module> module;
+  bool cached_data_rejected = false;
 
   Local<PrimitiveArray> host_defined_options =
       PrimitiveArray::New(isolate, HostDefinedOptions::kLength);
@@ -165,8 +179,19 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
                         True(isolate),                        // is ES Module
                         host_defined_options);
     Context::Scope context_scope(context);
-    ScriptCompiler::Source source(source_text, origin);
-    if (!ScriptCompiler::CompileModule(isolate, &source).ToLocal(&module)) {
+    ScriptCompiler::CachedData* cached_data = nullptr;
+    ScriptCompiler::CompileOptions options = ScriptCompiler::kNoCompileOptions;
+    if (!cached_data_buf.IsEmpty()) {
+      ArrayBuffer::Contents contents =
+          cached_data_buf->Buffer()->GetContents();
+      uint8_t* data = static_cast<uint8_t*>(contents.Data());
+      cached_data = new ScriptCompiler::CachedData(
+          data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+      options = ScriptCompiler::kConsumeCodeCache;
+    }
+    ScriptCompiler::Source source(source_text, origin, cached_data);
+    if (!ScriptCompiler::CompileModule(isolate, &source, options)
+            .ToLocal(&module)) {
       if (try_catch.HasCaught() && !try_catch.HasTerminated()) {
         CHECK(!try_catch.Message().IsEmpty());
         CHECK(!try_catch.Exception().IsEmpty());
@@ -176,12 +201,22 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       }
       return;
     }
+    if (options == ScriptCompiler::kConsumeCodeCache)
+      cached_data_rejected = source.GetCachedData()->rejected;
   }
 
   if (!that->Set(context, env->url_string(), url).FromMaybe(false)) {
     return;
   }
 
+  if (!cached_data_buf.IsEmpty() &&
+      !that->Set(context,
+                 env->cached_data_rejected_string(),
+                 Boolean::New(isolate, cached_data_rejected))
+          .FromMaybe(false)) {
+    return;
+  }
+
   ModuleWrap* obj = new ModuleWrap(env, that, module, url);
   obj->context_.Reset(isolate, context);
 
@@ -381,6 +416,24 @@ void ModuleWrap::GetStaticDependencySpecifiers(
   args.GetReturnValue().Set(specifiers);
 }
 
+void ModuleWrap::CreateCachedData(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = args.GetIsolate();
+  ModuleWrap* obj;
+  ASSIGN_OR_RETURN_UNWRAP(&obj, args.This());
+
+  Local<Module> module = obj->module_.Get(isolate);
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+  if (!cached_data)
+    return;
+  MaybeLocal<Object> buf = Buffer::Copy(
+      env,
+      reinterpret_cast<const char*>(cached_data->data),
+      cached_data->length);
+  args.GetReturnValue().Set(buf.ToLocalChecked());
+}
+
 void ModuleWrap::GetError(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   ModuleWrap* obj;
@@ -538,6 +591,48 @@ using IsValid = PackageConfig::IsValid;
 using HasMain = PackageConfig::HasMain;
 using PackageType = PackageConfig::PackageType;
 
+// Slow path for GetPackageConfig(), used for documents that nest too deeply
+// for ScanPackageJSON().
+IsValid ParsePackageConfig(Environment* env,
+                           const std::string& pkg_src,
+                           HasMain* has_main,
+                           std::string* main_std,
+                           PackageType* pkg_type) {
+  Isolate* isolate = env->isolate();
+  v8::HandleScope handle_scope(isolate);
+  Local<Context> context = env->context();
+
+  Local<Object> pkg_json;
+  {
+    Local<Value> src;
+    Local<Value> pkg_json_v;
+
+    if (!ToV8Value(context, pkg_src).ToLocal(&src) ||
+        !v8::JSON::Parse(context, src.As<String>()).ToLocal(&pkg_json_v) ||
+        !pkg_json_v->ToObject(context).ToLocal(&pkg_json)) {
+      return IsValid::No;
+    }
+  }
+
+  Local<Value> pkg_main;
+  if (pkg_json->Get(context, env->main_string()).ToLocal(&pkg_main) &&
+      pkg_main->IsString()) {
+    *has_main = HasMain::Yes;
+    Utf8Value main_utf8(isolate, pkg_main);
+    main_std->assign(*main_utf8, main_utf8.length());
+  }
+
+  Local<Value> type_v;
+  if (pkg_json->Get(context, env->type_string()).ToLocal(&type_v)) {
+    if (type_v->StrictEquals(env->module_string())) {
+      *pkg_type = PackageType::Module;
+    } else if (type_v->StrictEquals(env->commonjs_string())) {
+      *pkg_type = PackageType::CommonJS;
+    }
+  }
+  return IsValid::Yes;
+}
+
 Maybe<const PackageConfig*> GetPackageConfig(Environment* env,
                                              const std::string& path,
                                              const URL& base) {
@@ -564,62 +659,51 @@ Maybe<const PackageConfig*> GetPackageConfig(Environment* env,
 
   std::string pkg_src = source.FromJust();
 
-  Isolate* isolate = env->isolate();
-  v8::HandleScope handle_scope(isolate);
-
-  Local<Object> pkg_json;
-  {
-    Local<Value> src;
-    Local<Value> pkg_json_v;
-    Local<Context> context = env->context();
-
-    if (!ToV8Value(context, pkg_src).ToLocal(&src) ||
-        !v8::JSON::Parse(context, src.As<String>()).ToLocal(&pkg_json_v) ||
-        !pkg_json_v->ToObject(context).ToLocal(&pkg_json)) {
-      env->package_json_cache.emplace(path,
-          PackageConfig { Exists::Yes, IsValid::No, HasMain::No, "",
-                          PackageType::None });
-      std::string msg = "Invalid JSON in '" + path +
-          "' imported from " + base.ToFilePath();
-      node::THROW_ERR_INVALID_PACKAGE_CONFIG(env, msg.c_str());
-      return Nothing<const PackageConfig*>();
-    }
-  }
-
-  Local<Value> pkg_main;
+  IsValid is_valid = IsValid::Yes;
   HasMain has_main = HasMain::No;
   std::string main_std;
-  if (pkg_json->Get(env->context(), env->main_string()).ToLocal(&pkg_main)) {
-    if (pkg_main->IsString()) {
-      has_main = HasMain::Yes;
-    }
-    Utf8Value main_utf8(isolate, pkg_main);
-    main_std.assign(std::string(*main_utf8, main_utf8.length()));
-  }
-
   PackageType pkg_type = PackageType::None;
-  Local<Value> type_v;
-  if (pkg_json->Get(env->context(), env->type_string()).ToLocal(&type_v)) {
-    if (type_v->StrictEquals(env->module_string())) {
-      pkg_type = PackageType::Module;
-    } else if (type_v->StrictEquals(env->commonjs_string())) {
-      pkg_type = PackageType::CommonJS;
+
+  PackageJSONFields fields;
+  switch (ScanPackageJSON(pkg_src.data(), pkg_src.size(), &fields)) {
+    case PackageJSONScanResult::kOk: {
+      if (fields.is_null) {
+        is_valid = IsValid::No;
+        break;
+      }
+      const PackageJSONFields::Value& main = fields[PackageJSONFields::kMain];
+      if (main.kind == PackageJSONFields::Kind::kString) {
+        has_main = HasMain::Yes;
+        main_std = main.string;
+      }
+      const PackageJSONFields::Value& type = fields[PackageJSONFields::kType];
+      if (type.kind == PackageJSONFields::Kind::kString) {
+        if (type.string == "module") {
+          pkg_type = PackageType::Module;
+        } else if (type.string == "commonjs") {
+          pkg_type = PackageType::CommonJS;
+        }
+        // ignore unknown types for forwards compatibility
+      }
+      break;
     }
-    // ignore unknown types for forwards compatibility
+    case PackageJSONScanResult::kInvalid:
+      is_valid = IsValid::No;
+      break;
+    case PackageJSONScanResult::kTooDeep:
+      is_valid = ParsePackageConfig(env, pkg_src, &has_main, &main_std,
+                                    &pkg_type);
+      break;
   }
 
-  Local<Value> exports_v;
-  if (pkg_json->Get(env->context(),
-      env->exports_string()).ToLocal(&exports_v) &&
-      (exports_v->IsObject() || exports_v->IsString() ||
-      exports_v->IsBoolean())) {
-    Global<Value> exports;
-    exports.Reset(env->isolate(), exports_v);
-
-    auto entry = env->package_json_cache.emplace(path,
-        PackageConfig { Exists::Yes, IsValid::Yes, has_main, main_std,
-                        pkg_type });
-    return Just(&entry.first->second);
+  if (is_valid == IsValid::No) {
+    env->package_json_cache.emplace(path,
+        PackageConfig { Exists::Yes, IsValid::No, HasMain::No, "",
+                        PackageType::None });
+    std::string msg = "Invalid JSON in '" + path +
+        "' imported from " + base.ToFilePath();
+    node::THROW_ERR_INVALID_PACKAGE_CONFIG(env, msg.c_str());
+    return Nothing<const PackageConfig*>();
   }
 
   auto entry = env->package_json_cache.emplace(path,
@@ -1062,6 +1146,7 @@ void ModuleWrap::Initialize(Local<Object> target,
   env->SetProtoMethodNoSideEffect(tpl, "namespace", Namespace);
   env->SetProtoMethodNoSideEffect(tpl, "getStatus", GetStatus);
   env->SetProtoMethodNoSideEffect(tpl, "getError", GetError);
+  env->SetProtoMethod(tpl, "createCachedData", CreateCachedData);
   env->SetProtoMethodNoSideEffect(tpl, "getStaticDependencySpecifiers",
                                   GetStaticDependencySpecifiers);
 
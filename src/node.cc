@@ -35,6 +35,8 @@
 #include "node_perf.h"
 #include "node_process.h"
 #include "node_revert.h"
+#include "node_snapshotable.h"
+#include "node_threadpool.h"
 #include "node_v8_platform-inl.h"
 #include "node_version.h"
 
@@ -927,6 +929,12 @@ InitializationResult InitializeOncePerProcess(int argc, char** argv) {
   V8::SetEntropySource(crypto::EntropySource);
 #endif  // HAVE_OPENSSL
 
+  if (per_process::cli_options->threadpool_max_size > 0) {
+    CHECK_EQ(uv_threadpool_set_max_size(
+                 per_process::cli_options->threadpool_max_size), 0);
+  }
+  threadpool::Initialize();
+
   InitializeV8Platform(per_process::cli_options->v8_thread_pool_size);
   V8::Initialize();
   performance::performance_v8_start = PERFORMANCE_NOW();
@@ -945,6 +953,7 @@ void TearDownOncePerProcess() {
   // Since uv_run cannot be called, uv_async handles held by the platform
   // will never be fully cleaned up.
   per_process::v8_platform.Dispose();
+  threadpool::TearDown();
 }
 
 int Start(int argc, char** argv) {
@@ -953,6 +962,15 @@ int Start(int argc, char** argv) {
     return result.exit_code;
   }
 
+  if (per_process::cli_options->build_snapshot) {
+    result.exit_code =
+        SnapshotBuilder::BuildToFile(result.args,
+                                     result.exec_args,
+                                     per_process::cli_options->snapshot_blob);
+    TearDownOncePerProcess();
+    return result.exit_code;
+  }
+
   {
     Isolate::CreateParams params;
     // TODO(joyeecheung): collect external references and set it in
@@ -962,6 +980,20 @@ int Start(int argc, char** argv) {
     v8::StartupData* blob = NodeMainInstance::GetEmbeddedSnapshotBlob();
     const std::vector<size_t>* indexes =
         NodeMainInstance::GetIsolateDataIndexes();
+
+    SnapshotData snapshot_data;
+    const std::string& snapshot_blob = per_process::cli_options->snapshot_blob;
+    if (!snapshot_blob.empty()) {
+      std::string error;
+      if (!snapshot_data.ReadFromFile(snapshot_blob, &error)) {
+        fprintf(stderr, "%s: %s\n", result.args.at(0).c_str(), error.c_str());
+        TearDownOncePerProcess();
+        return 9;
+      }
+      blob = &snapshot_data.blob;
+      indexes = &snapshot_data.isolate_data_indexes;
+    }
+
     if (blob != nullptr) {
       params.external_references = external_references.data();
       params.snapshot_blob = blob;
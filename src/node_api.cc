@@ -10,6 +10,7 @@
 #include "util-inl.h"
 
 #include <memory>
+#include <vector>
 
 struct node_napi_env__ : public napi_env__ {
   explicit node_napi_env__(v8::Local<v8::Context> context):
@@ -210,6 +211,15 @@ class ThreadSafeFunction : public node::AsyncResource {
   }
 
   void EmptyQueueAndDelete() {
+    if (call_js_batch_cb != nullptr) {
+      batch.clear();
+      for (; !queue.empty() ; queue.pop()) {
+        batch.push_back(queue.front());
+      }
+      if (!batch.empty()) {
+        call_js_batch_cb(nullptr, nullptr, context, batch.data(), batch.size());
+      }
+    }
     for (; !queue.empty() ; queue.pop()) {
       call_js_cb(nullptr, nullptr, context, queue.front());
     }
@@ -264,25 +274,45 @@ class ThreadSafeFunction : public node::AsyncResource {
     return napi_ok;
   }
 
-  void DispatchOne() {
-    void* data = nullptr;
-    bool popped_value = false;
+  napi_status SetBatching(size_t max_batch_size_,
+                          napi_threadsafe_function_call_js_batch cb) {
+    max_batch_size = max_batch_size_;
+    call_js_batch_cb = cb;
+    batch.reserve(max_batch_size);
+
+    return napi_ok;
+  }
+
+  // Pops as many items as the batch size allows under a single acquisition
+  // of the mutex, and passes them to JavaScript inside one callback scope.
+  void Dispatch() {
     bool idle_stop_failed = false;
 
+    batch.clear();
     {
       node::Mutex::ScopedLock lock(this->mutex);
       if (is_closing) {
         CloseHandlesAndMaybeDelete();
       } else {
         size_t size = queue.size();
-        if (size > 0) {
-          data = queue.front();
-          queue.pop();
-          popped_value = true;
+        size_t count = call_js_batch_cb == nullptr ? 1 : max_batch_size;
+        if (count > size) {
+          count = size;
+        }
+        if (count > 0) {
+          for (size_t i = 0; i < count; i++) {
+            batch.push_back(queue.front());
+            queue.pop();
+          }
           if (size == max_queue_size && max_queue_size > 0) {
-            cond->Signal(lock);
+            // Freeing more than one slot may unblock more than one producer.
+            if (count > 1) {
+              cond->Broadcast(lock);
+            } else {
+              cond->Signal(lock);
+            }
           }
-          size--;
+          size -= count;
         }
 
         if (size == 0) {
@@ -301,7 +331,7 @@ class ThreadSafeFunction : public node::AsyncResource {
       }
     }
 
-    if (popped_value || idle_stop_failed) {
+    if (!batch.empty() || idle_stop_failed) {
       v8::HandleScope scope(env->isolate);
       CallbackScope cb_scope(this);
 
@@ -312,10 +342,18 @@ class ThreadSafeFunction : public node::AsyncResource {
       } else {
         v8::Local<v8::Function> js_cb =
             v8::Local<v8::Function>::New(env->isolate, ref);
-        call_js_cb(env,
-                   v8impl::JsValueFromV8LocalValue(js_cb),
-                   context,
-                   data);
+        if (call_js_batch_cb != nullptr) {
+          call_js_batch_cb(env,
+                           v8impl::JsValueFromV8LocalValue(js_cb),
+                           context,
+                           batch.data(),
+                           batch.size());
+        } else {
+          call_js_cb(env,
+                     v8impl::JsValueFromV8LocalValue(js_cb),
+                     context,
+                     batch[0]);
+        }
       }
     }
   }
@@ -400,7 +438,7 @@ class ThreadSafeFunction : public node::AsyncResource {
   static void IdleCb(uv_idle_t* idle) {
     ThreadSafeFunction* ts_fn =
         node::ContainerOf(&ThreadSafeFunction::idle, idle);
-    ts_fn->DispatchOne();
+    ts_fn->Dispatch();
   }
 
   static void AsyncCb(uv_async_t* async) {
@@ -436,6 +474,9 @@ class ThreadSafeFunction : public node::AsyncResource {
   napi_finalize finalize_cb;
   napi_threadsafe_function_call_js call_js_cb;
   bool handles_closing;
+  size_t max_batch_size = 1;
+  napi_threadsafe_function_call_js_batch call_js_batch_cb = nullptr;
+  std::vector<void*> batch;
 };
 
 }  // end of anonymous namespace
@@ -837,7 +878,7 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
     : AsyncResource(env->isolate,
                     async_resource,
                     *v8::String::Utf8Value(env->isolate, async_resource_name)),
-      ThreadPoolWork(env->node_env()),
+      ThreadPoolWork(env->node_env(), node::AsyncWrap::PROVIDER_NONE),
       _env(env),
       _data(data),
       _execute(execute),
@@ -1095,3 +1136,19 @@ napi_ref_threadsafe_function(napi_env env, napi_threadsafe_function func) {
   CHECK_NOT_NULL(func);
   return reinterpret_cast<v8impl::ThreadSafeFunction*>(func)->Ref();
 }
+
+napi_status
+napi_set_threadsafe_function_batching(
+    napi_env env,
+    napi_threadsafe_function func,
+    size_t max_batch_size,
+    napi_threadsafe_function_call_js_batch call_js_batch_cb) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, func);
+  CHECK_ARG(env, call_js_batch_cb);
+  RETURN_STATUS_IF_FALSE(env, max_batch_size > 0, napi_invalid_arg);
+
+  return napi_set_last_error(env,
+      reinterpret_cast<v8impl::ThreadSafeFunction*>(func)->SetBatching(
+          max_batch_size, call_js_batch_cb));
+}
@@ -232,6 +232,17 @@ napi_ref_threadsafe_function(napi_env env, napi_threadsafe_function func);
 
 #endif  // NAPI_VERSION >= 4
 
+#ifdef NAPI_EXPERIMENTAL
+
+NAPI_EXTERN napi_status
+napi_set_threadsafe_function_batching(
+    napi_env env,
+    napi_threadsafe_function func,
+    size_t max_batch_size,
+    napi_threadsafe_function_call_js_batch call_js_batch_cb);
+
+#endif  // NAPI_EXPERIMENTAL
+
 EXTERN_C_END
 
 #endif  // SRC_NODE_API_H_
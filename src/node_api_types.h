@@ -34,6 +34,14 @@ typedef void (*napi_threadsafe_function_call_js)(napi_env env,
                                                  void* data);
 #endif  // NAPI_VERSION >= 4
 
+#ifdef NAPI_EXPERIMENTAL
+typedef void (*napi_threadsafe_function_call_js_batch)(napi_env env,
+                                                       napi_value js_callback,
+                                                       void* context,
+                                                       void** data,
+                                                       size_t count);
+#endif  // NAPI_EXPERIMENTAL
+
 typedef struct {
   uint32_t major;
   uint32_t minor;
@@ -46,6 +46,7 @@
   V(cares_wrap)                                                                \
   V(config)                                                                    \
   V(contextify)                                                                \
+  V(cpu_sampler)                                                               \
   V(credentials)                                                               \
   V(domain)                                                                    \
   V(errors)                                                                    \
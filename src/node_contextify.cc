@@ -1124,7 +1124,13 @@ void ContextifyContext::CompileFunction(
       WeakCallbackCompileFn,
       v8::WeakCallbackType::kParameter);
 
-  if (produce_cached_data) {
+  if (options == ScriptCompiler::kConsumeCodeCache) {
+    if (fn->Set(
+        parsing_context,
+        env->cached_data_rejected_string(),
+        Boolean::New(isolate, source.GetCachedData()->rejected)).IsNothing())
+      return;
+  } else if (produce_cached_data) {
     const std::unique_ptr<ScriptCompiler::CachedData> cached_data(
         ScriptCompiler::CreateCodeCacheForFunction(fn));
     bool cached_data_produced = cached_data != nullptr;
@@ -1147,6 +1153,24 @@ void ContextifyContext::CompileFunction(
   args.GetReturnValue().Set(fn);
 }
 
+// Creates code cache for a function returned by compileFunction(), which
+// unlike the cachedData produced during compilation also covers the inner
+// functions that have been compiled lazily since then.
+static void CreateCodeCacheForFunction(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsFunction());
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      ScriptCompiler::CreateCodeCacheForFunction(args[0].As<Function>()));
+  if (!cached_data)
+    return;
+  MaybeLocal<Object> buf = Buffer::Copy(
+      env,
+      reinterpret_cast<const char*>(cached_data->data),
+      cached_data->length);
+  args.GetReturnValue().Set(buf.ToLocalChecked());
+}
+
 static void StartSigintWatchdog(const FunctionCallbackInfo<Value>& args) {
   int ret = SigintWatchdogHelper::GetInstance()->Start();
   args.GetReturnValue().Set(ret == 0);
@@ -1170,6 +1194,8 @@ void Initialize(Local<Object> target,
   ContextifyContext::Init(env, target);
   ContextifyScript::Init(env, target);
 
+  env->SetMethod(target, "createCodeCacheForFunction",
+                 CreateCodeCacheForFunction);
   env->SetMethod(target, "startSigintWatchdog", StartSigintWatchdog);
   env->SetMethod(target, "stopSigintWatchdog", StopSigintWatchdog);
   // Used in tests.
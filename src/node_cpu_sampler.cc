@@ -0,0 +1,443 @@
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_internals.h"
+#include "node_pprof.h"
+#include "util-inl.h"
+#include "uv.h"
+#include "v8-profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+namespace cpu_sampler {
+
+using v8::Array;
+using v8::Context;
+using v8::CpuProfile;
+using v8::CpuProfileNode;
+using v8::CpuProfiler;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Int32;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using v8::Value;
+
+namespace {
+
+// Samples are aggregated into one window per second. The sampler keeps a
+// ring of the most recent windows.
+constexpr uint64_t kWindowMs = 1000;
+// Upper bound on the number of distinct stacks in one window. Samples with
+// further stacks are counted as dropped.
+constexpr size_t kMaxStacksPerWindow = 4096;
+// Frames that are no longer used by any window are removed once the frame
+// table has grown to twice its size after the last pruning, or this size.
+constexpr size_t kMinFramesToPrune = 1024;
+
+enum ProfileFormat { kCollapsed = 0, kPprof = 1 };
+
+struct Frame {
+  std::string name;
+  std::string url;
+  int line;
+};
+
+// Frame ids, outermost frame first.
+typedef std::vector<uint32_t> Stack;
+typedef std::map<Stack, uint64_t> StackCounts;
+
+inline std::string FrameKey(const Frame& frame) {
+  return frame.name + '\0' + frame.url + '\0' + std::to_string(frame.line);
+}
+
+}  // anonymous namespace
+
+// Keeps a V8 CPU profile running at a low sampling frequency and, once per
+// window, folds its samples into per-stack counts. The profile is then
+// restarted so that V8 never holds more than one window of samples.
+// The object is only weak once it has been stopped, so that the profiler is
+// never disposed of from a GC callback.
+class CpuSampler : public BaseObject {
+ public:
+  CpuSampler(Environment* env,
+             Local<Object> wrap,
+             int frequency,
+             size_t windows);
+  ~CpuSampler() override;
+
+  static void New(const FunctionCallbackInfo<Value>& args);
+  static void Stop(const FunctionCallbackInfo<Value>& args);
+  static void GetProfile(const FunctionCallbackInfo<Value>& args);
+  static void WriteProfile(const FunctionCallbackInfo<Value>& args);
+  static void GetStatistics(const FunctionCallbackInfo<Value>& args);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(CpuSampler)
+  SET_SELF_SIZE(CpuSampler)
+
+ private:
+  static void OnTimer(uv_timer_t* handle);
+  static void CleanupHook(void* data);
+
+  void StopSampling();
+  void Collect();
+  void AddSamples(const CpuProfile* profile);
+  uint32_t GetFrameId(const CpuProfileNode* node);
+  void PruneFrames();
+  uint64_t Elapsed() const;
+  Local<String> Title(int index) const;
+  std::string Serialize(ProfileFormat format);
+
+  CpuProfiler* profiler_;
+  uv_timer_t* timer_;
+  int frequency_;
+  // The running profile alternates between two titles, see Collect().
+  int title_index_ = 0;
+  std::vector<StackCounts> windows_;
+  size_t current_window_ = 0;
+  std::vector<Frame> frames_;
+  std::unordered_map<std::string, uint32_t> frame_ids_;
+  size_t frames_to_prune_ = kMinFramesToPrune;
+  uint64_t start_time_;
+  // Set by StopSampling().
+  uint64_t stop_time_ = 0;
+  uint64_t samples_ = 0;
+  uint64_t dropped_samples_ = 0;
+  uint64_t aggregation_time_ = 0;
+};
+
+CpuSampler::CpuSampler(Environment* env,
+                       Local<Object> wrap,
+                       int frequency,
+                       size_t windows)
+    : BaseObject(env, wrap),
+      frequency_(frequency),
+      windows_(windows),
+      start_time_(uv_hrtime()) {
+  env->AddCleanupHook(CleanupHook, this);
+  profiler_ = CpuProfiler::New(env->isolate());
+  profiler_->SetSamplingInterval(1000 * 1000 / frequency);
+  profiler_->StartProfiling(Title(title_index_), v8::kLeafNodeLineNumbers,
+                            true);
+
+  timer_ = new uv_timer_t();
+  uv_timer_init(env->event_loop(), timer_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(timer_));
+  timer_->data = this;
+  uv_timer_start(timer_, OnTimer, kWindowMs, kWindowMs);
+}
+
+CpuSampler::~CpuSampler() {
+  CHECK_NULL(profiler_);
+}
+
+// Discards the running profile when the Environment goes away before the
+// sampler has been stopped.
+void CpuSampler::CleanupHook(void* data) {
+  CpuSampler* sampler = static_cast<CpuSampler*>(data);
+  sampler->profiler_->Dispose();
+  sampler->profiler_ = nullptr;
+  sampler->env()->CloseHandle(sampler->timer_,
+                              [](uv_timer_t* handle) { delete handle; });
+  delete sampler;
+}
+
+void CpuSampler::StopSampling() {
+  if (profiler_ == nullptr)
+    return;
+  Collect();
+  HandleScope handle_scope(env()->isolate());
+  CpuProfile* profile = profiler_->StopProfiling(Title(title_index_));
+  if (profile != nullptr)
+    profile->Delete();
+  profiler_->Dispose();
+  profiler_ = nullptr;
+  env()->CloseHandle(timer_, [](uv_timer_t* handle) { delete handle; });
+  timer_ = nullptr;
+  stop_time_ = uv_hrtime();
+  env()->RemoveCleanupHook(CleanupHook, this);
+  MakeWeak();
+}
+
+uint64_t CpuSampler::Elapsed() const {
+  return (profiler_ != nullptr ? uv_hrtime() : stop_time_) - start_time_;
+}
+
+Local<String> CpuSampler::Title(int index) const {
+  return index == 0 ?
+      FIXED_ONE_BYTE_STRING(env()->isolate(), "node:cpu-sampler:0") :
+      FIXED_ONE_BYTE_STRING(env()->isolate(), "node:cpu-sampler:1");
+}
+
+void CpuSampler::OnTimer(uv_timer_t* handle) {
+  CpuSampler* sampler = static_cast<CpuSampler*>(handle->data);
+  sampler->Collect();
+  sampler->current_window_ =
+      (sampler->current_window_ + 1) % sampler->windows_.size();
+  sampler->windows_[sampler->current_window_].clear();
+  if (sampler->frames_.size() >= sampler->frames_to_prune_)
+    sampler->PruneFrames();
+}
+
+void CpuSampler::Collect() {
+  if (profiler_ == nullptr)
+    return;
+  uint64_t start = uv_hrtime();
+  HandleScope handle_scope(env()->isolate());
+  // Starting the next profile before stopping the current one keeps V8's
+  // profiler thread running, so that the code map is not rebuilt from
+  // scratch for every window.
+  int next = 1 - title_index_;
+  profiler_->StartProfiling(Title(next), v8::kLeafNodeLineNumbers, true);
+  CpuProfile* profile = profiler_->StopProfiling(Title(title_index_));
+  title_index_ = next;
+  if (profile != nullptr) {
+    AddSamples(profile);
+    profile->Delete();
+  }
+  aggregation_time_ += uv_hrtime() - start;
+}
+
+void CpuSampler::AddSamples(const CpuProfile* profile) {
+  StackCounts* window = &windows_[current_window_];
+  std::unordered_map<const CpuProfileNode*, Stack> stacks;
+  int count = profile->GetSamplesCount();
+  for (int i = 0; i < count; i++) {
+    const CpuProfileNode* node = profile->GetSample(i);
+    auto it = stacks.find(node);
+    if (it == stacks.end()) {
+      Stack stack;
+      // The root node of the profile is not a frame.
+      for (const CpuProfileNode* frame = node;
+           frame != nullptr && frame->GetParent() != nullptr;
+           frame = frame->GetParent()) {
+        stack.push_back(GetFrameId(frame));
+      }
+      std::reverse(stack.begin(), stack.end());
+      it = stacks.emplace(node, std::move(stack)).first;
+    }
+
+    samples_++;
+    auto counted = window->find(it->second);
+    if (counted != window->end())
+      counted->second++;
+    else if (window->size() < kMaxStacksPerWindow)
+      window->emplace(it->second, 1);
+    else
+      dropped_samples_++;
+  }
+}
+
+uint32_t CpuSampler::GetFrameId(const CpuProfileNode* node) {
+  Frame frame = {
+    node->GetFunctionNameStr(),
+    node->GetScriptResourceNameStr(),
+    node->GetLineNumber()
+  };
+  if (frame.name.empty())
+    frame.name = "(anonymous)";
+  std::string key = FrameKey(frame);
+  auto it = frame_ids_.find(key);
+  if (it != frame_ids_.end())
+    return it->second;
+  uint32_t id = frames_.size();
+  frames_.push_back(std::move(frame));
+  frame_ids_.emplace(std::move(key), id);
+  return id;
+}
+
+// Rebuilds the frame table with only the frames that the remaining windows
+// refer to, and renumbers them in the windows' stacks.
+void CpuSampler::PruneFrames() {
+  constexpr uint32_t kUnused = static_cast<uint32_t>(-1);
+  std::vector<uint32_t> new_ids(frames_.size(), kUnused);
+  std::vector<Frame> frames;
+  for (StackCounts& window : windows_) {
+    StackCounts renumbered;
+    for (const auto& stack : window) {
+      Stack ids = stack.first;
+      for (uint32_t& id : ids) {
+        if (new_ids[id] == kUnused) {
+          new_ids[id] = frames.size();
+          frames.push_back(std::move(frames_[id]));
+        }
+        id = new_ids[id];
+      }
+      renumbered.emplace(std::move(ids), stack.second);
+    }
+    window.swap(renumbered);
+  }
+
+  frames_.swap(frames);
+  frame_ids_.clear();
+  for (size_t i = 0; i < frames_.size(); i++)
+    frame_ids_.emplace(FrameKey(frames_[i]), i);
+  frames_to_prune_ = std::max(2 * frames_.size(), kMinFramesToPrune);
+}
+
+std::string CpuSampler::Serialize(ProfileFormat format) {
+  Collect();
+
+  StackCounts merged;
+  for (const StackCounts& window : windows_) {
+    for (const auto& stack : window)
+      merged[stack.first] += stack.second;
+  }
+
+  std::string out;
+  if (format == kCollapsed) {
+    // One line per stack, with the frames separated by ';' and followed by
+    // the number of samples, as read by flamegraph.pl and similar tools.
+    for (const auto& stack : merged) {
+      for (size_t i = 0; i < stack.first.size(); i++) {
+        const Frame& frame = frames_[stack.first[i]];
+        if (i > 0)
+          out += ';';
+        out += frame.name;
+        if (!frame.url.empty())
+          out += ' ' + frame.url + ':' + std::to_string(frame.line);
+      }
+      out += ' ' + std::to_string(stack.second) + '\n';
+    }
+    return out;
+  }
+
+  CHECK_EQ(format, kPprof);
+  int64_t period = 1000 * 1000 * 1000 / frequency_;
+  uint64_t duration = std::min<uint64_t>(
+      Elapsed(), windows_.size() * kWindowMs * 1000 * 1000);
+  // The profile ends when the sampler was stopped, or now.
+  uint64_t since_end = profiler_ != nullptr ? 0 : uv_hrtime() - stop_time_;
+  pprof::ProfileBuilder builder;
+  builder.AddSampleType("samples", "count");
+  builder.AddSampleType("cpu", "nanoseconds");
+  builder.SetPeriod("cpu", "nanoseconds", period);
+  builder.SetTime(
+      static_cast<int64_t>(GetCurrentTimeInMicroseconds() * 1000) -
+          since_end - duration,
+      duration);
+
+  std::vector<uint64_t> location_ids(frames_.size(), 0);
+  std::vector<uint64_t> locations;
+  for (const auto& stack : merged) {
+    locations.clear();
+    for (auto it = stack.first.rbegin(); it != stack.first.rend(); ++it) {
+      uint64_t* id = &location_ids[*it];
+      if (*id == 0) {
+        const Frame& frame = frames_[*it];
+        *id = builder.AddLocation(frame.name, frame.url, frame.line);
+      }
+      locations.push_back(*id);
+    }
+    int64_t count = stack.second;
+    builder.AddSample(locations, { count, count * period });
+  }
+  return builder.Serialize();
+}
+
+void CpuSampler::MemoryInfo(MemoryTracker* tracker) const {
+  size_t size = 0;
+  for (const StackCounts& window : windows_) {
+    for (const auto& stack : window)
+      size += sizeof(stack) + stack.first.size() * sizeof(uint32_t);
+  }
+  tracker->TrackFieldWithSize("windows", size);
+  size = 0;
+  for (const Frame& frame : frames_)
+    size += sizeof(frame) + frame.name.size() + frame.url.size();
+  tracker->TrackFieldWithSize("frames", size);
+}
+
+void CpuSampler::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsInt32());
+  CHECK(args[1]->IsInt32());
+  int frequency = args[0].As<Int32>()->Value();
+  int windows = args[1].As<Int32>()->Value();
+  CHECK_GT(frequency, 0);
+  CHECK_GT(windows, 0);
+  new CpuSampler(env, args.This(), frequency, windows);
+}
+
+void CpuSampler::Stop(const FunctionCallbackInfo<Value>& args) {
+  CpuSampler* sampler;
+  ASSIGN_OR_RETURN_UNWRAP(&sampler, args.Holder());
+  sampler->StopSampling();
+}
+
+void CpuSampler::GetProfile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CpuSampler* sampler;
+  ASSIGN_OR_RETURN_UNWRAP(&sampler, args.Holder());
+  CHECK(args[0]->IsInt32());
+  ProfileFormat format =
+      static_cast<ProfileFormat>(args[0].As<Int32>()->Value());
+
+  std::string profile = sampler->Serialize(format);
+  pprof::ReturnProfile(env, args, profile, format == kPprof);
+}
+
+void CpuSampler::WriteProfile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CpuSampler* sampler;
+  ASSIGN_OR_RETURN_UNWRAP(&sampler, args.Holder());
+  CHECK(args[1]->IsInt32());
+  ProfileFormat format =
+      static_cast<ProfileFormat>(args[1].As<Int32>()->Value());
+
+  std::string profile = sampler->Serialize(format);
+  pprof::WriteProfile(env, args, args[0], "CPU", &profile, format == kPprof);
+}
+
+// Returns [samples, droppedSamples, aggregationTime, elapsedTime], with the
+// times in nanoseconds.
+void CpuSampler::GetStatistics(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  CpuSampler* sampler;
+  ASSIGN_OR_RETURN_UNWRAP(&sampler, args.Holder());
+  Local<Value> stats[] = {
+    Number::New(isolate, static_cast<double>(sampler->samples_)),
+    Number::New(isolate, static_cast<double>(sampler->dropped_samples_)),
+    Number::New(isolate, static_cast<double>(sampler->aggregation_time_)),
+    Number::New(isolate, static_cast<double>(sampler->Elapsed()))
+  };
+  args.GetReturnValue().Set(Array::New(isolate, stats, arraysize(stats)));
+}
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+
+  Local<String> classname = FIXED_ONE_BYTE_STRING(env->isolate(), "CpuSampler");
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(CpuSampler::New);
+  t->SetClassName(classname);
+  t->InstanceTemplate()->SetInternalFieldCount(1);
+  env->SetProtoMethod(t, "stop", CpuSampler::Stop);
+  env->SetProtoMethod(t, "getProfile", CpuSampler::GetProfile);
+  env->SetProtoMethod(t, "writeProfile", CpuSampler::WriteProfile);
+  env->SetProtoMethodNoSideEffect(t, "getStatistics",
+                                  CpuSampler::GetStatistics);
+  target->Set(context, classname,
+              t->GetFunction(context).ToLocalChecked()).Check();
+
+  NODE_DEFINE_CONSTANT(target, kCollapsed);
+  NODE_DEFINE_CONSTANT(target, kPprof);
+}
+
+}  // namespace cpu_sampler
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(cpu_sampler, node::cpu_sampler::Initialize)
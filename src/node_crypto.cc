@@ -5851,7 +5851,8 @@ bool ECDH::IsKeyPairValid() {
 struct CryptoJob : public ThreadPoolWork {
   Environment* const env;
   std::unique_ptr<AsyncWrap> async_wrap;
-  inline explicit CryptoJob(Environment* env) : ThreadPoolWork(env), env(env) {}
+  inline CryptoJob(Environment* env, AsyncWrap::ProviderType provider)
+      : ThreadPoolWork(env, provider), env(env) {}
   inline void AfterThreadPoolWork(int status) final;
   virtual void AfterThreadPoolWork() = 0;
   static inline void Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap);
@@ -5894,7 +5895,8 @@ struct RandomBytesJob : public CryptoJob {
   Maybe<int> rc;
 
   inline explicit RandomBytesJob(Environment* env)
-      : CryptoJob(env), rc(Nothing<int>()) {}
+      : CryptoJob(env, AsyncWrap::PROVIDER_RANDOMBYTESREQUEST),
+        rc(Nothing<int>()) {}
 
   inline void DoThreadPoolWork() override {
     CheckEntropy();  // Ensure that OpenSSL's PRNG is properly seeded.
@@ -5944,7 +5946,8 @@ struct PBKDF2Job : public CryptoJob {
   Maybe<bool> success;
 
   inline explicit PBKDF2Job(Environment* env)
-      : CryptoJob(env), success(Nothing<bool>()) {}
+      : CryptoJob(env, AsyncWrap::PROVIDER_PBKDF2REQUEST),
+        success(Nothing<bool>()) {}
 
   inline ~PBKDF2Job() override {
     Cleanse();
@@ -6014,7 +6017,8 @@ struct ScryptJob : public CryptoJob {
   uint32_t maxmem;
   CryptoErrorVector errors;
 
-  inline explicit ScryptJob(Environment* env) : CryptoJob(env) {}
+  inline explicit ScryptJob(Environment* env)
+      : CryptoJob(env, AsyncWrap::PROVIDER_SCRYPTREQUEST) {}
 
   inline ~ScryptJob() override {
     Cleanse();
@@ -6269,7 +6273,7 @@ class GenerateKeyPairJob : public CryptoJob {
                      std::unique_ptr<KeyPairGenerationConfig> config,
                      PublicKeyEncodingConfig public_key_encoding,
                      PrivateKeyEncodingConfig&& private_key_encoding)
-    : CryptoJob(env),
+    : CryptoJob(env, AsyncWrap::PROVIDER_KEYPAIRGENREQUEST),
     config_(std::move(config)),
     public_key_encoding_(public_key_encoding),
     private_key_encoding_(std::forward<PrivateKeyEncodingConfig>(
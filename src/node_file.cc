@@ -23,6 +23,7 @@
 #include "aliased_buffer.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_package_json.h"
 #include "node_process.h"
 #include "node_stat_watcher.h"
 #include "util-inl.h"
@@ -46,6 +47,8 @@
 #endif
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace node {
 
@@ -819,23 +822,19 @@ void Close(const FunctionCallbackInfo<Value>& args) {
 // Used to speed up module loading.  Returns the contents of the file as
 // a string or undefined when the file cannot be opened or "main" is not found
 // in the file.
-static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args);
-  Isolate* isolate = env->isolate();
-  uv_loop_t* loop = env->event_loop();
-
-  CHECK(args[0]->IsString());
-  node::Utf8Value path(isolate, args[0]);
-
-  if (strlen(*path) != path.length())
-    return;  // Contains a nul byte.
-
+// Reads the file at |path| into |chars| without going through the fs.*
+// machinery, and sets |start| past a leading UTF-8 BOM if there is one.
+// Returns false if the file cannot be opened or read.
+static bool ReadModuleFile(uv_loop_t* loop,
+                           const char* path,
+                           std::vector<char>* chars,
+                           size_t* start) {
   uv_fs_t open_req;
-  const int fd = uv_fs_open(loop, &open_req, *path, O_RDONLY, 0, nullptr);
+  const int fd = uv_fs_open(loop, &open_req, path, O_RDONLY, 0, nullptr);
   uv_fs_req_cleanup(&open_req);
 
   if (fd < 0) {
-    return;
+    return false;
   }
 
   std::shared_ptr<void> defer_close(nullptr, [fd, loop] (...) {
@@ -845,15 +844,14 @@ static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
   });
 
   const size_t kBlockSize = 32 << 10;
-  std::vector<char> chars;
   int64_t offset = 0;
   ssize_t numchars;
   do {
-    const size_t start = chars.size();
-    chars.resize(start + kBlockSize);
+    const size_t start = chars->size();
+    chars->resize(start + kBlockSize);
 
     uv_buf_t buf;
-    buf.base = &chars[start];
+    buf.base = chars->data() + start;
     buf.len = kBlockSize;
 
     uv_fs_t read_req;
@@ -861,17 +859,35 @@ static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
     uv_fs_req_cleanup(&read_req);
 
     if (numchars < 0)
-      return;
+      return false;
 
     offset += numchars;
   } while (static_cast<size_t>(numchars) == kBlockSize);
 
-  size_t start = 0;
-  if (offset >= 3 && 0 == memcmp(&chars[0], "\xEF\xBB\xBF", 3)) {
-    start = 3;  // Skip UTF-8 BOM.
+  chars->resize(offset);
+  *start = 0;
+  if (offset >= 3 && 0 == memcmp(chars->data(), "\xEF\xBB\xBF", 3)) {
+    *start = 3;  // Skip UTF-8 BOM.
   }
+  return true;
+}
 
-  const size_t size = offset - start;
+static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsString());
+  node::Utf8Value path(isolate, args[0]);
+
+  if (strlen(*path) != path.length())
+    return;  // Contains a nul byte.
+
+  std::vector<char> chars;
+  size_t start;
+  if (!ReadModuleFile(env->event_loop(), *path, &chars, &start))
+    return;
+
+  const size_t size = chars.size() - start;
   if (size == 0 || size == SearchString(&chars[start], size, "\"main\"")) {
     return;
   } else {
@@ -884,15 +900,91 @@ static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Like InternalModuleReadJSON(), but scans the package.json natively instead
+// of handing the whole source to JSON.parse(). Returns [main], where main is
+// a string or undefined. The CommonJS loader only looks at "main", so the
+// other fields are not converted to JS values.
+//
+// The raw source is returned instead whenever JSON.parse() has to decide the
+// outcome: when the file is not valid JSON (so that the loader reports the
+// same error as before) or when "main" is not a string.
+static void InternalModuleReadPackageJSON(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsString());
+  node::Utf8Value path(isolate, args[0]);
+
+  if (strlen(*path) != path.length())
+    return;  // Contains a nul byte.
+
+  std::vector<char> chars;
+  size_t start;
+  if (!ReadModuleFile(env->event_loop(), *path, &chars, &start))
+    return;
+
+  const size_t size = chars.size() - start;
+  if (size == 0)
+    return;
+
+  using loader::PackageJSONFields;
+  PackageJSONFields fields;
+  const loader::PackageJSONScanResult result =
+      loader::ScanPackageJSON(&chars[start], size, &fields);
+
+  const PackageJSONFields::Value& main = fields[PackageJSONFields::kMain];
+  if (result != loader::PackageJSONScanResult::kOk ||
+      main.kind == PackageJSONFields::Kind::kOther) {
+    if (size == SearchString(&chars[start], size, "\"main\""))
+      return;
+    Local<String> chars_string =
+        String::NewFromUtf8(isolate,
+                            &chars[start],
+                            v8::NewStringType::kNormal,
+                            size).ToLocalChecked();
+    args.GetReturnValue().Set(chars_string);
+    return;
+  }
+
+  Local<Value> values[] = { Undefined(isolate) };
+  if (main.kind == PackageJSONFields::Kind::kString) {
+    values[0] = String::NewFromUtf8(isolate,
+                                    main.string.data(),
+                                    v8::NewStringType::kNormal,
+                                    main.string.size()).ToLocalChecked();
+  }
+  args.GetReturnValue().Set(Array::New(isolate, values, arraysize(values)));
+}
+
+// Results of InternalModuleStat(), shared between all threads. This is only
+// used with --experimental-resolution-cache while a thread is starting up,
+// because the entries are never invalidated automatically; see
+// ClearInternalModuleStatCache(). Failed lookups are not cached, so that
+// files which are created later on are still found.
+static Mutex module_stat_cache_mutex;
+static std::unordered_map<std::string, int> module_stat_cache;
+
 // Used to speed up module loading.  Returns 0 if the path refers to
 // a file, 1 when it's a directory or < 0 on error (usually -ENOENT.)
 // The speedup comes from not creating thousands of Stat and Error objects.
+// The second argument tells whether to use module_stat_cache.
 static void InternalModuleStat(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
   CHECK(args[0]->IsString());
   node::Utf8Value path(env->isolate(), args[0]);
 
+  const bool use_cache = args[1]->IsTrue();
+  std::string key;
+  if (use_cache) {
+    key.assign(*path, path.length());
+    Mutex::ScopedLock lock(module_stat_cache_mutex);
+    auto it = module_stat_cache.find(key);
+    if (it != module_stat_cache.end())
+      return args.GetReturnValue().Set(it->second);
+  }
+
   uv_fs_t req;
   int rc = uv_fs_stat(env->event_loop(), &req, *path, nullptr);
   if (rc == 0) {
@@ -901,9 +993,20 @@ static void InternalModuleStat(const FunctionCallbackInfo<Value>& args) {
   }
   uv_fs_req_cleanup(&req);
 
+  if (use_cache && rc >= 0) {
+    Mutex::ScopedLock lock(module_stat_cache_mutex);
+    module_stat_cache.emplace(std::move(key), rc);
+  }
+
   args.GetReturnValue().Set(rc);
 }
 
+static void ClearInternalModuleStatCache(
+    const FunctionCallbackInfo<Value>& args) {
+  Mutex::ScopedLock lock(module_stat_cache_mutex);
+  module_stat_cache.clear();
+}
+
 static void Stat(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -2170,7 +2273,11 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "mkdir", MKDir);
   env->SetMethod(target, "readdir", ReadDir);
   env->SetMethod(target, "internalModuleReadJSON", InternalModuleReadJSON);
+  env->SetMethod(target, "internalModuleReadPackageJSON",
+                 InternalModuleReadPackageJSON);
   env->SetMethod(target, "internalModuleStat", InternalModuleStat);
+  env->SetMethod(target, "clearInternalModuleStatCache",
+                 ClearInternalModuleStatCache);
   env->SetMethod(target, "stat", Stat);
   env->SetMethod(target, "lstat", LStat);
   env->SetMethod(target, "fstat", FStat);
@@ -192,7 +192,8 @@ v8::MaybeLocal<v8::Value> InternalMakeCallback(
     const v8::Local<v8::Function> callback,
     int argc,
     v8::Local<v8::Value> argv[],
-    async_context asyncContext);
+    async_context asyncContext,
+    v8::Local<v8::Value> context_frame = v8::Local<v8::Value>());
 
 class InternalCallbackScope {
  public:
@@ -207,6 +208,10 @@ class InternalCallbackScope {
   ~InternalCallbackScope();
   void Close();
 
+  // Makes |frame| the current AsyncLocalStorage context frame until the
+  // scope is closed. The caller needs to keep a HandleScope open for that long.
+  void EnterContextFrame(v8::Local<v8::Value> frame);
+
   inline bool Failed() const { return failed_; }
   inline void MarkAsFailed() { failed_ = true; }
 
@@ -214,6 +219,7 @@ class InternalCallbackScope {
   Environment* env_;
   async_context async_context_;
   v8::Local<v8::Object> object_;
+  v8::Local<v8::Value> outer_context_frame_;
   AsyncCallbackScope callback_scope_;
   bool failed_ = false;
   bool pushed_ids_ = false;
@@ -234,9 +240,16 @@ class DebugSealHandleScope {
 #endif
 };
 
+namespace threadpool {
+class WorkerPool;
+}  // namespace threadpool
+
 class ThreadPoolWork {
  public:
-  explicit inline ThreadPoolWork(Environment* env) : env_(env) {
+  // |provider| is the type under which the work is accounted in the
+  // Environment's I/O statistics.
+  inline ThreadPoolWork(Environment* env, AsyncWrap::ProviderType provider)
+      : env_(env), provider_(provider) {
     CHECK_NOT_NULL(env);
   }
   inline virtual ~ThreadPoolWork() = default;
@@ -248,8 +261,26 @@ class ThreadPoolWork {
   virtual void AfterThreadPoolWork(int status) = 0;
 
  private:
+  friend class threadpool::WorkerPool;
+
+  // Called on a thread of |pool_|.
+  inline void RunOnWorkerPool();
+  inline void AfterWork(int status);
+  inline void RecordIOStats();
+
   Environment* env_;
+  AsyncWrap::ProviderType provider_;
   uv_work_t work_req_;
+  // Set if the work runs in one of the per-class threadpools rather than in
+  // libuv's. |done_async_| then signals the end of the work to the loop.
+  threadpool::WorkerPool* pool_ = nullptr;
+  uv_async_t done_async_;
+  int status_ = 0;
+  // Timestamps for the I/O statistics. The latter two are written on the
+  // threadpool thread and read after the work is done.
+  uint64_t queued_at_ = 0;
+  uint64_t started_at_ = 0;
+  uint64_t finished_at_ = 0;
 };
 
 #define TRACING_CATEGORY_NODE "node"
@@ -298,6 +329,12 @@ void SetIsolateUpForNode(v8::Isolate* isolate, IsolateSettingCategories cat);
 void SetIsolateCreateParamsForNode(v8::Isolate::CreateParams* params);
 
 #if HAVE_INSPECTOR
+namespace heap {
+// Blocks until no heap snapshots are serialized on the threadpool anymore.
+// Must be called before heap object tracking is started.
+void WaitForBackgroundSnapshotWrites();
+}  // namespace heap
+
 namespace profiler {
 void StartProfilers(Environment* env);
 void EndStartedProfilers(Environment* env);
@@ -315,6 +352,7 @@ int WriteFileSync(const char* path, uv_buf_t buf);
 int WriteFileSync(v8::Isolate* isolate,
                   const char* path,
                   v8::Local<v8::String> string);
+int ReadFileSync(std::string* result, const char* path);
 
 class DiagnosticFilename {
  public:
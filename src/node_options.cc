@@ -68,6 +68,25 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors) {
                       "used, not both");
   }
 #endif
+  if (build_snapshot && snapshot_blob.empty()) {
+    errors->push_back("--build-snapshot must be used with --snapshot-blob");
+  }
+  if (threadpool_max_size > 128) {
+    errors->push_back("--threadpool-max-size must not be larger than 128");
+  }
+  if (threadpool_addon_size > 128) {
+    errors->push_back("--threadpool-addon-size must not be larger than 128");
+  }
+  if (threadpool_compression_size > 128) {
+    errors->push_back(
+        "--threadpool-compression-size must not be larger than 128");
+  }
+  if (threadpool_crypto_size > 128) {
+    errors->push_back("--threadpool-crypto-size must not be larger than 128");
+  }
+  if (trace_event_format != "json" && trace_event_format != "proto") {
+    errors->push_back("--trace-event-format must be 'json' or 'proto'");
+  }
   per_isolate->CheckOptions(errors);
 }
 
@@ -168,6 +187,29 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors) {
                       "used, not both");
   }
 
+  if (cpu_sampler_frequency < 1 || cpu_sampler_frequency > 10000) {
+    errors->push_back("--cpu-sampler-frequency must be between 1 and 10000");
+  }
+  if (cpu_sampler_duration < 1 || cpu_sampler_duration > 86400) {
+    errors->push_back("--cpu-sampler-duration must be between 1 and 86400");
+  }
+  if (cpu_sampler_format != "collapsed" && cpu_sampler_format != "pprof") {
+    errors->push_back("--cpu-sampler-format must be 'collapsed' or 'pprof'");
+  }
+  if (!cpu_sampler && !cpu_sampler_signal.empty()) {
+    errors->push_back("--cpu-sampler-signal must be used with --cpu-sampler");
+  }
+  if (heap_sampler_interval < 1 || heap_sampler_interval > INT32_MAX) {
+    errors->push_back("--heap-sampler-interval must be between 1 and "
+                      "2147483647");
+  }
+  if (heap_sampler_format != "collapsed" && heap_sampler_format != "pprof") {
+    errors->push_back("--heap-sampler-format must be 'collapsed' or 'pprof'");
+  }
+  if (!heap_sampler && !heap_sampler_signal.empty()) {
+    errors->push_back("--heap-sampler-signal must be used with --heap-sampler");
+  }
+
 #if HAVE_INSPECTOR
   if (!cpu_prof) {
     if (!cpu_prof_name.empty()) {
@@ -195,6 +237,9 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors) {
     if (heap_prof_interval != kDefaultHeapProfInterval) {
       errors->push_back("--heap-prof-interval must be used with --heap-prof");
     }
+  } else if (heap_sampler) {
+    // Both use the single sampling heap profiler of the isolate.
+    errors->push_back("--heap-sampler cannot be used with --heap-prof");
   }
   debug_options_.CheckOptions(errors);
 #endif  // HAVE_INSPECTOR
@@ -300,6 +345,11 @@ DebugOptionsParser::DebugOptionsParser() {
 }
 
 EnvironmentOptionsParser::EnvironmentOptionsParser() {
+  AddOption("--experimental-code-cache",
+            "cache compiled code for user modules in the specified "
+            "directory",
+            &EnvironmentOptions::experimental_code_cache,
+            kAllowedInEnvironment);
   AddOption("--experimental-modules",
             "experimental ES Module support and caching modules",
             &EnvironmentOptions::experimental_modules,
@@ -317,6 +367,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental await keyword support in REPL",
             &EnvironmentOptions::experimental_repl_await,
             kAllowedInEnvironment);
+  AddOption("--experimental-resolution-cache",
+            "load CommonJS module resolutions from the specified file "
+            "and write new ones back to it on exit",
+            &EnvironmentOptions::experimental_resolution_cache,
+            kAllowedInEnvironment);
   AddOption("--experimental-vm-modules",
             "experimental ES Module support in vm module",
             &EnvironmentOptions::experimental_vm_modules,
@@ -385,6 +440,48 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             &EnvironmentOptions::prof_process);
   // Options after --prof-process are passed through to the prof processor.
   AddAlias("--prof-process", { "--prof-process", "--" });
+  AddOption("--cpu-sampler",
+            "keep a low-frequency CPU sampler running that aggregates the "
+            "stacks of the last --cpu-sampler-duration seconds",
+            &EnvironmentOptions::cpu_sampler,
+            kAllowedInEnvironment);
+  AddOption("--cpu-sampler-frequency",
+            "sampling frequency in Hz of the CPU sampler (default: 99)",
+            &EnvironmentOptions::cpu_sampler_frequency,
+            kAllowedInEnvironment);
+  AddOption("--cpu-sampler-duration",
+            "number of seconds of samples kept by the CPU sampler "
+            "(default: 60)",
+            &EnvironmentOptions::cpu_sampler_duration,
+            kAllowedInEnvironment);
+  AddOption("--cpu-sampler-format",
+            "format of profiles written on --cpu-sampler-signal, "
+            "'collapsed' (default) or 'pprof'",
+            &EnvironmentOptions::cpu_sampler_format,
+            kAllowedInEnvironment);
+  AddOption("--cpu-sampler-signal",
+            "write the profile of the CPU sampler on the specified signal",
+            &EnvironmentOptions::cpu_sampler_signal,
+            kAllowedInEnvironment);
+  AddOption("--heap-sampler",
+            "keep a sampling heap profiler running that tracks the stacks "
+            "of live sampled allocations",
+            &EnvironmentOptions::heap_sampler,
+            kAllowedInEnvironment);
+  AddOption("--heap-sampler-interval",
+            "average sampling interval in bytes of the heap sampler "
+            "(default: 512 * 1024)",
+            &EnvironmentOptions::heap_sampler_interval,
+            kAllowedInEnvironment);
+  AddOption("--heap-sampler-format",
+            "format of profiles written on --heap-sampler-signal, "
+            "'collapsed' (default) or 'pprof'",
+            &EnvironmentOptions::heap_sampler_format,
+            kAllowedInEnvironment);
+  AddOption("--heap-sampler-signal",
+            "write the profile of the heap sampler on the specified signal",
+            &EnvironmentOptions::heap_sampler_signal,
+            kAllowedInEnvironment);
 #if HAVE_INSPECTOR
   AddOption("--cpu-prof",
             "Start the V8 CPU profiler on start up, and write the CPU profile "
@@ -430,6 +527,12 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "throw an exception on deprecations",
             &EnvironmentOptions::throw_deprecation,
             kAllowedInEnvironment);
+  AddOption("--timer-slack",
+            "let the idle timeouts of sockets fire up to this many "
+            "milliseconds late, so that they can be grouped together "
+            "(default: 0)",
+            &EnvironmentOptions::timer_slack,
+            kAllowedInEnvironment);
   AddOption("--trace-deprecation",
             "show stack traces on deprecations",
             &EnvironmentOptions::trace_deprecation,
@@ -591,6 +694,16 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "data, it supports ${rotation} and ${pid}.",
             &PerProcessOptions::trace_event_file_pattern,
             kAllowedInEnvironment);
+  AddOption("--trace-event-format",
+            "format of the trace-events data, 'json' (default) or 'proto' "
+            "for a Perfetto protobuf trace",
+            &PerProcessOptions::trace_event_format,
+            kAllowedInEnvironment);
+  AddOption("--trace-event-file-size",
+            "rotate trace-events files once they reach about this many "
+            "bytes (default: 0, no size limit)",
+            &PerProcessOptions::trace_event_file_size,
+            kAllowedInEnvironment);
   AddAlias("--trace-events-enabled", {
     "--trace-event-categories", "v8,node,node.async_hooks" });
   AddOption("--max-http-header-size",
@@ -601,6 +714,40 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "set V8's thread pool size",
             &PerProcessOptions::v8_thread_pool_size,
             kAllowedInEnvironment);
+  AddOption("--threadpool-max-size",
+            "let the libuv threadpool grow up to this many threads while "
+            "work is queuing up",
+            &PerProcessOptions::threadpool_max_size,
+            kAllowedInEnvironment);
+  AddOption("--threadpool-addon-size",
+            "run N-API async work in this many threads of its own instead "
+            "of in the libuv threadpool",
+            &PerProcessOptions::threadpool_addon_size,
+            kAllowedInEnvironment);
+  AddOption("--threadpool-compression-size",
+            "run zlib work in this many threads of its own instead of in "
+            "the libuv threadpool",
+            &PerProcessOptions::threadpool_compression_size,
+            kAllowedInEnvironment);
+  AddOption("--threadpool-crypto-size",
+            "run crypto work in this many threads of its own instead of in "
+            "the libuv threadpool",
+            &PerProcessOptions::threadpool_crypto_size,
+            kAllowedInEnvironment);
+  AddOption("--dns-cache-size",
+            "cache up to this many dns.lookup() and resolver results",
+            &PerProcessOptions::dns_cache_size,
+            kAllowedInEnvironment);
+  AddOption("--dns-cache-lookup-ttl",
+            "seconds for which dns.lookup() results are cached "
+            "(default: 10)",
+            &PerProcessOptions::dns_cache_lookup_ttl,
+            kAllowedInEnvironment);
+  AddOption("--dns-cache-negative-ttl",
+            "seconds for which failed DNS lookups and queries are cached "
+            "(default: 5)",
+            &PerProcessOptions::dns_cache_negative_ttl,
+            kAllowedInEnvironment);
   AddOption("--zero-fill-buffers",
             "automatically zero-fill all newly allocated Buffer and "
             "SlowBuffer instances",
@@ -610,6 +757,14 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "", /* undocumented, only for debugging */
             &PerProcessOptions::debug_arraybuffer_allocations,
             kAllowedInEnvironment);
+  AddOption("--snapshot-blob",
+            "start from the heap snapshot in the specified file, or with "
+            "--build-snapshot, the file to write the snapshot to",
+            &PerProcessOptions::snapshot_blob);
+  AddOption("--build-snapshot",
+            "run the entry point script and write a snapshot of the "
+            "resulting heap to the --snapshot-blob file (experimental)",
+            &PerProcessOptions::build_snapshot);
 
   AddOption("--security-reverts", "", &PerProcessOptions::security_reverts);
   AddOption("--completion-bash",
@@ -100,12 +100,14 @@ class DebugOptions : public Options {
 class EnvironmentOptions : public Options {
  public:
   bool abort_on_uncaught_exception = false;
+  std::string experimental_code_cache;
   bool experimental_modules = false;
   std::string es_module_specifier_resolution;
   bool experimental_wasm_modules = false;
   std::string module_type;
   std::string experimental_policy;
   bool experimental_repl_await = false;
+  std::string experimental_resolution_cache;
   bool experimental_vm_modules = false;
   bool expose_internals = false;
   bool frozen_intrinsics = false;
@@ -118,6 +120,18 @@ class EnvironmentOptions : public Options {
   bool preserve_symlinks = false;
   bool preserve_symlinks_main = false;
   bool prof_process = false;
+  bool cpu_sampler = false;
+  static const uint64_t kDefaultCpuSamplerFrequency = 99;
+  uint64_t cpu_sampler_frequency = kDefaultCpuSamplerFrequency;
+  static const uint64_t kDefaultCpuSamplerDuration = 60;
+  uint64_t cpu_sampler_duration = kDefaultCpuSamplerDuration;
+  std::string cpu_sampler_format = "collapsed";
+  std::string cpu_sampler_signal;
+  bool heap_sampler = false;
+  static const uint64_t kDefaultHeapSamplerInterval = 512 * 1024;
+  uint64_t heap_sampler_interval = kDefaultHeapSamplerInterval;
+  std::string heap_sampler_format = "collapsed";
+  std::string heap_sampler_signal;
 #if HAVE_INSPECTOR
   std::string cpu_prof_dir;
   static const uint64_t kDefaultCpuProfInterval = 1000;
@@ -132,6 +146,7 @@ class EnvironmentOptions : public Options {
 #endif  // HAVE_INSPECTOR
   std::string redirect_warnings;
   bool throw_deprecation = false;
+  uint64_t timer_slack = 0;
   bool trace_deprecation = false;
   bool trace_sync_io = false;
   bool trace_tls = false;
@@ -191,10 +206,21 @@ class PerProcessOptions : public Options {
   std::string title;
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
+  std::string trace_event_format = "json";
+  uint64_t trace_event_file_size = 0;
   uint64_t max_http_header_size = 8 * 1024;
   int64_t v8_thread_pool_size = 4;
+  uint64_t threadpool_max_size = 0;
+  uint64_t threadpool_addon_size = 0;
+  uint64_t threadpool_compression_size = 0;
+  uint64_t threadpool_crypto_size = 0;
+  uint64_t dns_cache_size = 0;
+  uint64_t dns_cache_lookup_ttl = 10;
+  uint64_t dns_cache_negative_ttl = 5;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
+  std::string snapshot_blob;
+  bool build_snapshot = false;
 
   std::vector<std::string> security_reverts;
   bool print_bash_completion = false;
@@ -0,0 +1,274 @@
+#include "node_package_json.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace node {
+namespace loader {
+
+namespace {
+
+// Deeper documents are handed back to JSON.parse(), which keeps the scanner
+// free of recursion limits of its own.
+constexpr int kMaxDepth = 128;
+
+class PackageJSONScanner {
+ public:
+  PackageJSONScanner(const char* data, size_t size)
+      : p_(data), end_(data + size) {}
+
+  PackageJSONScanResult Scan(PackageJSONFields* fields) {
+    SkipWhitespace();
+    if (p_ < end_ && *p_ == '{') {
+      if (!ScanTopLevelObject(fields)) return Result();
+    } else {
+      const char* start = p_;
+      if (!SkipValue(0)) return Result();
+      fields->is_null = (p_ - start == 4 && memcmp(start, "null", 4) == 0);
+    }
+    SkipWhitespace();
+    if (p_ != end_) return PackageJSONScanResult::kInvalid;
+    return PackageJSONScanResult::kOk;
+  }
+
+ private:
+  PackageJSONScanResult Result() const {
+    return too_deep_ ? PackageJSONScanResult::kTooDeep :
+                       PackageJSONScanResult::kInvalid;
+  }
+
+  void SkipWhitespace() {
+    while (p_ < end_ &&
+           (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) {
+      p_++;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (p_ == end_ || *p_ != c) return false;
+    p_++;
+    return true;
+  }
+
+  static int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  }
+
+  bool ReadHex4(uint32_t* value) {
+    if (end_ - p_ < 4) return false;
+    uint32_t result = 0;
+    for (int i = 0; i < 4; i++) {
+      const int digit = HexValue(p_[i]);
+      if (digit < 0) return false;
+      result = (result << 4) | digit;
+    }
+    p_ += 4;
+    *value = result;
+    return true;
+  }
+
+  static void AppendUtf8(std::string* out, uint32_t code_point) {
+    if (code_point < 0x80) {
+      out->push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      out->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+      out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+      out->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+      out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+      out->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+      out->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+  }
+
+  // Expects p_ to point at the opening quote. When |out| is nullptr the
+  // string is only validated.
+  bool ScanString(std::string* out) {
+    p_++;
+    for (;;) {
+      const char* run = p_;
+      while (p_ < end_ && *p_ != '"' && *p_ != '\\' &&
+             static_cast<unsigned char>(*p_) >= 0x20) {
+        p_++;
+      }
+      if (out != nullptr) out->append(run, p_ - run);
+      if (p_ == end_ || static_cast<unsigned char>(*p_) < 0x20) return false;
+      if (*p_++ == '"') return true;
+
+      // Escape sequence.
+      if (p_ == end_) return false;
+      char c = *p_++;
+      switch (c) {
+        case '"': case '\\': case '/': break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u': {
+          uint32_t code_point;
+          if (!ReadHex4(&code_point)) return false;
+          if (code_point >= 0xD800 && code_point <= 0xDBFF &&
+              end_ - p_ >= 6 && p_[0] == '\\' && p_[1] == 'u') {
+            const char* saved = p_;
+            uint32_t low;
+            p_ += 2;
+            if (!ReadHex4(&low)) return false;
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+              code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                           (low - 0xDC00);
+            } else {
+              p_ = saved;
+            }
+          }
+          // Lone surrogates become U+FFFD, which is what converting the
+          // JSON.parse() result to UTF-8 would produce.
+          if (code_point >= 0xD800 && code_point <= 0xDFFF)
+            code_point = 0xFFFD;
+          if (out != nullptr) AppendUtf8(out, code_point);
+          continue;
+        }
+        default:
+          return false;
+      }
+      if (out != nullptr) out->push_back(c);
+    }
+  }
+
+  bool SkipDigits() {
+    const char* start = p_;
+    while (p_ < end_ && *p_ >= '0' && *p_ <= '9') p_++;
+    return p_ != start;
+  }
+
+  bool SkipNumber() {
+    if (*p_ == '-') p_++;
+    if (p_ == end_) return false;
+    if (*p_ == '0') {
+      p_++;
+    } else if (!SkipDigits()) {
+      return false;
+    }
+    if (p_ < end_ && *p_ == '.') {
+      p_++;
+      if (!SkipDigits()) return false;
+    }
+    if (p_ < end_ && (*p_ == 'e' || *p_ == 'E')) {
+      p_++;
+      if (p_ < end_ && (*p_ == '+' || *p_ == '-')) p_++;
+      if (!SkipDigits()) return false;
+    }
+    return true;
+  }
+
+  bool SkipLiteral(const char* literal, size_t length) {
+    if (static_cast<size_t>(end_ - p_) < length ||
+        memcmp(p_, literal, length) != 0) {
+      return false;
+    }
+    p_ += length;
+    return true;
+  }
+
+  bool SkipValue(int depth) {
+    SkipWhitespace();
+    if (p_ == end_) return false;
+    switch (*p_) {
+      case '"':
+        return ScanString(nullptr);
+      case '{':
+      case '[': {
+        const char close = *p_ == '{' ? '}' : ']';
+        if (depth >= kMaxDepth) {
+          too_deep_ = true;
+          return false;
+        }
+        p_++;
+        if (Consume(close)) return true;
+        do {
+          if (close == '}') {
+            SkipWhitespace();
+            if (p_ == end_ || *p_ != '"' || !ScanString(nullptr) ||
+                !Consume(':')) {
+              return false;
+            }
+          }
+          if (!SkipValue(depth + 1)) return false;
+        } while (Consume(','));
+        return Consume(close);
+      }
+      case 't':
+        return SkipLiteral("true", 4);
+      case 'f':
+        return SkipLiteral("false", 5);
+      case 'n':
+        return SkipLiteral("null", 4);
+      default:
+        return SkipNumber();
+    }
+  }
+
+  static int FieldForKey(const std::string& key) {
+    if (key == "main") return PackageJSONFields::kMain;
+    if (key == "name") return PackageJSONFields::kName;
+    if (key == "type") return PackageJSONFields::kType;
+    if (key == "exports") return PackageJSONFields::kExports;
+    return -1;
+  }
+
+  bool ScanTopLevelObject(PackageJSONFields* fields) {
+    p_++;
+    if (Consume('}')) return true;
+    std::string key;
+    do {
+      SkipWhitespace();
+      if (p_ == end_ || *p_ != '"') return false;
+      key.clear();
+      if (!ScanString(&key) || !Consume(':')) return false;
+
+      const int field = FieldForKey(key);
+      if (field < 0) {
+        if (!SkipValue(1)) return false;
+        continue;
+      }
+
+      PackageJSONFields::Value* value = &fields->fields[field];
+      value->string.clear();
+      SkipWhitespace();
+      const char* start = p_;
+      if (p_ < end_ && *p_ == '"') {
+        value->kind = PackageJSONFields::Kind::kString;
+        if (!ScanString(&value->string)) return false;
+      } else {
+        value->kind = PackageJSONFields::Kind::kOther;
+        if (!SkipValue(1)) return false;
+      }
+      value->source.assign(start, p_ - start);
+    } while (Consume(','));
+    return Consume('}');
+  }
+
+  const char* p_;
+  const char* const end_;
+  bool too_deep_ = false;
+};
+
+}  // anonymous namespace
+
+PackageJSONScanResult ScanPackageJSON(const char* data,
+                                      size_t size,
+                                      PackageJSONFields* fields) {
+  PackageJSONScanner scanner(data, size);
+  return scanner.Scan(fields);
+}
+
+}  // namespace loader
+}  // namespace node
@@ -0,0 +1,57 @@
+#ifndef SRC_NODE_PACKAGE_JSON_H_
+#define SRC_NODE_PACKAGE_JSON_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <string>
+
+namespace node {
+namespace loader {
+
+// The subset of package.json that the module loaders look at. Only top-level
+// keys are collected; everything else in the document is validated and then
+// skipped without being materialized.
+struct PackageJSONFields {
+  enum Field { kMain, kName, kType, kExports, kFieldCount };
+  enum class Kind { kMissing, kString, kOther };
+
+  struct Value {
+    Kind kind = Kind::kMissing;
+    // The unescaped contents when kind == kString.
+    std::string string;
+    // The JSON source text of the value, for any kind other than kMissing.
+    std::string source;
+  };
+
+  // True when the document is the literal `null`, which cannot be converted
+  // to an object.
+  bool is_null = false;
+  Value fields[kFieldCount];
+
+  const Value& operator[](Field field) const { return fields[field]; }
+};
+
+enum class PackageJSONScanResult {
+  kOk,
+  // The input is not valid JSON, i.e. JSON.parse() would throw.
+  kInvalid,
+  // The input nests deeper than the scanner is willing to follow. Callers
+  // should fall back to a full JSON.parse().
+  kTooDeep,
+};
+
+// Validates |data| as JSON and extracts the fields listed above in a single
+// pass, following JSON.parse() semantics (e.g. the last duplicate key wins).
+// A leading byte order mark is not skipped, callers should strip it first
+// if they want to accept one.
+PackageJSONScanResult ScanPackageJSON(const char* data,
+                                      size_t size,
+                                      PackageJSONFields* fields);
+
+}  // namespace loader
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_PACKAGE_JSON_H_
@@ -32,6 +32,7 @@ using v8::Object;
 using v8::PropertyAttribute;
 using v8::ReadOnly;
 using v8::String;
+using v8::Uint32;
 using v8::Uint32Array;
 using v8::Value;
 
@@ -530,6 +531,178 @@ bool ELDHistogram::Disable() {
   return true;
 }
 
+// Event Loop Phase Histograms
+namespace {
+static Histogram* GetPhaseHistogram(const FunctionCallbackInfo<Value>& args) {
+  LoopPhaseProfiler* profiler;
+  ASSIGN_OR_RETURN_UNWRAP(&profiler, args.Holder(), nullptr);
+  CHECK(args[0]->IsUint32());
+  uint32_t phase = args[0].As<Uint32>()->Value();
+  CHECK_LT(phase, NODE_PERFORMANCE_LOOP_PHASE_INVALID);
+  return profiler->histogram(static_cast<PerformanceLoopPhase>(phase));
+}
+
+static void LoopPhaseProfilerMin(const FunctionCallbackInfo<Value>& args) {
+  Histogram* histogram = GetPhaseHistogram(args);
+  if (histogram == nullptr) return;
+  args.GetReturnValue().Set(static_cast<double>(histogram->Min()));
+}
+
+static void LoopPhaseProfilerMax(const FunctionCallbackInfo<Value>& args) {
+  Histogram* histogram = GetPhaseHistogram(args);
+  if (histogram == nullptr) return;
+  args.GetReturnValue().Set(static_cast<double>(histogram->Max()));
+}
+
+static void LoopPhaseProfilerMean(const FunctionCallbackInfo<Value>& args) {
+  Histogram* histogram = GetPhaseHistogram(args);
+  if (histogram == nullptr) return;
+  args.GetReturnValue().Set(histogram->Mean());
+}
+
+static void LoopPhaseProfilerStddev(const FunctionCallbackInfo<Value>& args) {
+  Histogram* histogram = GetPhaseHistogram(args);
+  if (histogram == nullptr) return;
+  args.GetReturnValue().Set(histogram->Stddev());
+}
+
+static void LoopPhaseProfilerPercentile(
+    const FunctionCallbackInfo<Value>& args) {
+  Histogram* histogram = GetPhaseHistogram(args);
+  if (histogram == nullptr) return;
+  CHECK(args[1]->IsNumber());
+  double percentile = args[1].As<Number>()->Value();
+  args.GetReturnValue().Set(histogram->Percentile(percentile));
+}
+
+static void LoopPhaseProfilerPercentiles(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Histogram* histogram = GetPhaseHistogram(args);
+  if (histogram == nullptr) return;
+  CHECK(args[1]->IsMap());
+  Local<Map> map = args[1].As<Map>();
+  histogram->Percentiles([&](double key, double value) {
+    map->Set(env->context(),
+             Number::New(env->isolate(), key),
+             Number::New(env->isolate(), value)).IsEmpty();
+  });
+}
+
+static void LoopPhaseProfilerEnable(const FunctionCallbackInfo<Value>& args) {
+  LoopPhaseProfiler* profiler;
+  ASSIGN_OR_RETURN_UNWRAP(&profiler, args.Holder());
+  args.GetReturnValue().Set(profiler->Enable());
+}
+
+static void LoopPhaseProfilerDisable(const FunctionCallbackInfo<Value>& args) {
+  LoopPhaseProfiler* profiler;
+  ASSIGN_OR_RETURN_UNWRAP(&profiler, args.Holder());
+  args.GetReturnValue().Set(profiler->Disable());
+}
+
+static void LoopPhaseProfilerReset(const FunctionCallbackInfo<Value>& args) {
+  LoopPhaseProfiler* profiler;
+  ASSIGN_OR_RETURN_UNWRAP(&profiler, args.Holder());
+  profiler->ResetState();
+}
+
+static void LoopPhaseProfilerNew(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  new LoopPhaseProfiler(env, args.This());
+}
+}  // namespace
+
+LoopPhaseProfiler::LoopPhaseProfiler(Environment* env, Local<Object> wrap)
+    : BaseObject(env, wrap) {
+  MakeWeak();
+  for (std::unique_ptr<Histogram>& histogram : histograms_)
+    histogram.reset(new Histogram(1, 3.6e12));
+  prepare_ = new uv_prepare_t();
+  uv_prepare_init(env->event_loop(), prepare_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(prepare_));
+  prepare_->data = this;
+}
+
+LoopPhaseProfiler::~LoopPhaseProfiler() {
+  Disable();
+  env()->CloseHandle(prepare_, [](uv_prepare_t* handle) { delete handle; });
+}
+
+bool LoopPhaseProfiler::Enable() {
+  if (env()->loop_phase_profiler() != nullptr) return false;
+  env()->set_loop_phase_profiler(this);
+  in_poll_ = false;
+  check_end_ = 0;
+  timers_time_ = 0;
+  uv_prepare_start(prepare_, OnPrepare);
+  return true;
+}
+
+bool LoopPhaseProfiler::Disable() {
+  if (env()->loop_phase_profiler() != this) return false;
+  env()->set_loop_phase_profiler(nullptr);
+  uv_prepare_stop(prepare_);
+  return true;
+}
+
+void LoopPhaseProfiler::ResetState() {
+  for (std::unique_ptr<Histogram>& histogram : histograms_)
+    histogram->Reset();
+}
+
+void LoopPhaseProfiler::Record(PerformanceLoopPhase phase, int64_t duration) {
+  histograms_[phase]->Record(duration > 0 ? duration : 0);
+}
+
+void LoopPhaseProfiler::OnPrepare(uv_prepare_t* handle) {
+  LoopPhaseProfiler* profiler = static_cast<LoopPhaseProfiler*>(handle->data);
+  uint64_t now = uv_hrtime();
+  if (profiler->check_end_ != 0) {
+    profiler->Record(NODE_PERFORMANCE_LOOP_PHASE_OTHER,
+                     now - profiler->check_end_ - profiler->timers_time_);
+  }
+  profiler->timers_time_ = 0;
+  profiler->in_poll_ = true;
+  profiler->poll_start_ = now;
+  profiler->first_callback_ = 0;
+}
+
+void LoopPhaseProfiler::OnCallback() {
+  if (in_poll_ && first_callback_ == 0)
+    first_callback_ = uv_hrtime();
+}
+
+void LoopPhaseProfiler::EnterPhase(PerformanceLoopPhase phase, uint64_t now) {
+  if (phase != NODE_PERFORMANCE_LOOP_PHASE_CHECK || !in_poll_)
+    return;
+  // The check phase follows the poll phase directly.
+  uint64_t first_callback = first_callback_ != 0 ? first_callback_ : now;
+  Record(NODE_PERFORMANCE_LOOP_PHASE_POLL_WAIT, first_callback - poll_start_);
+  Record(NODE_PERFORMANCE_LOOP_PHASE_POLL, now - first_callback);
+  in_poll_ = false;
+}
+
+void LoopPhaseProfiler::ExitPhase(PerformanceLoopPhase phase,
+                                  uint64_t start,
+                                  uint64_t now) {
+  Record(phase, now - start);
+  if (phase == NODE_PERFORMANCE_LOOP_PHASE_TIMERS) {
+    timers_time_ += now - start;
+  } else if (phase == NODE_PERFORMANCE_LOOP_PHASE_CHECK) {
+    check_end_ = now;
+    timers_time_ = 0;
+  }
+}
+
+void LoopPhaseProfiler::MemoryInfo(MemoryTracker* tracker) const {
+  size_t size = 0;
+  for (const std::unique_ptr<Histogram>& histogram : histograms_)
+    size += histogram->GetMemorySize();
+  tracker->TrackFieldWithSize("histograms", size);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -544,6 +717,9 @@ void Initialize(Local<Object> target,
   target->Set(context,
               FIXED_ONE_BYTE_STRING(isolate, "milestones"),
               state->milestones.GetJSArray()).Check();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "ioStats"),
+              state->io_stats.GetJSArray()).Check();
 
   Local<String> performanceEntryString =
       FIXED_ONE_BYTE_STRING(isolate, "PerformanceEntry");
@@ -580,6 +756,17 @@ void Initialize(Local<Object> target,
   NODE_PERFORMANCE_MILESTONES(V)
 #undef V
 
+#define V(name, _)                                                            \
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_LOOP_PHASE_##name);
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+
+#define V(name, _)                                                            \
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_IO_STAT_##name);
+  NODE_PERFORMANCE_IO_STATS(V)
+#undef V
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_IO_STAT_INVALID);
+
   PropertyAttribute attr =
       static_cast<PropertyAttribute>(ReadOnly | DontDelete);
 
@@ -616,6 +803,24 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(eldh, "reset", ELDHistogramReset);
   target->Set(context, eldh_classname,
               eldh->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  Local<String> lpp_classname =
+      FIXED_ONE_BYTE_STRING(isolate, "LoopPhaseProfiler");
+  Local<FunctionTemplate> lpp =
+      env->NewFunctionTemplate(LoopPhaseProfilerNew);
+  lpp->SetClassName(lpp_classname);
+  lpp->InstanceTemplate()->SetInternalFieldCount(1);
+  env->SetProtoMethod(lpp, "min", LoopPhaseProfilerMin);
+  env->SetProtoMethod(lpp, "max", LoopPhaseProfilerMax);
+  env->SetProtoMethod(lpp, "mean", LoopPhaseProfilerMean);
+  env->SetProtoMethod(lpp, "stddev", LoopPhaseProfilerStddev);
+  env->SetProtoMethod(lpp, "percentile", LoopPhaseProfilerPercentile);
+  env->SetProtoMethod(lpp, "percentiles", LoopPhaseProfilerPercentiles);
+  env->SetProtoMethod(lpp, "enable", LoopPhaseProfilerEnable);
+  env->SetProtoMethod(lpp, "disable", LoopPhaseProfilerDisable);
+  env->SetProtoMethod(lpp, "reset", LoopPhaseProfilerReset);
+  target->Set(context, lpp_classname,
+              lpp->GetFunction(env->context()).ToLocalChecked()).Check();
 }
 
 }  // namespace performance
@@ -12,6 +12,7 @@
 #include "v8.h"
 #include "uv.h"
 
+#include <memory>
 #include <string>
 
 namespace node {
@@ -158,6 +159,84 @@ class ELDHistogram : public BaseObject, public Histogram {
   uv_timer_t* timer_;
 };
 
+// Records how long each phase of the event loop takes, in nanoseconds, with
+// one histogram per PerformanceLoopPhase. Phases are delimited by a prepare
+// handle, which runs right before libuv polls for I/O, and by the callbacks
+// that Node.js itself runs from the loop (see LoopPhaseScope). The time
+// between the start of the poll phase and the first callback into
+// JavaScript counts as waiting for I/O.
+//
+// At most one profiler is enabled per Environment. While none is, the
+// instrumentation costs a single pointer comparison.
+class LoopPhaseProfiler : public BaseObject {
+ public:
+  LoopPhaseProfiler(Environment* env, Local<Object> wrap);
+  ~LoopPhaseProfiler() override;
+
+  bool Enable();
+  bool Disable();
+  void ResetState();
+  Histogram* histogram(PerformanceLoopPhase phase) {
+    return histograms_[phase].get();
+  }
+
+  // Called at the start of every callback into JavaScript that is not nested
+  // in another one.
+  void OnCallback();
+  void EnterPhase(PerformanceLoopPhase phase, uint64_t now);
+  void ExitPhase(PerformanceLoopPhase phase, uint64_t start, uint64_t now);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+
+  SET_MEMORY_INFO_NAME(LoopPhaseProfiler)
+  SET_SELF_SIZE(LoopPhaseProfiler)
+
+ private:
+  static void OnPrepare(uv_prepare_t* handle);
+  void Record(PerformanceLoopPhase phase, int64_t duration);
+
+  std::unique_ptr<Histogram> histograms_[NODE_PERFORMANCE_LOOP_PHASE_INVALID];
+  uv_prepare_t* prepare_;
+  bool in_poll_ = false;
+  uint64_t poll_start_ = 0;
+  uint64_t first_callback_ = 0;
+  // When the previous check phase ended, and how much of the time since
+  // then was spent running timers.
+  uint64_t check_end_ = 0;
+  uint64_t timers_time_ = 0;
+};
+
+// Attributes the time until it goes out of scope to |phase|, if a
+// LoopPhaseProfiler is enabled.
+class LoopPhaseScope {
+ public:
+  inline LoopPhaseScope(Environment* env, PerformanceLoopPhase phase);
+  inline ~LoopPhaseScope();
+
+  LoopPhaseScope(const LoopPhaseScope&) = delete;
+  LoopPhaseScope& operator=(const LoopPhaseScope&) = delete;
+
+ private:
+  Environment* env_;
+  LoopPhaseProfiler* profiler_;
+  PerformanceLoopPhase phase_;
+  uint64_t start_ = 0;
+};
+
+LoopPhaseScope::LoopPhaseScope(Environment* env, PerformanceLoopPhase phase)
+    : env_(env), profiler_(env->loop_phase_profiler()), phase_(phase) {
+  if (profiler_ == nullptr) return;
+  start_ = uv_hrtime();
+  profiler_->EnterPhase(phase_, start_);
+}
+
+LoopPhaseScope::~LoopPhaseScope() {
+  // The profiler may have been disabled in the meantime.
+  if (profiler_ == nullptr || env_->loop_phase_profiler() != profiler_)
+    return;
+  profiler_->ExitPhase(phase_, start_, uv_hrtime());
+}
+
 }  // namespace performance
 }  // namespace node
 
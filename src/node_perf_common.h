@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "async_wrap.h"
 #include "node.h"
 #include "uv.h"
 #include "v8.h"
@@ -37,6 +38,53 @@ extern uint64_t performance_v8_start;
   V(FUNCTION, "function")                                                     \
   V(HTTP2, "http2")
 
+// The parts of an event loop iteration that LoopPhaseProfiler tells apart.
+// OTHER covers pending callbacks, idle and prepare handles and close
+// callbacks. NEXT_TICK measures the nextTick and microtask queue drains that
+// follow callbacks into JavaScript, and overlaps with the other phases.
+#define NODE_PERFORMANCE_LOOP_PHASES(V)                                       \
+  V(TIMERS, "timers")                                                         \
+  V(OTHER, "other")                                                           \
+  V(POLL_WAIT, "pollWait")                                                    \
+  V(POLL, "poll")                                                             \
+  V(CHECK, "check")                                                           \
+  V(NEXT_TICK, "nextTick")
+
+// Counters kept for each AsyncWrap provider type. Times are in nanoseconds.
+// CALLBACK_TIME is the time spent in callbacks made through
+// AsyncWrap::MakeCallback(), REQUEST_TIME the time from dispatching a libuv
+// request until its completion, and THREADPOOL_QUEUE_TIME and
+// THREADPOOL_RUN_TIME split the time ThreadPoolWork spends in the threadpool
+// into waiting for a thread and running on it. WRITES counts the buffers
+// written to streams, and WRITE_SYSCALLS the system calls that libuv
+// streams needed for them.
+#define NODE_PERFORMANCE_IO_STATS(V)                                          \
+  V(CALLBACKS, "callbacks")                                                   \
+  V(CALLBACK_TIME, "callbackTime")                                            \
+  V(REQUESTS, "requests")                                                     \
+  V(REQUEST_TIME, "requestTime")                                              \
+  V(BYTES_READ, "bytesRead")                                                  \
+  V(BYTES_WRITTEN, "bytesWritten")                                            \
+  V(WRITES, "writes")                                                         \
+  V(WRITE_SYSCALLS, "writeSyscalls")                                          \
+  V(THREADPOOL_REQUESTS, "threadpoolRequests")                                \
+  V(THREADPOOL_QUEUE_TIME, "threadpoolQueueTime")                             \
+  V(THREADPOOL_RUN_TIME, "threadpoolRunTime")
+
+enum PerformanceIOStat {
+#define V(name, _) NODE_PERFORMANCE_IO_STAT_##name,
+  NODE_PERFORMANCE_IO_STATS(V)
+#undef V
+  NODE_PERFORMANCE_IO_STAT_INVALID
+};
+
+enum PerformanceLoopPhase {
+#define V(name, _) NODE_PERFORMANCE_LOOP_PHASE_##name,
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+  NODE_PERFORMANCE_LOOP_PHASE_INVALID
+};
+
 enum PerformanceMilestone {
 #define V(name, _) NODE_PERFORMANCE_MILESTONE_##name,
   NODE_PERFORMANCE_MILESTONES(V)
@@ -62,6 +110,11 @@ class performance_state {
       offsetof(performance_state_internal, milestones),
       NODE_PERFORMANCE_MILESTONE_INVALID,
       root),
+    io_stats(
+      isolate,
+      offsetof(performance_state_internal, io_stats),
+      AsyncWrap::PROVIDERS_LENGTH * NODE_PERFORMANCE_IO_STAT_INVALID,
+      root),
     observers(
       isolate,
       offsetof(performance_state_internal, observers),
@@ -73,6 +126,7 @@ class performance_state {
 
   AliasedUint8Array root;
   AliasedFloat64Array milestones;
+  AliasedFloat64Array io_stats;
   AliasedUint32Array observers;
 
   uint64_t performance_last_gc_start_mark = 0;
@@ -80,10 +134,19 @@ class performance_state {
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
 
+  // Adds |value| to one of the I/O statistics kept for |provider|.
+  void RecordIO(AsyncWrap::ProviderType provider,
+                enum PerformanceIOStat stat,
+                double value = 1) {
+    io_stats[provider * NODE_PERFORMANCE_IO_STAT_INVALID + stat] += value;
+  }
+
  private:
   struct performance_state_internal {
     // doubles first so that they are always sizeof(double)-aligned
     double milestones[NODE_PERFORMANCE_MILESTONE_INVALID];
+    double io_stats[AsyncWrap::PROVIDERS_LENGTH *
+                    NODE_PERFORMANCE_IO_STAT_INVALID];
     uint32_t observers[NODE_PERFORMANCE_ENTRY_TYPE_INVALID];
   };
 };
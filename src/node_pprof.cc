@@ -0,0 +1,222 @@
+#include "node_pprof.h"
+#include "diagnosticfilename-inl.h"
+#include "env-inl.h"
+#include "node_buffer.h"
+#include "node_internals.h"
+#include "util-inl.h"
+#include "uv.h"
+
+namespace node {
+namespace pprof {
+
+namespace {
+
+enum WireType { kVarint = 0, kLengthDelimited = 2 };
+
+// Field numbers from profile.proto.
+enum ProfileField : uint32_t {
+  kProfileSampleType = 1,
+  kProfileSample = 2,
+  kProfileLocation = 4,
+  kProfileFunction = 5,
+  kProfileStringTable = 6,
+  kProfileTimeNanos = 9,
+  kProfileDurationNanos = 10,
+  kProfilePeriodType = 11,
+  kProfilePeriod = 12
+};
+
+enum ValueTypeField : uint32_t { kValueTypeType = 1, kValueTypeUnit = 2 };
+enum SampleField : uint32_t { kSampleLocationId = 1, kSampleValue = 2 };
+enum LocationField : uint32_t { kLocationId = 1, kLocationLine = 4 };
+enum LineField : uint32_t { kLineFunctionId = 1, kLineLine = 2 };
+enum FunctionField : uint32_t {
+  kFunctionId = 1,
+  kFunctionName = 2,
+  kFunctionSystemName = 3,
+  kFunctionFilename = 4,
+  kFunctionStartLine = 5
+};
+
+void AppendVarint(std::string* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendTag(std::string* out, uint32_t field, WireType type) {
+  AppendVarint(out, (field << 3) | type);
+}
+
+void AppendVarintField(std::string* out, uint32_t field, uint64_t value) {
+  AppendTag(out, field, kVarint);
+  AppendVarint(out, value);
+}
+
+void AppendBytesField(std::string* out,
+                      uint32_t field,
+                      const std::string& bytes) {
+  AppendTag(out, field, kLengthDelimited);
+  AppendVarint(out, bytes.size());
+  out->append(bytes);
+}
+
+template <typename T>
+void AppendPackedField(std::string* out,
+                       uint32_t field,
+                       const std::vector<T>& values) {
+  std::string packed;
+  for (T value : values)
+    AppendVarint(&packed, static_cast<uint64_t>(value));
+  AppendBytesField(out, field, packed);
+}
+
+}  // anonymous namespace
+
+ProfileBuilder::ProfileBuilder() {
+  // The string table has to start with the empty string.
+  StringId("");
+}
+
+int64_t ProfileBuilder::StringId(const std::string& str) {
+  auto it = string_ids_.find(str);
+  if (it != string_ids_.end())
+    return it->second;
+  int64_t id = strings_.size();
+  strings_.push_back(str);
+  string_ids_.emplace(str, id);
+  return id;
+}
+
+void ProfileBuilder::AddSampleType(const std::string& type,
+                                   const std::string& unit) {
+  std::string value_type;
+  AppendVarintField(&value_type, kValueTypeType, StringId(type));
+  AppendVarintField(&value_type, kValueTypeUnit, StringId(unit));
+  AppendBytesField(&sample_types_, kProfileSampleType, value_type);
+}
+
+void ProfileBuilder::SetPeriod(const std::string& type,
+                               const std::string& unit,
+                               int64_t period) {
+  period_type_.clear();
+  AppendVarintField(&period_type_, kValueTypeType, StringId(type));
+  AppendVarintField(&period_type_, kValueTypeUnit, StringId(unit));
+  period_ = period;
+}
+
+void ProfileBuilder::SetTime(int64_t time_nanos, int64_t duration_nanos) {
+  time_nanos_ = time_nanos;
+  duration_nanos_ = duration_nanos;
+}
+
+uint64_t ProfileBuilder::AddLocation(const std::string& name,
+                                     const std::string& filename,
+                                     int64_t line) {
+  std::string key = name + '\0' + filename + '\0' + std::to_string(line);
+  auto it = location_ids_.find(key);
+  if (it != location_ids_.end())
+    return it->second;
+  // Location ids must not be 0. Every location has its own function, with
+  // the same id.
+  uint64_t id = location_ids_.size() + 1;
+  location_ids_.emplace(std::move(key), id);
+
+  std::string function;
+  AppendVarintField(&function, kFunctionId, id);
+  AppendVarintField(&function, kFunctionName, StringId(name));
+  AppendVarintField(&function, kFunctionSystemName, StringId(name));
+  AppendVarintField(&function, kFunctionFilename, StringId(filename));
+  AppendVarintField(&function, kFunctionStartLine, line);
+  AppendBytesField(&functions_, kProfileFunction, function);
+
+  std::string line_message;
+  AppendVarintField(&line_message, kLineFunctionId, id);
+  AppendVarintField(&line_message, kLineLine, line);
+  std::string location;
+  AppendVarintField(&location, kLocationId, id);
+  AppendBytesField(&location, kLocationLine, line_message);
+  AppendBytesField(&locations_, kProfileLocation, location);
+  return id;
+}
+
+void ProfileBuilder::AddSample(const std::vector<uint64_t>& locations,
+                               const std::vector<int64_t>& values) {
+  std::string sample;
+  AppendPackedField(&sample, kSampleLocationId, locations);
+  AppendPackedField(&sample, kSampleValue, values);
+  AppendBytesField(&samples_, kProfileSample, sample);
+}
+
+std::string ProfileBuilder::Serialize() const {
+  std::string out;
+  out.append(sample_types_);
+  out.append(samples_);
+  out.append(locations_);
+  out.append(functions_);
+  for (const std::string& str : strings_)
+    AppendBytesField(&out, kProfileStringTable, str);
+  AppendVarintField(&out, kProfileTimeNanos, time_nanos_);
+  AppendVarintField(&out, kProfileDurationNanos, duration_nanos_);
+  if (!period_type_.empty()) {
+    AppendBytesField(&out, kProfilePeriodType, period_type_);
+    AppendVarintField(&out, kProfilePeriod, period_);
+  }
+  return out;
+}
+
+void ReturnProfile(Environment* env,
+                   const v8::FunctionCallbackInfo<v8::Value>& args,
+                   const std::string& profile,
+                   bool pprof) {
+  if (pprof) {
+    v8::Local<v8::Object> buffer;
+    if (Buffer::Copy(env, profile.data(), profile.size()).ToLocal(&buffer))
+      args.GetReturnValue().Set(buffer);
+    return;
+  }
+  v8::Local<v8::String> str;
+  if (v8::String::NewFromUtf8(env->isolate(),
+                              profile.data(),
+                              v8::NewStringType::kNormal,
+                              profile.size()).ToLocal(&str)) {
+    args.GetReturnValue().Set(str);
+  }
+}
+
+void WriteProfile(Environment* env,
+                  const v8::FunctionCallbackInfo<v8::Value>& args,
+                  v8::Local<v8::Value> filename_v,
+                  const char* prefix,
+                  std::string* profile,
+                  bool pprof) {
+  v8::Isolate* isolate = env->isolate();
+  std::string filename;
+  if (filename_v->IsUndefined()) {
+    DiagnosticFilename name(env, prefix, pprof ? "pb" : "folded");
+    filename = *name;
+  } else {
+    BufferValue path(isolate, filename_v);
+    CHECK_NOT_NULL(*path);
+    filename = *path;
+  }
+
+  uv_buf_t buf = uv_buf_init(&(*profile)[0], profile->size());
+  int err = WriteFileSync(filename.c_str(), buf);
+  if (err != 0)
+    return env->ThrowUVException(err, "write", nullptr, filename.c_str());
+
+  if (!filename_v->IsUndefined())
+    return args.GetReturnValue().Set(filename_v);
+  if (v8::String::NewFromUtf8(isolate,
+                              filename.c_str(),
+                              v8::NewStringType::kNormal)
+          .ToLocal(&filename_v)) {
+    args.GetReturnValue().Set(filename_v);
+  }
+}
+
+}  // namespace pprof
+}  // namespace node
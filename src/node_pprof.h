@@ -0,0 +1,85 @@
+#ifndef SRC_NODE_PPROF_H_
+#define SRC_NODE_PPROF_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "v8.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+
+class Environment;
+
+namespace pprof {
+
+// Builds an uncompressed profile in the pprof format, i.e. a serialized
+// perftools.profiles.Profile message as described in
+// https://github.com/google/pprof/blob/master/proto/profile.proto.
+// Each location maps to a single JavaScript function.
+class ProfileBuilder {
+ public:
+  ProfileBuilder();
+
+  // Adds the meaning of the next value of every sample, e.g. ("samples",
+  // "count"). Every sample needs one value per sample type.
+  void AddSampleType(const std::string& type, const std::string& unit);
+  void SetPeriod(const std::string& type,
+                 const std::string& unit,
+                 int64_t period);
+  void SetTime(int64_t time_nanos, int64_t duration_nanos);
+
+  // Returns the id of the location for a function. Calling this again with
+  // the same function returns the same id.
+  uint64_t AddLocation(const std::string& name,
+                       const std::string& filename,
+                       int64_t line);
+  // `locations` holds location ids, with the innermost frame first.
+  void AddSample(const std::vector<uint64_t>& locations,
+                 const std::vector<int64_t>& values);
+
+  std::string Serialize() const;
+
+ private:
+  int64_t StringId(const std::string& str);
+
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, int64_t> string_ids_;
+  std::unordered_map<std::string, uint64_t> location_ids_;
+  // Already serialized fields of the Profile message.
+  std::string sample_types_;
+  std::string samples_;
+  std::string locations_;
+  std::string functions_;
+  std::string period_type_;
+  int64_t period_ = 0;
+  int64_t time_nanos_ = 0;
+  int64_t duration_nanos_ = 0;
+};
+
+// Helpers shared by the bindings of the CPU and heap samplers. A profile is
+// either in the pprof format, which is returned as a Buffer, or consists of
+// collapsed stacks, which are returned as a string.
+void ReturnProfile(Environment* env,
+                   const v8::FunctionCallbackInfo<v8::Value>& args,
+                   const std::string& profile,
+                   bool pprof);
+// Writes the profile to `filename`, or to a file named after `prefix` in the
+// current working directory if `filename` is undefined, and returns the name
+// of the file. Throws an exception if the file cannot be written.
+void WriteProfile(Environment* env,
+                  const v8::FunctionCallbackInfo<v8::Value>& args,
+                  v8::Local<v8::Value> filename,
+                  const char* prefix,
+                  std::string* profile,
+                  bool pprof);
+
+}  // namespace pprof
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_PPROF_H_
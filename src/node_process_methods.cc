@@ -201,6 +201,33 @@ static void MemoryUsage(const FunctionCallbackInfo<Value>& args) {
   fields[3] = v8_heap_stats.external_memory();
 }
 
+static void ThreadpoolUsage(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  uv_threadpool_stats_t stats;
+  int err = uv_threadpool_get_stats(&stats);
+  if (err)
+    return env->ThrowUVException(err, "uv_threadpool_get_stats");
+
+  // Get the double array pointer from the Float64Array argument.
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 10);
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = static_cast<double*>(ab->GetContents().Data());
+
+  fields[0] = stats.size;
+  fields[1] = stats.max_size;
+  fields[2] = stats.idle_threads;
+  fields[3] = stats.queued;
+  fields[4] = stats.running;
+  fields[5] = stats.slow_io_running;
+  fields[6] = static_cast<double>(stats.submitted);
+  fields[7] = static_cast<double>(stats.completed);
+  fields[8] = static_cast<double>(stats.wait_time);
+  fields[9] = static_cast<double>(stats.run_time);
+}
+
 void RawDebug(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.Length() == 1 && args[0]->IsString() &&
         "must be called with a single string");
@@ -415,6 +442,7 @@ static void InitializeProcessMethods(Local<Object> target,
   env->SetMethod(target, "umask", Umask);
   env->SetMethod(target, "_rawDebug", RawDebug);
   env->SetMethod(target, "memoryUsage", MemoryUsage);
+  env->SetMethod(target, "threadpoolUsage", ThreadpoolUsage);
   env->SetMethod(target, "cpuUsage", CPUUsage);
   env->SetMethod(target, "hrtime", Hrtime);
   env->SetMethod(target, "hrtimeBigInt", HrtimeBigInt);
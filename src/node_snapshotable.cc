@@ -0,0 +1,294 @@
+#include "node_snapshotable.h"
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include "node_errors.h"
+#include "node_internals.h"
+#include "node_main_instance.h"
+#include "node_version.h"
+#include "node_v8_platform-inl.h"
+#include "util-inl.h"
+
+namespace node {
+
+using v8::Context;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Locker;
+using v8::NewStringType;
+using v8::Script;
+using v8::ScriptCompiler;
+using v8::ScriptOrigin;
+using v8::SnapshotCreator;
+using v8::StartupData;
+using v8::String;
+using v8::TryCatch;
+
+template <typename T>
+void WriteVector(std::stringstream* ss, const T* vec, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    *ss << std::to_string(vec[i]) << (i == size - 1 ? '\n' : ',');
+  }
+}
+
+std::string FormatBlob(v8::StartupData* blob,
+                       const std::vector<size_t>& isolate_data_indexes) {
+  std::stringstream ss;
+
+  ss << R"(#include <cstddef>
+#include "node_main_instance.h"
+#include "v8.h"
+
+// This file is generated by tools/snapshot. Do not edit.
+
+namespace node {
+
+static const char blob_data[] = {
+)";
+  WriteVector(&ss, blob->data, blob->raw_size);
+  ss << R"(};
+
+static const int blob_size = )"
+     << blob->raw_size << R"(;
+static v8::StartupData blob = { blob_data, blob_size };
+)";
+
+  ss << R"(v8::StartupData* NodeMainInstance::GetEmbeddedSnapshotBlob() {
+  return &blob;
+}
+
+static const std::vector<size_t> isolate_data_indexes {
+)";
+  WriteVector(&ss, isolate_data_indexes.data(), isolate_data_indexes.size());
+  ss << R"(};
+
+const std::vector<size_t>* NodeMainInstance::GetIsolateDataIndexes() {
+  return &isolate_data_indexes;
+}
+}  // namespace node
+)";
+
+  return ss.str();
+}
+
+// Runs the --build-snapshot entry point as a classic script in |context|.
+// Node.js has not been bootstrapped in it at this point, so the script only
+// has access to the JavaScript built-ins.
+static int RunSnapshotEntry(Isolate* isolate,
+                            Local<Context> context,
+                            const std::string& entry_file) {
+  std::string source;
+  int err = ReadFileSync(&source, entry_file.c_str());
+  if (err != 0) {
+    fprintf(stderr, "Cannot read snapshot entry point %s: %s\n",
+            entry_file.c_str(), uv_strerror(err));
+    return 9;
+  }
+
+  Context::Scope context_scope(context);
+  TryCatch try_catch(isolate);
+  Local<String> source_string;
+  Local<String> filename_string;
+  if (!String::NewFromUtf8(isolate, source.data(), NewStringType::kNormal,
+                           source.size()).ToLocal(&source_string) ||
+      !String::NewFromUtf8(isolate, entry_file.data(), NewStringType::kNormal,
+                           entry_file.size()).ToLocal(&filename_string)) {
+    fprintf(stderr, "Snapshot entry point %s is too large\n",
+            entry_file.c_str());
+    return 1;
+  }
+
+  ScriptOrigin origin(filename_string);
+  ScriptCompiler::Source script_source(source_string, origin);
+  Local<Script> script;
+  if (!ScriptCompiler::Compile(context, &script_source).ToLocal(&script) ||
+      script->Run(context).IsEmpty()) {
+    PrintCaughtException(isolate, context, try_catch);
+    return 1;
+  }
+  isolate->RunMicrotasks();
+  return 0;
+}
+
+std::string SnapshotBuilder::Generate(
+    const std::vector<std::string> args,
+    const std::vector<std::string> exec_args) {
+  SnapshotData data;
+  CHECK_EQ(Generate(&data, args, exec_args, ""), 0);
+  return FormatBlob(&data.blob, data.isolate_data_indexes);
+}
+
+int SnapshotBuilder::Generate(SnapshotData* out,
+                              const std::vector<std::string> args,
+                              const std::vector<std::string> exec_args,
+                              const std::string& entry_file) {
+  // TODO(joyeecheung): collect external references and set it in
+  // params.external_references.
+  std::vector<intptr_t> external_references = {
+      reinterpret_cast<intptr_t>(nullptr)};
+  Isolate* isolate = Isolate::Allocate();
+  per_process::v8_platform.Platform()->RegisterIsolate(isolate,
+                                                       uv_default_loop());
+  NodeMainInstance* main_instance = nullptr;
+  int exit_code = 0;
+
+  {
+    SnapshotCreator creator(isolate, external_references.data());
+    {
+      main_instance =
+          NodeMainInstance::Create(isolate,
+                                   uv_default_loop(),
+                                   per_process::v8_platform.Platform(),
+                                   args,
+                                   exec_args);
+      HandleScope scope(isolate);
+      creator.SetDefaultContext(Context::New(isolate));
+      out->isolate_data_indexes =
+          main_instance->isolate_data()->Serialize(&creator);
+
+      Local<Context> context = NewContext(isolate);
+      if (!entry_file.empty())
+        exit_code = RunSnapshotEntry(isolate, context, entry_file);
+      size_t index = creator.AddContext(context);
+      CHECK_EQ(index, NodeMainInstance::kNodeContextIndex);
+    }
+
+    // Must be out of HandleScope
+    StartupData blob =
+        creator.CreateBlob(SnapshotCreator::FunctionCodeHandling::kClear);
+    // Must be done while the snapshot creator isolate is entered i.e. the
+    // creator is still alive.
+    main_instance->Dispose();
+    if (exit_code == 0) {
+      out->blob = blob;
+    } else {
+      delete[] blob.data;
+    }
+  }
+
+  per_process::v8_platform.Platform()->UnregisterIsolate(isolate);
+  return exit_code;
+}
+
+int SnapshotBuilder::BuildToFile(const std::vector<std::string> args,
+                                 const std::vector<std::string> exec_args,
+                                 const std::string& path) {
+  if (args.size() < 2) {
+    fprintf(stderr, "%s: --build-snapshot must be used with an entry point "
+            "script\n", args[0].c_str());
+    return 9;
+  }
+
+  SnapshotData data;
+  int exit_code = Generate(&data, args, exec_args, args[1]);
+  if (exit_code != 0)
+    return exit_code;
+
+  int err = data.WriteToFile(path);
+  if (err != 0) {
+    fprintf(stderr, "Cannot write snapshot blob to %s: %s\n",
+            path.c_str(), uv_strerror(err));
+    return 1;
+  }
+  return 0;
+}
+
+// The blob file starts with a header identifying the binary that wrote it,
+// because V8 cannot deserialize a snapshot created by a different version.
+//
+//   "NODESNAP" | version string | isolate data indexes | V8 blob
+//
+// Strings and arrays are prefixed with their length as a uint64_t.
+static const char kSnapshotMagic[] = "NODESNAP";
+static const size_t kSnapshotMagicLength = sizeof(kSnapshotMagic) - 1;
+
+static std::string SnapshotVersion() {
+  return std::string(NODE_VERSION) + " " + NODE_ARCH + " " + NODE_PLATFORM +
+         " v8/" + v8::V8::GetVersion();
+}
+
+template <typename T>
+static void Append(std::string* out, T value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static bool Consume(const std::string& in, size_t* offset, T* value) {
+  const size_t pos = *offset;
+  if (in.size() - pos < sizeof(T)) return false;
+  memcpy(value, in.data() + pos, sizeof(T));
+  *offset = pos + sizeof(T);
+  return true;
+}
+
+SnapshotData::~SnapshotData() {
+  delete[] blob.data;
+}
+
+int SnapshotData::WriteToFile(const std::string& path) const {
+  const std::string version = SnapshotVersion();
+  std::string contents(kSnapshotMagic, kSnapshotMagicLength);
+  Append<uint64_t>(&contents, version.size());
+  contents += version;
+  Append<uint64_t>(&contents, isolate_data_indexes.size());
+  for (size_t index : isolate_data_indexes)
+    Append<uint64_t>(&contents, index);
+  Append<uint64_t>(&contents, blob.raw_size);
+  contents.append(blob.data, blob.raw_size);
+
+  uv_buf_t buf = uv_buf_init(&contents[0], contents.size());
+  return WriteFileSync(path.c_str(), buf);
+}
+
+bool SnapshotData::ReadFromFile(const std::string& path, std::string* error) {
+  std::string contents;
+  int err = ReadFileSync(&contents, path.c_str());
+  if (err != 0) {
+    *error = "Cannot read snapshot blob " + path + ": " + uv_strerror(err);
+    return false;
+  }
+
+  size_t offset = kSnapshotMagicLength;
+  uint64_t length;
+  if (contents.compare(0, kSnapshotMagicLength, kSnapshotMagic) != 0 ||
+      !Consume(contents, &offset, &length) ||
+      contents.size() - offset < length) {
+    *error = path + " is not a snapshot blob";
+    return false;
+  }
+  const std::string version = SnapshotVersion();
+  if (contents.compare(offset, length, version) != 0) {
+    *error = "Snapshot blob " + path + " was built by " +
+             contents.substr(offset, length) + ", not by " + version;
+    return false;
+  }
+  offset += length;
+
+  std::vector<size_t> indexes;
+  uint64_t count;
+  bool ok = Consume(contents, &offset, &count) &&
+            count <= (contents.size() - offset) / sizeof(uint64_t);
+  for (uint64_t i = 0; ok && i < count; i++) {
+    uint64_t index;
+    ok = Consume(contents, &offset, &index);
+    indexes.push_back(index);
+  }
+  ok = ok && Consume(contents, &offset, &length) &&
+       length == contents.size() - offset &&
+       length <= static_cast<uint64_t>(std::numeric_limits<int>::max());
+  if (!ok) {
+    *error = "Snapshot blob " + path + " is truncated";
+    return false;
+  }
+
+  char* data = new char[length];
+  memcpy(data, contents.data() + offset, length);
+  delete[] blob.data;
+  blob = { data, static_cast<int>(length) };
+  isolate_data_indexes = std::move(indexes);
+  return true;
+}
+
+}  // namespace node
@@ -0,0 +1,58 @@
+#ifndef SRC_NODE_SNAPSHOTABLE_H_
+#define SRC_NODE_SNAPSHOTABLE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <string>
+#include <vector>
+
+#include "v8.h"
+
+namespace node {
+
+// A V8 startup snapshot together with the IsolateData indexes that are
+// needed to deserialize it. This is what --build-snapshot writes to and
+// --snapshot-blob reads from disk.
+struct SnapshotData {
+  SnapshotData() = default;
+  ~SnapshotData();
+  SnapshotData(const SnapshotData&) = delete;
+  SnapshotData& operator=(const SnapshotData&) = delete;
+
+  // Returns 0 on success or a negative libuv error code.
+  int WriteToFile(const std::string& path) const;
+  // Returns false and sets |error| if the file cannot be read, or if it was
+  // not produced by this exact Node.js binary version.
+  bool ReadFromFile(const std::string& path, std::string* error);
+
+  // Owned, allocated with new[].
+  v8::StartupData blob { nullptr, 0 };
+  std::vector<size_t> isolate_data_indexes;
+};
+
+class SnapshotBuilder {
+ public:
+  // Returns the source of the node_snapshot.cc file that node_mksnapshot
+  // embeds into the binary.
+  static std::string Generate(const std::vector<std::string> args,
+                              const std::vector<std::string> exec_args);
+
+  // Builds a snapshot of the main context after running |entry_file| in it,
+  // if it is not empty. Returns a process exit code, printing the reason to
+  // stderr when it is not 0.
+  static int Generate(SnapshotData* out,
+                      const std::vector<std::string> args,
+                      const std::vector<std::string> exec_args,
+                      const std::string& entry_file);
+
+  // Implements `node --snapshot-blob file --build-snapshot entry.js`.
+  static int BuildToFile(const std::vector<std::string> args,
+                         const std::vector<std::string> exec_args,
+                         const std::string& path);
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_SNAPSHOTABLE_H_
@@ -0,0 +1,102 @@
+#include "node_threadpool.h"
+#include "node_internals.h"
+#include "node_options.h"
+#include "threadpoolwork-inl.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace node {
+namespace threadpool {
+
+namespace {
+
+std::unique_ptr<WorkerPool> pools[WORK_CLASS_COUNT];
+
+}  // anonymous namespace
+
+WorkerPool::WorkerPool(unsigned int size) : threads_(size) {
+  for (uv_thread_t& thread : threads_)
+    CHECK_EQ(uv_thread_create(&thread, Run, this), 0);
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    stopped_ = true;
+    work_available_.Broadcast(lock);
+  }
+  for (uv_thread_t& thread : threads_)
+    CHECK_EQ(uv_thread_join(&thread), 0);
+}
+
+void WorkerPool::Post(ThreadPoolWork* work) {
+  Mutex::ScopedLock lock(mutex_);
+  queue_.push_back(work);
+  work_available_.Signal(lock);
+}
+
+bool WorkerPool::Cancel(ThreadPoolWork* work) {
+  Mutex::ScopedLock lock(mutex_);
+  auto it = std::find(queue_.begin(), queue_.end(), work);
+  if (it == queue_.end())
+    return false;
+  queue_.erase(it);
+  return true;
+}
+
+void WorkerPool::Run(void* data) {
+  WorkerPool* pool = static_cast<WorkerPool*>(data);
+  for (;;) {
+    ThreadPoolWork* work;
+    {
+      Mutex::ScopedLock lock(pool->mutex_);
+      while (pool->queue_.empty() && !pool->stopped_)
+        pool->work_available_.Wait(lock);
+      if (pool->stopped_)
+        return;
+      work = pool->queue_.front();
+      pool->queue_.pop_front();
+    }
+    work->RunOnWorkerPool();
+  }
+}
+
+void Initialize() {
+  const uint64_t sizes[] = {
+#define V(type, name) per_process::cli_options->threadpool_##name##_size,
+    THREADPOOL_WORK_CLASSES(V)
+#undef V
+  };
+  for (int i = 0; i < WORK_CLASS_COUNT; i++) {
+    if (sizes[i] > 0)
+      pools[i] = std::make_unique<WorkerPool>(sizes[i]);
+  }
+}
+
+void TearDown() {
+  for (std::unique_ptr<WorkerPool>& pool : pools)
+    pool.reset();
+}
+
+WorkerPool* ForProvider(AsyncWrap::ProviderType provider) {
+  switch (provider) {
+    // N-API async work is the only ThreadPoolWork without a provider.
+    case AsyncWrap::PROVIDER_NONE:
+      return pools[WORK_CLASS_ADDON].get();
+    case AsyncWrap::PROVIDER_ZLIB:
+      return pools[WORK_CLASS_COMPRESSION].get();
+#if HAVE_OPENSSL
+    case AsyncWrap::PROVIDER_KEYPAIRGENREQUEST:
+    case AsyncWrap::PROVIDER_PBKDF2REQUEST:
+    case AsyncWrap::PROVIDER_RANDOMBYTESREQUEST:
+    case AsyncWrap::PROVIDER_SCRYPTREQUEST:
+      return pools[WORK_CLASS_CRYPTO].get();
+#endif  // HAVE_OPENSSL
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace threadpool
+}  // namespace node
@@ -0,0 +1,73 @@
+#ifndef SRC_NODE_THREADPOOL_H_
+#define SRC_NODE_THREADPOOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "async_wrap.h"
+#include "node_mutex.h"
+#include "uv.h"
+
+#include <deque>
+#include <vector>
+
+namespace node {
+
+class ThreadPoolWork;
+
+namespace threadpool {
+
+// Classes of ThreadPoolWork that can be given threads of their own through
+// the --threadpool-<name>-size options, so that e.g. a burst of scrypt()
+// calls does not hold up file system requests in libuv's threadpool.
+// Work of a class without its own threads runs in libuv's threadpool.
+#define THREADPOOL_WORK_CLASSES(V)                                            \
+  V(ADDON, addon)                                                             \
+  V(COMPRESSION, compression)                                                 \
+  V(CRYPTO, crypto)
+
+enum WorkClass {
+#define V(type, name) WORK_CLASS_##type,
+  THREADPOOL_WORK_CLASSES(V)
+#undef V
+  WORK_CLASS_COUNT
+};
+
+class WorkerPool {
+ public:
+  explicit WorkerPool(unsigned int size);
+  // Waits for the threads to finish the work they are running. Work that
+  // has not been started yet is dropped.
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  void Post(ThreadPoolWork* work);
+  // Removes |work| from the queue. Returns false if a thread has already
+  // picked it up.
+  bool Cancel(ThreadPoolWork* work);
+
+ private:
+  static void Run(void* data);
+
+  Mutex mutex_;
+  ConditionVariable work_available_;
+  std::deque<ThreadPoolWork*> queue_;
+  std::vector<uv_thread_t> threads_;
+  bool stopped_ = false;
+};
+
+// Starts the threads of the work classes configured on the command line.
+void Initialize();
+void TearDown();
+
+// Returns the pool that runs work accounted as |provider|, or nullptr if
+// the work runs in libuv's threadpool.
+WorkerPool* ForProvider(AsyncWrap::ProviderType provider);
+
+}  // namespace threadpool
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_THREADPOOL_H_
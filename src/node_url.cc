@@ -27,6 +27,7 @@ using v8::NewStringType;
 using v8::Null;
 using v8::Object;
 using v8::String;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -152,6 +153,29 @@ enum url_error_cb_args {
 #undef XX
 };
 
+// Layout of the Uint32Array filled in by ParseHref(). Apart from the flags
+// and the port, the values are offsets into the serialized URL.
+#define COMPONENTS(XX)                                                        \
+  XX(kURLComponentFlags)                                                      \
+  XX(kURLComponentProtocolEnd)                                                \
+  XX(kURLComponentUsernameEnd)                                                \
+  XX(kURLComponentHostStart)                                                  \
+  XX(kURLComponentHostEnd)                                                    \
+  XX(kURLComponentPort)                                                       \
+  XX(kURLComponentPathnameStart)                                              \
+  XX(kURLComponentSearchStart)                                                \
+  XX(kURLComponentHashStart)                                                  \
+  XX(kURLComponentsLength)  // This one has to be last.
+
+enum url_components {
+#define XX(name) name,
+  COMPONENTS(XX)
+#undef XX
+};
+
+// Used for components that are not present in a URL.
+const uint32_t kURLComponentOmitted = 0xffffffff;
+
 #define CHAR_TEST(bits, name, expr)                                           \
   template <typename T>                                                       \
   inline bool name(const T ch) {                                              \
@@ -757,6 +781,32 @@ inline int NormalizePort(const std::string& scheme, int p) {
   return p;
 }
 
+// Domains that consist only of ASCII alphanumerics, hyphens and dots, and
+// that have no label starting with the Punycode prefix "xn--", are mapped
+// to their lowercase form by ToASCII. Do that in place and skip the
+// (comparatively expensive) IDNA processing for them.
+inline bool ToASCIIFastPath(std::string* domain) {
+  size_t label_start = 0;
+  for (size_t n = 0; n < domain->size(); n++) {
+    const char ch = (*domain)[n];
+    if (ch == '.') {
+      label_start = n + 1;
+      continue;
+    }
+    if (!IsASCIIAlphanumeric(ch) && ch != '-')
+      return false;
+    if (n == label_start + 3 && ch == '-' &&
+        ASCIILowercase((*domain)[n - 3]) == 'x' &&
+        ASCIILowercase((*domain)[n - 2]) == 'n' &&
+        (*domain)[n - 1] == '-') {
+      return false;
+    }
+  }
+  for (char& ch : *domain)
+    ch = ASCIILowercase(ch);
+  return true;
+}
+
 #if defined(NODE_HAVE_I18N_SUPPORT)
 inline bool ToUnicode(const std::string& input, std::string* output) {
   MaybeStackBuffer<char> buf;
@@ -1032,8 +1082,9 @@ void URLHost::ParseHost(const char* input,
   // First, we have to percent decode
   std::string decoded = PercentDecode(input, length);
 
-  // Then we have to punycode toASCII
-  if (!ToASCII(decoded, &decoded))
+  // Then we have to punycode toASCII, unless ToASCII would only lowercase
+  // the domain anyway.
+  if (!ToASCIIFastPath(&decoded) && !ToASCII(decoded, &decoded))
     return;
 
   // If any of the following characters are still present, we have to fail
@@ -2201,6 +2252,113 @@ static void Parse(const FunctionCallbackInfo<Value>& args) {
         args[5]);
 }
 
+// Serializes `url` the same way the JS URL class does, and records where
+// each component starts or ends in the result.
+static std::string SerializeURL(const url_data& url, uint32_t* components) {
+  std::string href = url.scheme;
+  components[kURLComponentFlags] = url.flags;
+  components[kURLComponentProtocolEnd] = href.size();
+  components[kURLComponentUsernameEnd] = href.size();
+  components[kURLComponentHostStart] = href.size();
+  components[kURLComponentHostEnd] = href.size();
+  components[kURLComponentPort] =
+      url.port > -1 ? url.port : kURLComponentOmitted;
+
+  if (url.flags & URL_FLAGS_HAS_HOST) {
+    href += "//";
+    const bool has_username =
+        (url.flags & URL_FLAGS_HAS_USERNAME) && !url.username.empty();
+    const bool has_password =
+        (url.flags & URL_FLAGS_HAS_PASSWORD) && !url.password.empty();
+    if (has_username)
+      href += url.username;
+    components[kURLComponentUsernameEnd] = href.size();
+    if (has_password)
+      href += ":" + url.password;
+    if (has_username || has_password)
+      href += "@";
+    components[kURLComponentHostStart] = href.size();
+    href += url.host;
+    components[kURLComponentHostEnd] = href.size();
+    if (url.port > -1)
+      href += ":" + std::to_string(url.port);
+  } else if (url.scheme == "file:") {
+    href += "//";
+  }
+
+  components[kURLComponentPathnameStart] = href.size();
+  if (url.flags & URL_FLAGS_HAS_PATH) {
+    if (url.flags & URL_FLAGS_CANNOT_BE_BASE) {
+      if (!url.path.empty())
+        href += url.path[0];
+    } else {
+      for (const std::string& segment : url.path) {
+        href += '/';
+        href += segment;
+      }
+    }
+  }
+
+  components[kURLComponentSearchStart] = kURLComponentOmitted;
+  if (url.flags & URL_FLAGS_HAS_QUERY) {
+    components[kURLComponentSearchStart] = href.size();
+    href += '?';
+    href += url.query;
+  }
+
+  components[kURLComponentHashStart] = kURLComponentOmitted;
+  if (url.flags & URL_FLAGS_HAS_FRAGMENT) {
+    components[kURLComponentHashStart] = href.size();
+    href += '#';
+    href += url.fragment;
+  }
+
+  return href;
+}
+
+// A single-pass alternative to Parse() for the URL constructor and the
+// href setter: instead of creating a string for every component, this
+// returns the serialized URL and stores the offsets of its components into
+// a Uint32Array, so that JS land can slice them lazily.
+// Returns false if parsing failed, and undefined if the serialized URL is
+// not pure ASCII, in which case the offsets cannot be used from JS.
+static void ParseHref(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK_GE(args.Length(), 3);
+  CHECK(args[0]->IsString());  // input
+  CHECK(args[1]->IsUndefined() ||  // base context
+        args[1]->IsNull() ||
+        args[1]->IsObject());
+  CHECK(args[2]->IsUint32Array());  // components
+
+  Local<Uint32Array> array = args[2].As<Uint32Array>();
+  CHECK_EQ(array->Length(), kURLComponentsLength);
+  uint32_t* components = reinterpret_cast<uint32_t*>(
+      static_cast<char*>(array->Buffer()->GetContents().Data()) +
+      array->ByteOffset());
+
+  Utf8Value input(env->isolate(), args[0]);
+  const bool has_base = args[1]->IsObject();
+  url_data base;
+  if (has_base)
+    base = HarvestBase(env, args[1].As<Object>());
+
+  url_data url;
+  URL::Parse(*input, input.length(), kUnknownState,
+             &url, false, &base, has_base);
+  if (url.flags & URL_FLAGS_FAILED)
+    return args.GetReturnValue().Set(false);
+
+  const std::string href = SerializeURL(url, components);
+  for (const char ch : href) {
+    if (static_cast<unsigned char>(ch) >= 0x80)
+      return;
+  }
+
+  args.GetReturnValue().Set(
+      OneByteString(env->isolate(), href.c_str(), href.size()));
+}
+
 static void EncodeAuthSet(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK_GE(args.Length(), 1);
@@ -2424,6 +2582,7 @@ static void Initialize(Local<Object> target,
                        void* priv) {
   Environment* env = Environment::GetCurrent(context);
   env->SetMethod(target, "parse", Parse);
+  env->SetMethod(target, "parseHref", ParseHref);
   env->SetMethodNoSideEffect(target, "encodeAuth", EncodeAuthSet);
   env->SetMethodNoSideEffect(target, "toUSVString", ToUSVString);
   env->SetMethodNoSideEffect(target, "domainToASCII", DomainToASCII);
@@ -2437,6 +2596,11 @@ static void Initialize(Local<Object> target,
 #define XX(name) NODE_DEFINE_CONSTANT(target, name);
   PARSESTATES(XX)
 #undef XX
+
+#define XX(name) NODE_DEFINE_CONSTANT(target, name);
+  COMPONENTS(XX)
+#undef XX
+  NODE_DEFINE_CONSTANT(target, kURLComponentOmitted);
 }
 }  // namespace url
 }  // namespace node
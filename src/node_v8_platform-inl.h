@@ -129,7 +129,11 @@ struct V8Platform {
                                 std::make_move_iterator(categories.end())),
           std::unique_ptr<tracing::AsyncTraceWriter>(
               new tracing::NodeTraceWriter(
-                  per_process::cli_options->trace_event_file_pattern)),
+                  per_process::cli_options->trace_event_file_pattern,
+                  per_process::cli_options->trace_event_format == "proto" ?
+                      tracing::NodeTraceWriter::Format::kProto :
+                      tracing::NodeTraceWriter::Format::kJSON,
+                  per_process::cli_options->trace_event_file_size)),
           tracing::Agent::kUseDefaultCategories);
     }
   }
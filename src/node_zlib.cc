@@ -244,7 +244,7 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  public:
   CompressionStream(Environment* env, Local<Object> wrap)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
-        ThreadPoolWork(env),
+        ThreadPoolWork(env, AsyncWrap::PROVIDER_ZLIB),
         write_result_(nullptr) {
     MakeWeak();
   }
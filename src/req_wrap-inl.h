@@ -5,6 +5,7 @@
 
 #include "req_wrap.h"
 #include "async_wrap-inl.h"
+#include "env-inl.h"
 #include "uv.h"
 
 namespace node {
@@ -120,7 +121,14 @@ struct MakeLibuvRequestCallback<ReqT, void(*)(ReqT*, Args...)> {
 
   static void Wrapper(ReqT* req, Args... args) {
     ReqWrap<ReqT>* req_wrap = ContainerOf(&ReqWrap<ReqT>::req_, req);
-    req_wrap->env()->DecreaseWaitingRequestCounter();
+    Environment* env = req_wrap->env();
+    env->DecreaseWaitingRequestCounter();
+    performance::performance_state* state = env->performance_state();
+    state->RecordIO(req_wrap->provider_type(),
+                    performance::NODE_PERFORMANCE_IO_STAT_REQUESTS);
+    state->RecordIO(req_wrap->provider_type(),
+                    performance::NODE_PERFORMANCE_IO_STAT_REQUEST_TIME,
+                    uv_hrtime() - req_wrap->dispatched_at_);
     F original_callback = reinterpret_cast<F>(req_wrap->original_callback_);
     original_callback(req, args...);
   }
@@ -137,6 +145,7 @@ template <typename T>
 template <typename LibuvFunction, typename... Args>
 int ReqWrap<T>::Dispatch(LibuvFunction fn, Args... args) {
   Dispatched();
+  dispatched_at_ = uv_hrtime();
 
   // This expands as:
   //
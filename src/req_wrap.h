@@ -54,6 +54,8 @@ class ReqWrap : public AsyncWrap, public ReqWrapBase {
 
   typedef void (*callback_t)();
   callback_t original_callback_ = nullptr;
+  // When Dispatch() was called, for the I/O statistics.
+  uint64_t dispatched_at_ = 0;
 
  protected:
   // req_wrap_queue_ needs to be at a fixed offset from the start of the class
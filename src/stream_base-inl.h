@@ -116,8 +116,10 @@ inline uv_buf_t StreamResource::EmitAlloc(size_t suggested_size) {
 
 inline void StreamResource::EmitRead(ssize_t nread, const uv_buf_t& buf) {
   DebugSealHandleScope handle_scope(v8::Isolate::GetCurrent());
-  if (nread > 0)
+  if (nread > 0) {
     bytes_read_ += static_cast<uint64_t>(nread);
+    OnBytesRead(static_cast<size_t>(nread));
+  }
   listener_->OnStreamRead(nread, buf);
 }
 
@@ -189,6 +191,8 @@ inline StreamWriteResult StreamBase::Write(
   for (size_t i = 0; i < count; ++i)
     total_bytes += bufs[i].len;
   bytes_written_ += total_bytes;
+  OnBytesWritten(total_bytes);
+  RecordWrites(count);
 
   if (send_handle == nullptr) {
     err = DoTryWrite(&bufs, &count);
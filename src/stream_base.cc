@@ -234,9 +234,11 @@ int StreamBase::WriteString(const FunctionCallbackInfo<Value>& args) {
     // provided by `Write()`.
     synchronously_written = count == 0 ? data_size : data_size - buf.len;
     bytes_written_ += synchronously_written;
+    OnBytesWritten(synchronously_written);
 
     // Immediate failure or success
     if (err != 0 || count == 0) {
+      RecordWrites(1);
       SetWriteResult(StreamWriteResult { false, err, nullptr, data_size });
       return err;
     }
@@ -411,6 +413,33 @@ void StreamBase::GetBytesWritten(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(static_cast<double>(wrap->bytes_written_));
 }
 
+void StreamBase::OnBytesRead(size_t nread) {
+  stream_env()->performance_state()->RecordIO(
+      GetAsyncWrap()->provider_type(),
+      performance::NODE_PERFORMANCE_IO_STAT_BYTES_READ,
+      nread);
+}
+
+void StreamBase::OnBytesWritten(size_t nwritten) {
+  stream_env()->performance_state()->RecordIO(
+      GetAsyncWrap()->provider_type(),
+      performance::NODE_PERFORMANCE_IO_STAT_BYTES_WRITTEN,
+      nwritten);
+}
+
+void StreamBase::RecordWrites(size_t count) {
+  stream_env()->performance_state()->RecordIO(
+      GetAsyncWrap()->provider_type(),
+      performance::NODE_PERFORMANCE_IO_STAT_WRITES,
+      count);
+}
+
+void StreamBase::RecordWriteSyscall() {
+  stream_env()->performance_state()->RecordIO(
+      GetAsyncWrap()->provider_type(),
+      performance::NODE_PERFORMANCE_IO_STAT_WRITE_SYSCALLS);
+}
+
 void StreamBase::GetExternal(const FunctionCallbackInfo<Value>& args) {
   StreamBase* wrap = StreamBase::FromObject(args.This().As<Object>());
   if (wrap == nullptr) return;
@@ -448,7 +477,7 @@ void StreamResource::ClearError() {
 uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(stream_);
   Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
-  return env->AllocateManaged(suggested_size).release();
+  return env->read_buffer_pool()->Allocate(suggested_size);
 }
 
 void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
@@ -457,6 +486,24 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
   Environment* env = stream->stream_env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
+  ReadBufferPool* pool = env->read_buffer_pool();
+
+  if (pool->Owns(buf_)) {
+    if (nread <= 0) {
+      pool->Release(buf_);
+      if (nread < 0)
+        stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
+      return;
+    }
+
+    size_t offset;
+    Local<ArrayBuffer> ab = pool->Commit(buf_, nread, &offset);
+    if (ab.IsEmpty())
+      return;
+    stream->CallJSOnreadMethod(nread, ab, offset);
+    return;
+  }
+
   AllocatedBuffer buf(env, buf_);
 
   if (nread <= 0)  {
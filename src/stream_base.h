@@ -250,6 +250,9 @@ class StreamResource {
   // Call the current listener's OnStreamWantsWrite() method.
   void EmitWantsWrite(size_t suggested_size);
 
+  // Called by EmitRead() for every chunk of data that was read.
+  virtual void OnBytesRead(size_t nread) {}
+
   StreamListener* listener_ = nullptr;
   uint64_t bytes_read_ = 0;
   uint64_t bytes_written_ = 0;
@@ -330,6 +333,15 @@ class StreamBase : public StreamResource {
   static void GetBytesWritten(const v8::FunctionCallbackInfo<v8::Value>& args);
   void AttachToObject(v8::Local<v8::Object> obj);
 
+  // Account for data read from or written to the stream in the
+  // Environment's per-provider I/O statistics.
+  void OnBytesRead(size_t nread) override;
+  void OnBytesWritten(size_t nwritten);
+  // Account for the buffers of a write request, and for a write system call
+  // that a stream made, in the same statistics.
+  void RecordWrites(size_t count);
+  void RecordWriteSyscall();
+
   template <int (StreamBase::*Method)(
       const v8::FunctionCallbackInfo<v8::Value>& args)>
   static void JSMethod(const v8::FunctionCallbackInfo<v8::Value>& args);
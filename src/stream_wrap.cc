@@ -37,9 +37,11 @@
 
 namespace node {
 
+using v8::ArrayBuffer;
 using v8::Context;
 using v8::DontDelete;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -51,6 +53,22 @@ using v8::Signature;
 using v8::Value;
 
 
+static void GetReadBufferPoolStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ReadBufferPool* pool = env->read_buffer_pool();
+
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 3);
+  Local<ArrayBuffer> ab = array->Buffer();
+  double* fields = static_cast<double*>(ab->GetContents().Data());
+
+  fields[0] = pool->hits();
+  fields[1] = pool->misses();
+  fields[2] = pool->slabs();
+}
+
+
 void LibuvStreamWrap::Initialize(Local<Object> target,
                                  Local<Value> unused,
                                  Local<Context> context,
@@ -110,6 +128,8 @@ void LibuvStreamWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kLastWriteWasAsync);
   target->Set(context, FIXED_ONE_BYTE_STRING(env->isolate(), "streamBaseState"),
               env->stream_base_state().GetJSArray()).Check();
+
+  env->SetMethod(target, "getReadBufferPoolStats", GetReadBufferPoolStats);
 }
 
 
@@ -347,6 +367,10 @@ int LibuvStreamWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
   uv_buf_t* vbufs = *bufs;
   size_t vcount = *count;
 
+  // uv_try_write() fails with UV_EAGAIN without a system call if there are
+  // queued writes.
+  if (stream()->write_queue_size == 0)
+    RecordWriteSyscall();
   err = uv_try_write(stream(), vbufs, vcount);
   if (err == UV_ENOSYS || err == UV_EAGAIN)
     return 0;
@@ -382,6 +406,7 @@ int LibuvStreamWrap::DoWrite(WriteWrap* req_wrap,
                              size_t count,
                              uv_stream_t* send_handle) {
   LibuvWriteWrap* w = static_cast<LibuvWriteWrap*>(req_wrap);
+  RecordWriteSyscall();
   return w->Dispatch(uv_write2,
                      stream(),
                      bufs,
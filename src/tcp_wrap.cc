@@ -33,6 +33,16 @@
 
 #include <cstdlib>
 
+#if defined(__linux__)
+#include <linux/filter.h>
+#include <sys/socket.h>
+#endif
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
 
 namespace node {
 
@@ -100,6 +110,10 @@ void TCPWrap::Initialize(Local<Object> target,
                       GetSockOrPeerName<TCPWrap, uv_tcp_getpeername>);
   env->SetProtoMethod(t, "setNoDelay", SetNoDelay);
   env->SetProtoMethod(t, "setKeepAlive", SetKeepAlive);
+  env->SetProtoMethod(t, "attachReusePortCPUFilter", AttachReusePortCPUFilter);
+  env->SetProtoMethod(t, "setAcceptBatchSize", SetAcceptBatchSize);
+  env->SetProtoMethod(t, "setDeferAccept", SetDeferAccept);
+  env->SetProtoMethod(t, "setFastOpen", SetFastOpen);
 
 #ifdef _WIN32
   env->SetProtoMethod(t, "setSimultaneousAccepts", SetSimultaneousAccepts);
@@ -126,6 +140,7 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, UV_TCP_REUSEPORT);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -192,6 +207,106 @@ void TCPWrap::SetKeepAlive(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Makes the kernel hand each connection to the listener of the SO_REUSEPORT
+// group whose index is the CPU that received it. Listeners get their index
+// in the order in which they start listening. The filter applies to the
+// whole group, so it has to be attached after listen().
+void TCPWrap::AttachReusePortCPUFilter(
+    const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (err == 0) {
+    sock_filter code[] = {
+      // A = the CPU that is processing the packet.
+      { BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF + SKF_AD_CPU },
+      // Use the listener at index A. If there is none, the kernel falls
+      // back to picking one by the connection's hash.
+      { BPF_RET | BPF_A, 0, 0, 0 },
+    };
+    sock_fprog prog = { arraysize(code), code };
+    if (setsockopt(fd,
+                   SOL_SOCKET,
+                   SO_ATTACH_REUSEPORT_CBPF,
+                   &prog,
+                   sizeof(prog)) != 0) {
+      err = uv_translate_sys_error(errno);
+    }
+  }
+#else
+  int err = UV_ENOTSUP;
+#endif
+  args.GetReturnValue().Set(err);
+}
+
+
+void TCPWrap::SetAcceptBatchSize(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsUint32());
+  uint32_t size = args[0].As<Uint32>()->Value();
+  CHECK_GE(size, 1);
+  wrap->accept_batch_size_ = size;
+}
+
+
+#ifndef _WIN32
+static int SetTCPOption(uv_tcp_t* handle, int option, int value) {
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(handle), &fd);
+  if (err != 0)
+    return err;
+  if (setsockopt(fd, IPPROTO_TCP, option, &value, sizeof(value)) != 0)
+    return uv_translate_sys_error(errno);
+  return 0;
+}
+#endif
+
+
+// Makes the kernel hold back connections until the client has sent data,
+// or until |seconds| have passed.
+void TCPWrap::SetDeferAccept(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsUint32());
+#ifdef TCP_DEFER_ACCEPT
+  int seconds = static_cast<int>(args[0].As<Uint32>()->Value());
+  int err = SetTCPOption(&wrap->handle_, TCP_DEFER_ACCEPT, seconds);
+#else
+  int err = UV_ENOTSUP;
+#endif
+  args.GetReturnValue().Set(err);
+}
+
+
+// Lets clients send data in the SYN packet. |queue_length| limits the
+// number of such connections that have not been accepted yet. macOS only
+// knows on and off.
+void TCPWrap::SetFastOpen(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsUint32());
+#if defined(TCP_FASTOPEN) && !defined(_WIN32)
+  int queue_length = static_cast<int>(args[0].As<Uint32>()->Value());
+#ifdef __APPLE__
+  queue_length = queue_length > 0;
+#endif
+  int err = SetTCPOption(&wrap->handle_, TCP_FASTOPEN, queue_length);
+#else
+  int err = UV_ENOTSUP;
+#endif
+  args.GetReturnValue().Set(err);
+}
+
+
 #ifdef _WIN32
 void TCPWrap::SetSimultaneousAccepts(const FunctionCallbackInfo<Value>& args) {
   TCPWrap* wrap;
@@ -236,10 +351,7 @@ void TCPWrap::Bind(
   int port;
   unsigned int flags = 0;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
-  if (family == AF_INET6 &&
-      !args[2]->Uint32Value(env->context()).To(&flags)) {
-    return;
-  }
+  if (!args[2]->Uint32Value(env->context()).To(&flags)) return;
 
   T addr;
   int err = uv_ip_addr(*ip_address, port, &addr);
@@ -25,28 +25,86 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "util-inl.h"
+#include "env-inl.h"
 #include "node_internals.h"
+#include "node_threadpool.h"
 
 namespace node {
 
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
+  queued_at_ = uv_hrtime();
+  pool_ = threadpool::ForProvider(provider_);
+  if (pool_ != nullptr) {
+    // The work may be scheduled again after an earlier run was cancelled.
+    status_ = 0;
+    int status = uv_async_init(
+        env_->event_loop(),
+        &done_async_,
+        [](uv_async_t* handle) {
+          uv_close(reinterpret_cast<uv_handle_t*>(handle), [](uv_handle_t* h) {
+            ThreadPoolWork* self =
+                ContainerOf(&ThreadPoolWork::done_async_,
+                            reinterpret_cast<uv_async_t*>(h));
+            // This may delete |self|.
+            self->AfterWork(self->status_);
+          });
+        });
+    CHECK_EQ(status, 0);
+    pool_->Post(this);
+    return;
+  }
   int status = uv_queue_work(
       env_->event_loop(),
       &work_req_,
       [](uv_work_t* req) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
+        self->started_at_ = uv_hrtime();
         self->DoThreadPoolWork();
+        self->finished_at_ = uv_hrtime();
       },
       [](uv_work_t* req, int status) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
-        self->env_->DecreaseWaitingRequestCounter();
-        self->AfterThreadPoolWork(status);
+        // This may delete |self|.
+        self->AfterWork(status);
       });
   CHECK_EQ(status, 0);
 }
 
+void ThreadPoolWork::RunOnWorkerPool() {
+  started_at_ = uv_hrtime();
+  DoThreadPoolWork();
+  finished_at_ = uv_hrtime();
+  CHECK_EQ(uv_async_send(&done_async_), 0);
+}
+
+void ThreadPoolWork::AfterWork(int status) {
+  env_->DecreaseWaitingRequestCounter();
+  if (status == 0)
+    RecordIOStats();
+  AfterThreadPoolWork(status);
+}
+
+void ThreadPoolWork::RecordIOStats() {
+  performance::performance_state* state = env_->performance_state();
+  state->RecordIO(provider_,
+                  performance::NODE_PERFORMANCE_IO_STAT_THREADPOOL_REQUESTS);
+  state->RecordIO(provider_,
+                  performance::NODE_PERFORMANCE_IO_STAT_THREADPOOL_QUEUE_TIME,
+                  started_at_ - queued_at_);
+  state->RecordIO(provider_,
+                  performance::NODE_PERFORMANCE_IO_STAT_THREADPOOL_RUN_TIME,
+                  finished_at_ - started_at_);
+}
+
 int ThreadPoolWork::CancelWork() {
+  if (pool_ != nullptr) {
+    if (!pool_->Cancel(this))
+      return UV_EBUSY;
+    status_ = UV_ECANCELED;
+    CHECK_EQ(uv_async_send(&done_async_), 0);
+    return 0;
+  }
   return uv_cancel(reinterpret_cast<uv_req_t*>(&work_req_));
 }
 
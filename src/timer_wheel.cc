@@ -0,0 +1,228 @@
+#include "timer_wheel.h"
+#include "util.h"
+
+#include <algorithm>
+
+namespace node {
+
+namespace {
+
+// |word| must not be zero.
+int LowestSetBit(uint64_t word) {
+  int bit = 0;
+  while ((word & 0xff) == 0) {
+    word >>= 8;
+    bit += 8;
+  }
+  while ((word & 1) == 0) {
+    word >>= 1;
+    bit++;
+  }
+  return bit;
+}
+
+}  // anonymous namespace
+
+constexpr uint32_t TimerWheel::kNoTimer;
+
+TimerWheel::TimerWheel() {
+  for (Level& level : levels_) {
+    level.head.fill(kNoTimer);
+    level.tail.fill(kNoTimer);
+    level.occupied.fill(0);
+  }
+}
+
+uint32_t TimerWheel::Insert(int64_t expiry, double order) {
+  CHECK_GE(expiry, 0);
+  uint32_t timer;
+  if (free_list_ != kNoTimer) {
+    timer = free_list_;
+    free_list_ = timers_[timer].next;
+  } else {
+    CHECK_LT(timers_.size(), kNoTimer);
+    timer = static_cast<uint32_t>(timers_.size());
+    timers_.emplace_back();
+  }
+
+  Timer& t = timers_[timer];
+  t.expiry = std::max(expiry, current_ + 1);
+  t.order = order;
+  t.state = State::kScheduled;
+  scheduled_++;
+  size_++;
+  Place(timer);
+  return timer;
+}
+
+void TimerWheel::Cancel(uint32_t timer) {
+  CHECK_LT(timer, timers_.size());
+  Timer& t = timers_[timer];
+  if (t.state == State::kScheduled) {
+    Unlink(timer);
+    Release(timer);
+    scheduled_--;
+  } else {
+    // The handle is still in |expired_|, TakeExpired() releases it.
+    CHECK_EQ(t.state, State::kExpired);
+    t.state = State::kCancelled;
+  }
+  size_--;
+}
+
+void TimerWheel::Advance(int64_t now) {
+  if (now <= current_)
+    return;
+
+  const size_t first_expired = expired_.size();
+  int level;
+  int slot;
+  while (FindNextSlot(&level, &slot)) {
+    const int64_t time = SlotTime(level, slot);
+    if (time > now)
+      break;
+    current_ = time;
+
+    if (level > 0) {
+      Redistribute(level, slot);
+      continue;
+    }
+
+    Level& timers = levels_[0];
+    for (uint32_t timer = timers.head[slot]; timer != kNoTimer;
+         timer = timers_[timer].next) {
+      timers_[timer].state = State::kExpired;
+      expired_.push_back(timer);
+      scheduled_--;
+    }
+    timers.head[slot] = timers.tail[slot] = kNoTimer;
+    timers.occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+  }
+  current_ = now;
+
+  std::stable_sort(expired_.begin() + first_expired, expired_.end(),
+                   [this](uint32_t a, uint32_t b) {
+                     const Timer& x = timers_[a];
+                     const Timer& y = timers_[b];
+                     if (x.expiry != y.expiry)
+                       return x.expiry < y.expiry;
+                     return x.order < y.order;
+                   });
+}
+
+size_t TimerWheel::TakeExpired(uint32_t* out, size_t count) {
+  size_t taken = 0;
+  while (taken < count && expired_pos_ < expired_.size()) {
+    const uint32_t timer = expired_[expired_pos_++];
+    if (timers_[timer].state == State::kExpired) {
+      out[taken++] = timer;
+      size_--;
+    }
+    Release(timer);
+  }
+  if (expired_pos_ == expired_.size()) {
+    expired_.clear();
+    expired_pos_ = 0;
+  }
+  return taken;
+}
+
+int64_t TimerWheel::NextWakeup() const {
+  int level;
+  int slot;
+  if (!FindNextSlot(&level, &slot))
+    return -1;
+  return SlotTime(level, slot);
+}
+
+bool TimerWheel::FindNextSlot(int* level, int* slot) const {
+  if (scheduled_ == 0)
+    return false;
+  // Every occupied slot lies after the current time, and all slots of a
+  // level come before those of the levels above it.
+  for (int i = 0; i < kLevels; i++) {
+    const std::array<uint64_t, kSlotsPerLevel / 64>& occupied =
+        levels_[i].occupied;
+    for (size_t j = 0; j < occupied.size(); j++) {
+      if (occupied[j] != 0) {
+        *level = i;
+        *slot = static_cast<int>(j * 64) + LowestSetBit(occupied[j]);
+        return true;
+      }
+    }
+  }
+  UNREACHABLE();
+}
+
+int64_t TimerWheel::SlotTime(int level, int slot) const {
+  const int shift = level * kLevelBits;
+  // The slot lies in the same span of the next level up as the current time.
+  int64_t prefix = 0;
+  if (level + 1 < kLevels)
+    prefix = current_ & ~((int64_t{1} << (shift + kLevelBits)) - 1);
+  return prefix | (static_cast<int64_t>(slot) << shift);
+}
+
+void TimerWheel::Place(uint32_t timer) {
+  Timer& t = timers_[timer];
+  if (t.expiry <= current_) {
+    t.state = State::kExpired;
+    expired_.push_back(timer);
+    scheduled_--;
+    return;
+  }
+
+  const uint64_t diff = static_cast<uint64_t>(t.expiry ^ current_);
+  int level = kLevels - 1;
+  while (level > 0 && (diff >> (level * kLevelBits)) == 0)
+    level--;
+  const int slot = SlotOf(t.expiry, level);
+
+  Level& timers = levels_[level];
+  t.level = static_cast<uint8_t>(level);
+  t.slot = static_cast<uint8_t>(slot);
+  t.next = kNoTimer;
+  t.prev = timers.tail[slot];
+  if (t.prev != kNoTimer)
+    timers_[t.prev].next = timer;
+  else
+    timers.head[slot] = timer;
+  timers.tail[slot] = timer;
+  timers.occupied[slot / 64] |= uint64_t{1} << (slot % 64);
+}
+
+void TimerWheel::Unlink(uint32_t timer) {
+  Timer& t = timers_[timer];
+  Level& timers = levels_[t.level];
+  if (t.prev != kNoTimer)
+    timers_[t.prev].next = t.next;
+  else
+    timers.head[t.slot] = t.next;
+  if (t.next != kNoTimer)
+    timers_[t.next].prev = t.prev;
+  else
+    timers.tail[t.slot] = t.prev;
+  if (timers.head[t.slot] == kNoTimer)
+    timers.occupied[t.slot / 64] &= ~(uint64_t{1} << (t.slot % 64));
+}
+
+void TimerWheel::Release(uint32_t timer) {
+  Timer& t = timers_[timer];
+  t.state = State::kFree;
+  t.next = free_list_;
+  free_list_ = timer;
+}
+
+void TimerWheel::Redistribute(int level, int slot) {
+  Level& timers = levels_[level];
+  uint32_t timer = timers.head[slot];
+  timers.head[slot] = timers.tail[slot] = kNoTimer;
+  timers.occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+  while (timer != kNoTimer) {
+    const uint32_t next = timers_[timer].next;
+    Place(timer);
+    timer = next;
+  }
+}
+
+}  // namespace node
@@ -0,0 +1,117 @@
+#ifndef SRC_TIMER_WHEEL_H_
+#define SRC_TIMER_WHEEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace node {
+
+// A hierarchical timing wheel, used to order the per-duration timer lists
+// of lib/internal/timers.js by their expiry.
+//
+// Times are non-negative millisecond counts. The wheel has one level for each
+// byte of a time value, with 256 slots per level. A timer is kept at the
+// level of the most significant byte in which its expiry differs from the
+// wheel's current time, in the slot given by that byte of the expiry. When
+// the current time reaches the start of a slot above level 0, the timers in
+// it are redistributed to the lower levels; the level-0 slot for a given
+// millisecond holds exactly the timers that expire then. Inserting and
+// cancelling a timer is O(1), and finding the next slot to visit only needs
+// to scan a per-level occupancy bitmap.
+//
+// Timers are identified by a handle that stays valid until the timer has
+// either been cancelled or been returned by TakeExpired().
+class TimerWheel {
+ public:
+  static constexpr uint32_t kNoTimer = 0xffffffff;
+
+  TimerWheel();
+
+  // Schedules a timer expiring at |expiry|. Timers that expire at the same
+  // time are returned by TakeExpired() in increasing |order|. Expiry times
+  // that have already passed are treated as expiring on the next
+  // millisecond.
+  uint32_t Insert(int64_t expiry, double order);
+  // Cancels a timer that was returned by Insert() and has not been returned
+  // by TakeExpired() yet.
+  void Cancel(uint32_t timer);
+
+  // Moves the wheel forward to |now|, queueing all timers that expire at or
+  // before it. Calls with a |now| earlier than a previous one are no-ops.
+  void Advance(int64_t now);
+  // Copies up to |count| handles of expired timers to |out|, in order of
+  // expiry, and returns how many were copied. The handles become invalid.
+  size_t TakeExpired(uint32_t* out, size_t count);
+
+  // Returns the earliest time at which Advance() has work to do, or -1 if
+  // no timers are scheduled. This can be a little earlier than the next
+  // expiry when a slot on one of the upper levels has to be redistributed.
+  int64_t NextWakeup() const;
+
+  bool has_expired() const { return expired_pos_ < expired_.size(); }
+  // The number of timers that are scheduled or expired but not taken yet.
+  size_t size() const { return size_; }
+  int64_t current_time() const { return current_; }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+ private:
+  static constexpr int kLevelBits = 8;
+  static constexpr int kSlotsPerLevel = 1 << kLevelBits;
+  static constexpr int kLevels = 8;
+
+  enum class State : uint8_t { kFree, kScheduled, kExpired, kCancelled };
+
+  struct Timer {
+    int64_t expiry;
+    double order;
+    // Links within a slot, or within the free list.
+    uint32_t prev;
+    uint32_t next;
+    uint8_t level;
+    uint8_t slot;
+    State state;
+  };
+
+  struct Level {
+    std::array<uint32_t, kSlotsPerLevel> head;
+    std::array<uint32_t, kSlotsPerLevel> tail;
+    std::array<uint64_t, kSlotsPerLevel / 64> occupied;
+  };
+
+  static int SlotOf(int64_t time, int level) {
+    return static_cast<int>((time >> (level * kLevelBits)) &
+                            (kSlotsPerLevel - 1));
+  }
+
+  // Finds the next slot that Advance() has to visit.
+  bool FindNextSlot(int* level, int* slot) const;
+  // Returns the time at which the current time enters |slot| of |level|.
+  int64_t SlotTime(int level, int slot) const;
+  // Files |timer| under the wheel's current time, or queues it as expired.
+  void Place(uint32_t timer);
+  void Unlink(uint32_t timer);
+  void Release(uint32_t timer);
+  // Places every timer of a slot again. Used when the current time enters it.
+  void Redistribute(int level, int slot);
+
+  std::vector<Timer> timers_;
+  uint32_t free_list_ = kNoTimer;
+  std::array<Level, kLevels> levels_;
+  std::vector<uint32_t> expired_;
+  size_t expired_pos_ = 0;
+  int64_t current_ = 0;
+  size_t scheduled_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_TIMER_WHEEL_H_
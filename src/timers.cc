@@ -13,7 +13,9 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::Integer;
 using v8::Local;
+using v8::Number;
 using v8::Object;
+using v8::Uint32;
 using v8::Value;
 
 void SetupTimers(const FunctionCallbackInfo<Value>& args) {
@@ -30,9 +32,33 @@ void GetLibuvNow(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(env->GetNow());
 }
 
-void ScheduleTimer(const FunctionCallbackInfo<Value>& args) {
+void ScheduleTimersList(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
   auto env = Environment::GetCurrent(args);
-  env->ScheduleTimer(args[0]->IntegerValue(env->context()).FromJust());
+  int64_t expiry = args[0]->IntegerValue(env->context()).FromJust();
+  uint32_t handle =
+      env->timer_wheel()->Insert(expiry, args[1].As<Number>()->Value());
+  env->ScheduleTimerAt(env->timer_wheel()->NextWakeup());
+  args.GetReturnValue().Set(handle);
+}
+
+void UnscheduleTimersList(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsUint32());
+  auto env = Environment::GetCurrent(args);
+  env->timer_wheel()->Cancel(args[0].As<Uint32>()->Value());
+}
+
+// Fills the expiredTimers array with the handles of lists that have expired
+// and returns how many there are. Returns 0 once all have been taken.
+void TakeExpiredTimers(const FunctionCallbackInfo<Value>& args) {
+  auto env = Environment::GetCurrent(args);
+  AliasedUint32Array& expired = env->expired_timers();
+  uint32_t handles[Environment::kExpiredTimersBatchSize];
+  size_t count = env->timer_wheel()->TakeExpired(handles, arraysize(handles));
+  for (size_t i = 0; i < count; i++)
+    expired[i] = handles[i];
+  args.GetReturnValue().Set(static_cast<uint32_t>(count));
 }
 
 void ToggleTimerRef(const FunctionCallbackInfo<Value>& args) {
@@ -51,13 +77,18 @@ void Initialize(Local<Object> target,
 
   env->SetMethod(target, "getLibuvNow", GetLibuvNow);
   env->SetMethod(target, "setupTimers", SetupTimers);
-  env->SetMethod(target, "scheduleTimer", ScheduleTimer);
+  env->SetMethod(target, "scheduleTimersList", ScheduleTimersList);
+  env->SetMethod(target, "unscheduleTimersList", UnscheduleTimersList);
+  env->SetMethod(target, "takeExpiredTimers", TakeExpiredTimers);
   env->SetMethod(target, "toggleTimerRef", ToggleTimerRef);
   env->SetMethod(target, "toggleImmediateRef", ToggleImmediateRef);
 
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "immediateInfo"),
               env->immediate_info()->fields().GetJSArray()).Check();
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "expiredTimers"),
+              env->expired_timers().GetJSArray()).Check();
 }
 
 
@@ -1,5 +1,6 @@
 #include "tracing/node_trace_writer.h"
 
+#include "tracing/trace_event.h"
 #include "util-inl.h"
 
 #include <fcntl.h>
@@ -8,8 +9,137 @@
 namespace node {
 namespace tracing {
 
-NodeTraceWriter::NodeTraceWriter(const std::string& log_file_pattern)
-    : log_file_pattern_(log_file_pattern) {}
+namespace {
+
+// Field numbers and wire types from Perfetto's trace.proto,
+// trace_packet.proto and chrome_trace_event.proto.
+enum WireType { kVarint = 0, kFixed64 = 1, kLengthDelimited = 2 };
+
+const uint32_t kTracePacket = 1;
+const uint32_t kTracePacketChromeEvents = 5;
+const uint32_t kChromeEventBundleTraceEvents = 1;
+
+enum ChromeTraceEventField : uint32_t {
+  kEventName = 1,
+  kEventTimestamp = 2,
+  kEventPhase = 3,
+  kEventThreadId = 4,
+  kEventDuration = 5,
+  kEventThreadDuration = 6,
+  kEventScope = 7,
+  kEventId = 8,
+  kEventFlags = 9,
+  kEventCategoryGroupName = 10,
+  kEventProcessId = 11,
+  kEventThreadTimestamp = 12,
+  kEventBindId = 13,
+  kEventArgs = 14
+};
+
+enum ChromeTraceEventArgField : uint32_t {
+  kArgName = 1,
+  kArgBoolValue = 2,
+  kArgUintValue = 3,
+  kArgIntValue = 4,
+  kArgDoubleValue = 5,
+  kArgStringValue = 6,
+  kArgPointerValue = 7,
+  kArgJsonValue = 8
+};
+
+void AppendVarint(std::string* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendTag(std::string* out, uint32_t field, WireType type) {
+  AppendVarint(out, (field << 3) | type);
+}
+
+void AppendVarintField(std::string* out, uint32_t field, uint64_t value) {
+  AppendTag(out, field, kVarint);
+  AppendVarint(out, value);
+}
+
+// Negative int32 and int64 values are sign-extended to 64 bits.
+void AppendIntField(std::string* out, uint32_t field, int64_t value) {
+  AppendVarintField(out, field, static_cast<uint64_t>(value));
+}
+
+void AppendDoubleField(std::string* out, uint32_t field, double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  AppendTag(out, field, kFixed64);
+  for (int i = 0; i < 8; i++)
+    out->push_back(static_cast<char>(bits >> (i * 8)));
+}
+
+void AppendBytesField(std::string* out,
+                      uint32_t field,
+                      const char* data,
+                      size_t length) {
+  AppendTag(out, field, kLengthDelimited);
+  AppendVarint(out, length);
+  out->append(data, length);
+}
+
+void AppendStringField(std::string* out, uint32_t field, const char* str) {
+  if (str != nullptr)
+    AppendBytesField(out, field, str, strlen(str));
+}
+
+void AppendArg(std::string* out,
+               const char* name,
+               uint8_t type,
+               const TraceObject::ArgValue& value,
+               v8::ConvertableToTraceFormat* convertable) {
+  std::string arg;
+  AppendStringField(&arg, kArgName, name);
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      AppendVarintField(&arg, kArgBoolValue, value.as_bool ? 1 : 0);
+      break;
+    case TRACE_VALUE_TYPE_UINT:
+      AppendVarintField(&arg, kArgUintValue, value.as_uint);
+      break;
+    case TRACE_VALUE_TYPE_INT:
+      AppendIntField(&arg, kArgIntValue, value.as_int);
+      break;
+    case TRACE_VALUE_TYPE_DOUBLE:
+      AppendDoubleField(&arg, kArgDoubleValue, value.as_double);
+      break;
+    case TRACE_VALUE_TYPE_POINTER:
+      AppendVarintField(&arg, kArgPointerValue,
+                        reinterpret_cast<uintptr_t>(value.as_pointer));
+      break;
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING:
+      AppendStringField(&arg, kArgStringValue,
+                        value.as_string != nullptr ? value.as_string : "NULL");
+      break;
+    case TRACE_VALUE_TYPE_CONVERTABLE: {
+      std::string json;
+      convertable->AppendAsTraceFormat(&json);
+      AppendBytesField(&arg, kArgJsonValue, json.data(), json.size());
+      break;
+    }
+    default:
+      UNREACHABLE();
+  }
+  AppendBytesField(out, kEventArgs, arg.data(), arg.size());
+}
+
+}  // anonymous namespace
+
+NodeTraceWriter::NodeTraceWriter(const std::string& log_file_pattern,
+                                 Format format,
+                                 uint64_t max_file_size)
+    : log_file_pattern_(log_file_pattern),
+      format_(format),
+      max_file_size_(max_file_size) {}
 
 void NodeTraceWriter::InitializeOnThread(uv_loop_t* loop) {
   CHECK_NULL(tracing_loop_);
@@ -101,16 +231,78 @@ void NodeTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
   // If this is the first trace event, open a new file for streaming.
   if (total_traces_ == 0) {
     OpenNewFileForStreaming();
+    file_size_ = 0;
     // Constructing a new JSONTraceWriter object appends "{\"traceEvents\":["
     // to stream_.
     // In other words, the constructor initializes the serialization stream
     // to a state where we can start writing trace events to it.
     // Repeatedly constructing and destroying json_trace_writer_ allows
     // us to use V8's JSON writer instead of implementing our own.
-    json_trace_writer_.reset(TraceWriter::CreateJSONTraceWriter(stream_));
+    if (format_ == Format::kJSON)
+      json_trace_writer_.reset(TraceWriter::CreateJSONTraceWriter(stream_));
   }
   ++total_traces_;
-  json_trace_writer_->AppendTraceEvent(trace_event);
+  if (format_ == Format::kProto)
+    AppendProtoTraceEvent(trace_event);
+  else
+    json_trace_writer_->AppendTraceEvent(trace_event);
+}
+
+// Serializes the event as a ChromeTraceEvent message, mirroring the fields
+// that V8's JSONTraceWriter emits.
+void NodeTraceWriter::AppendProtoTraceEvent(TraceObject* trace_event) {
+  std::string* event = &proto_event_;
+  event->clear();
+  AppendStringField(event, kEventName, trace_event->name());
+  AppendIntField(event, kEventTimestamp, trace_event->ts());
+  AppendIntField(event, kEventPhase, trace_event->phase());
+  AppendIntField(event, kEventThreadId, trace_event->tid());
+  AppendIntField(event, kEventProcessId, trace_event->pid());
+  AppendIntField(event, kEventThreadTimestamp, trace_event->tts());
+  if (trace_event->phase() == TRACE_EVENT_PHASE_COMPLETE) {
+    AppendVarintField(event, kEventDuration, trace_event->duration());
+    AppendVarintField(event, kEventThreadDuration,
+                      trace_event->cpu_duration());
+  }
+  AppendStringField(event, kEventScope, trace_event->scope());
+  if (trace_event->flags() & TRACE_EVENT_FLAG_HAS_ID)
+    AppendVarintField(event, kEventId, trace_event->id());
+  if (trace_event->flags() &
+      (TRACE_EVENT_FLAG_FLOW_IN | TRACE_EVENT_FLAG_FLOW_OUT)) {
+    AppendVarintField(event, kEventBindId, trace_event->bind_id());
+  }
+  AppendVarintField(event, kEventFlags, trace_event->flags());
+  AppendStringField(event, kEventCategoryGroupName,
+                    TracingController::GetCategoryGroupName(
+                        trace_event->category_enabled_flag()));
+  for (int i = 0; i < trace_event->num_args(); i++) {
+    AppendArg(event,
+              trace_event->arg_names()[i],
+              trace_event->arg_types()[i],
+              trace_event->arg_values()[i],
+              trace_event->arg_convertables()[i].get());
+  }
+
+  AppendBytesField(&proto_events_, kChromeEventBundleTraceEvents,
+                   event->data(), event->size());
+}
+
+// Wraps the pending events into a TracePacket and appends it to stream_.
+// A Perfetto trace is a sequence of packets without a header or trailer, so
+// a file is complete after each packet.
+void NodeTraceWriter::AppendProtoPacket() {
+  if (proto_events_.empty())
+    return;
+  std::string header;
+  std::string bundle_header;
+  AppendTag(&bundle_header, kTracePacketChromeEvents, kLengthDelimited);
+  AppendVarint(&bundle_header, proto_events_.size());
+  AppendTag(&header, kTracePacket, kLengthDelimited);
+  AppendVarint(&header, bundle_header.size() + proto_events_.size());
+  header += bundle_header;
+  stream_.write(header.data(), header.size());
+  stream_.write(proto_events_.data(), proto_events_.size());
+  proto_events_.clear();
 }
 
 void NodeTraceWriter::FlushPrivate() {
@@ -118,7 +310,12 @@ void NodeTraceWriter::FlushPrivate() {
   int highest_request_id;
   {
     Mutex::ScopedLock stream_scoped_lock(stream_mutex_);
-    if (total_traces_ >= kTracesPerFile) {
+    if (format_ == Format::kProto)
+      AppendProtoPacket();
+    if (total_traces_ >= kTracesPerFile ||
+        (max_file_size_ > 0 &&
+         file_size_ + static_cast<uint64_t>(stream_.tellp()) >=
+             max_file_size_)) {
       total_traces_ = 0;
       // Destroying the member JSONTraceWriter object appends "]}" to
       // stream_ - in other words, ending a JSON file.
@@ -126,6 +323,7 @@ void NodeTraceWriter::FlushPrivate() {
     }
     // str() makes a copy of the contents of the stream.
     str = stream_.str();
+    file_size_ += str.size();
     stream_.str("");
     stream_.clear();
   }
@@ -143,7 +341,7 @@ void NodeTraceWriter::Flush(bool blocking) {
     // protects json_trace_writer_, and without request_mutex_ there might be
     // a time window in which the stream state changes?
     Mutex::ScopedLock stream_mutex_lock(stream_mutex_);
-    if (!json_trace_writer_)
+    if (total_traces_ == 0)
       return;
   }
   int request_id = ++num_write_requests_;
@@ -16,7 +16,19 @@ using v8::platform::tracing::TraceWriter;
 
 class NodeTraceWriter : public AsyncTraceWriter {
  public:
-  explicit NodeTraceWriter(const std::string& log_file_pattern);
+  enum class Format {
+    // The Trace Event Format, as read by chrome://tracing.
+    kJSON,
+    // A Perfetto trace (a protobuf-encoded perfetto.protos.Trace) holding the
+    // events in ChromeEventBundle packets, as read by ui.perfetto.dev.
+    kProto
+  };
+
+  // Files are rotated when they hold kTracesPerFile trace events or, if
+  // max_file_size is not 0, when they reach about max_file_size bytes.
+  explicit NodeTraceWriter(const std::string& log_file_pattern,
+                           Format format = Format::kJSON,
+                           uint64_t max_file_size = 0);
   ~NodeTraceWriter() override;
 
   void InitializeOnThread(uv_loop_t* loop) override;
@@ -37,6 +49,8 @@ class NodeTraceWriter : public AsyncTraceWriter {
   void WriteToFile(std::string&& str, int highest_request_id);
   void WriteSuffix();
   void FlushPrivate();
+  void AppendProtoTraceEvent(TraceObject* trace_event);
+  void AppendProtoPacket();
   static void ExitSignalCb(uv_async_t* signal);
 
   uv_loop_t* tracing_loop_ = nullptr;
@@ -45,8 +59,8 @@ class NodeTraceWriter : public AsyncTraceWriter {
   // Triggers callback to close async objects, ending the tracing thread.
   uv_async_t exit_signal_;
   // Prevents concurrent R/W on state related to serialized trace data
-  // before it's written to disk, namely stream_ and total_traces_
-  // as well as json_trace_writer_.
+  // before it's written to disk, namely stream_, total_traces_, file_size_
+  // and proto_events_ as well as json_trace_writer_.
   Mutex stream_mutex_;
   // Prevents concurrent R/W on state related to write requests.
   // If both mutexes are locked, request_mutex_ has to be locked first.
@@ -64,8 +78,16 @@ class NodeTraceWriter : public AsyncTraceWriter {
   int total_traces_ = 0;
   int file_num_ = 0;
   std::string log_file_pattern_;
+  Format format_;
+  uint64_t max_file_size_;
+  // Number of bytes handed off for writing to the current file.
+  uint64_t file_size_ = 0;
   std::ostringstream stream_;
   std::unique_ptr<TraceWriter> json_trace_writer_;
+  // Serialized ChromeTraceEvent messages that have not been wrapped into a
+  // packet in stream_ yet, and scratch space for serializing one of them.
+  std::string proto_events_;
+  std::string proto_event_;
   bool exited_ = false;
 };
 
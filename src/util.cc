@@ -203,6 +203,39 @@ int WriteFileSync(v8::Isolate* isolate,
   return WriteFileSync(path, buf);
 }
 
+int ReadFileSync(std::string* result, const char* path) {
+  uv_fs_t req;
+  int fd = uv_fs_open(nullptr, &req, path, O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) {
+    return fd;
+  }
+
+  std::shared_ptr<void> defer_close(nullptr, [fd](...) {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  });
+
+  *result = std::string("");
+  char buffer[4096];
+  uv_buf_t buf = uv_buf_init(buffer, sizeof(buffer));
+
+  while (true) {
+    const int r =
+        uv_fs_read(nullptr, &req, fd, &buf, 1, result->length(), nullptr);
+    uv_fs_req_cleanup(&req);
+    if (r < 0) {
+      return r;
+    }
+    if (r == 0) {
+      break;
+    }
+    result->append(buf.base, r);
+  }
+  return 0;
+}
+
 void DiagnosticFilename::LocalTime(TIME_TYPE* tm_struct) {
 #ifdef _WIN32
   GetLocalTime(tm_struct);
@@ -0,0 +1,139 @@
+'use strict';
+
+// Tests that AsyncLocalStorage stores propagate through timers, nextTick,
+// native I/O, AsyncResource and promises, and that they do not leak into
+// unrelated callbacks.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const http = require('http');
+const { AsyncLocalStorage, AsyncResource, createHook } =
+  require('async_hooks');
+
+const storage = new AsyncLocalStorage();
+assert.strictEqual(storage.getStore(), undefined);
+
+// Resources created outside of run() do not see the store.
+const outsideResource = new AsyncResource('Outside');
+
+storage.run('timers', () => {
+  assert.strictEqual(storage.getStore(), 'timers');
+  setTimeout(common.mustCall(() => {
+    assert.strictEqual(storage.getStore(), 'timers');
+  }), 1);
+  setImmediate(common.mustCall(() => {
+    assert.strictEqual(storage.getStore(), 'timers');
+  }));
+  process.nextTick(common.mustCall(() => {
+    assert.strictEqual(storage.getStore(), 'timers');
+  }));
+  outsideResource.runInAsyncScope(common.mustCall(() => {
+    assert.strictEqual(storage.getStore(), undefined);
+  }));
+  assert.strictEqual(storage.getStore(), 'timers');
+});
+assert.strictEqual(storage.getStore(), undefined);
+
+storage.run('fs', () => {
+  fs.stat(__filename, common.mustCall(() => {
+    assert.strictEqual(storage.getStore(), 'fs');
+  }));
+});
+
+// Promise reactions see the store that was current when they were set up.
+storage.run('promises', common.mustCall(async () => {
+  await null;
+  assert.strictEqual(storage.getStore(), 'promises');
+  await new Promise((resolve) => setTimeout(resolve, 1));
+  assert.strictEqual(storage.getStore(), 'promises');
+}));
+{
+  const promise = storage.run('then', () => Promise.resolve());
+  promise.then(common.mustCall(() => {
+    assert.strictEqual(storage.getStore(), undefined);
+  }));
+  storage.run('reaction', () => {
+    promise.then(common.mustCall(() => {
+      assert.strictEqual(storage.getStore(), 'reaction');
+    }));
+  });
+}
+
+// Nested run(), exit() and several instances.
+{
+  const other = new AsyncLocalStorage();
+  storage.run('outer', () => {
+    other.run('other', () => {
+      storage.run('inner', () => {
+        setImmediate(common.mustCall(() => {
+          assert.strictEqual(storage.getStore(), 'inner');
+          assert.strictEqual(other.getStore(), 'other');
+        }));
+      });
+      assert.strictEqual(storage.getStore(), 'outer');
+      storage.exit(() => {
+        assert.strictEqual(storage.getStore(), undefined);
+        assert.strictEqual(other.getStore(), 'other');
+        setImmediate(common.mustCall(() => {
+          assert.strictEqual(storage.getStore(), undefined);
+          assert.strictEqual(other.getStore(), 'other');
+        }));
+      });
+    });
+  });
+}
+
+// Concurrent HTTP requests each get their own store.
+{
+  const server = http.createServer((req, res) => {
+    storage.run(req.url, () => {
+      setTimeout(() => {
+        Promise.resolve().then(() => res.end(storage.getStore()));
+      }, 5);
+    });
+  });
+  server.listen(0, common.mustCall(() => {
+    let pending = 3;
+    for (let i = 0; i < 3; i++) {
+      storage.run(`client ${i}`, () => {
+        http.get({ port: server.address().port, path: `/${i}` },
+                 common.mustCall((res) => {
+                   assert.strictEqual(storage.getStore(), `client ${i}`);
+                   let body = '';
+                   res.setEncoding('utf8');
+                   res.on('data', (chunk) => body += chunk);
+                   res.on('end', common.mustCall(() => {
+                     assert.strictEqual(body, `/${i}`);
+                     if (--pending === 0)
+                       server.close();
+                   }));
+                 }));
+      });
+    }
+  }));
+}
+
+// Stores also propagate while async_hooks are enabled.
+{
+  const hook = createHook({ init() {} }).enable();
+  storage.run('with hooks', async () => {
+    await null;
+    assert.strictEqual(storage.getStore(), 'with hooks');
+    hook.disable();
+  });
+}
+
+// enterWith() and disable().
+{
+  const disabled = new AsyncLocalStorage();
+  setImmediate(common.mustCall(() => {
+    disabled.enterWith('entered');
+    assert.strictEqual(disabled.getStore(), 'entered');
+    setImmediate(common.mustCall(() => {
+      assert.strictEqual(disabled.getStore(), 'entered');
+      disabled.disable();
+      assert.strictEqual(disabled.getStore(), undefined);
+    }));
+  }));
+}
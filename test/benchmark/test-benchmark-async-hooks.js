@@ -12,7 +12,10 @@ const runBenchmark = require('../common/benchmark');
 
 runBenchmark('async_hooks',
              [
+               'asyncHooks=enabled',
+               'connections=1',
                'method=trackingDisabled',
-               'n=10'
+               'n=10',
+               'type=async-local-storage'
              ],
              {});
@@ -8,8 +8,12 @@ runBenchmark('module', [
   'cache=true',
   'dir=rel',
   'ext=',
+  'fields=0',
   'fullPath=true',
+  'functions=1',
+  'modules=10',
   'n=1',
   'name=/',
+  'runs=1',
   'useCache=true',
 ]);
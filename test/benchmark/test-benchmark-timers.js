@@ -8,6 +8,7 @@ runBenchmark('timers',
              [
                'direction=start',
                'n=1',
+               'timers=1',
                'type=depth',
              ],
              { NODEJS_BENCHMARK_ZERO_ALLOWED: 1 });
@@ -7,6 +7,7 @@ const runBenchmark = require('../common/benchmark');
 runBenchmark('url',
              [
                'method=legacy',
+               'access=none',
                'e=0',
                'loopMethod=forEach',
                'accessMethod=get',
@@ -0,0 +1,110 @@
+#include "node_package_json.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+using node::loader::PackageJSONFields;
+using node::loader::PackageJSONScanResult;
+using node::loader::ScanPackageJSON;
+
+static PackageJSONScanResult Scan(const std::string& source,
+                                  PackageJSONFields* fields) {
+  return ScanPackageJSON(source.data(), source.size(), fields);
+}
+
+TEST(PackageJSONTest, Simple) {
+  PackageJSONFields fields;
+  ASSERT_EQ(Scan("{\"name\": \"pkg\", \"main\": \"lib/index.js\","
+                 " \"type\": \"module\", \"version\": \"1.0.0\"}", &fields),
+            PackageJSONScanResult::kOk);
+  EXPECT_EQ(fields[PackageJSONFields::kName].kind,
+            PackageJSONFields::Kind::kString);
+  EXPECT_EQ(fields[PackageJSONFields::kName].string, "pkg");
+  EXPECT_EQ(fields[PackageJSONFields::kMain].string, "lib/index.js");
+  EXPECT_EQ(fields[PackageJSONFields::kType].string, "module");
+  EXPECT_EQ(fields[PackageJSONFields::kExports].kind,
+            PackageJSONFields::Kind::kMissing);
+  EXPECT_FALSE(fields.is_null);
+}
+
+TEST(PackageJSONTest, NestedFieldsAreIgnored) {
+  PackageJSONFields fields;
+  ASSERT_EQ(Scan("{\"dependencies\": {\"main\": \"nope\"},"
+                 " \"files\": [\"main\", {\"type\": 1}]}", &fields),
+            PackageJSONScanResult::kOk);
+  EXPECT_EQ(fields[PackageJSONFields::kMain].kind,
+            PackageJSONFields::Kind::kMissing);
+  EXPECT_EQ(fields[PackageJSONFields::kType].kind,
+            PackageJSONFields::Kind::kMissing);
+}
+
+TEST(PackageJSONTest, Escapes) {
+  PackageJSONFields fields;
+  ASSERT_EQ(Scan("{\"m\\u0061in\": \"a\\\\b\\/c\\n\\u00e9\\ud83d\\ude00\"}",
+                 &fields),
+            PackageJSONScanResult::kOk);
+  EXPECT_EQ(fields[PackageJSONFields::kMain].string,
+            "a\\b/c\n\xC3\xA9\xF0\x9F\x98\x80");
+
+  ASSERT_EQ(Scan("{\"main\": \"\\ud800x\"}", &fields),
+            PackageJSONScanResult::kOk);
+  EXPECT_EQ(fields[PackageJSONFields::kMain].string, "\xEF\xBF\xBDx");
+}
+
+TEST(PackageJSONTest, LastDuplicateWins) {
+  PackageJSONFields fields;
+  ASSERT_EQ(Scan("{\"main\": \"a.js\", \"main\": [1, 2]}", &fields),
+            PackageJSONScanResult::kOk);
+  EXPECT_EQ(fields[PackageJSONFields::kMain].kind,
+            PackageJSONFields::Kind::kOther);
+  EXPECT_EQ(fields[PackageJSONFields::kMain].source, "[1, 2]");
+}
+
+TEST(PackageJSONTest, ExportsSource) {
+  PackageJSONFields fields;
+  ASSERT_EQ(Scan("{\"exports\": {\".\": \"./index.js\"} }", &fields),
+            PackageJSONScanResult::kOk);
+  EXPECT_EQ(fields[PackageJSONFields::kExports].kind,
+            PackageJSONFields::Kind::kOther);
+  EXPECT_EQ(fields[PackageJSONFields::kExports].source,
+            "{\".\": \"./index.js\"}");
+}
+
+TEST(PackageJSONTest, NonObjects) {
+  PackageJSONFields fields;
+  EXPECT_EQ(Scan(" [1, -2.5e+3, true, false, \"x\"] ", &fields),
+            PackageJSONScanResult::kOk);
+  EXPECT_FALSE(fields.is_null);
+  EXPECT_EQ(Scan("null", &fields), PackageJSONScanResult::kOk);
+  EXPECT_TRUE(fields.is_null);
+}
+
+TEST(PackageJSONTest, Invalid) {
+  const char* inputs[] = {
+    "",
+    "{",
+    "{\"main\": \"a.js\",}",
+    "{\"main\" \"a.js\"}",
+    "{main: \"a.js\"}",
+    "{\"main\": 'a.js'}",
+    "{\"main\": \"a\tb\"}",
+    "{\"main\": \"\\x\"}",
+    "{\"version\": 01}",
+    "{\"version\": 1.}",
+    "{\"private\": tru}",
+    "{} {}",
+    "\xEF\xBB\xBF{}",
+  };
+  for (const char* input : inputs) {
+    PackageJSONFields fields;
+    EXPECT_EQ(Scan(input, &fields), PackageJSONScanResult::kInvalid) << input;
+  }
+}
+
+TEST(PackageJSONTest, TooDeep) {
+  std::string source = "{\"config\": ";
+  source += std::string(1000, '[') + std::string(1000, ']') + "}";
+  PackageJSONFields fields;
+  EXPECT_EQ(Scan(source, &fields), PackageJSONScanResult::kTooDeep);
+}
@@ -0,0 +1,151 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using node::TimerWheel;
+
+static std::vector<uint32_t> TakeAll(TimerWheel* wheel) {
+  std::vector<uint32_t> timers;
+  uint32_t buffer[3];
+  size_t count;
+  // Use a small buffer so that batches are taken in several chunks.
+  while ((count = wheel->TakeExpired(buffer, 3)) > 0)
+    timers.insert(timers.end(), buffer, buffer + count);
+  return timers;
+}
+
+TEST(TimerWheelTest, Empty) {
+  TimerWheel wheel;
+  EXPECT_EQ(wheel.NextWakeup(), -1);
+  wheel.Advance(1000);
+  EXPECT_FALSE(wheel.has_expired());
+  EXPECT_EQ(wheel.size(), 0u);
+  EXPECT_EQ(wheel.current_time(), 1000);
+}
+
+TEST(TimerWheelTest, ExpiresInOrder) {
+  TimerWheel wheel;
+  const uint32_t c = wheel.Insert(30, 1);
+  const uint32_t a = wheel.Insert(10, 2);
+  const uint32_t b2 = wheel.Insert(20, 4);
+  const uint32_t b1 = wheel.Insert(20, 3);
+  EXPECT_EQ(wheel.size(), 4u);
+  EXPECT_EQ(wheel.NextWakeup(), 10);
+
+  wheel.Advance(9);
+  EXPECT_FALSE(wheel.has_expired());
+  wheel.Advance(20);
+  EXPECT_EQ(TakeAll(&wheel), (std::vector<uint32_t>{ a, b1, b2 }));
+  EXPECT_EQ(wheel.NextWakeup(), 30);
+  wheel.Advance(1000);
+  EXPECT_EQ(TakeAll(&wheel), std::vector<uint32_t>{ c });
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheelTest, Cancel) {
+  TimerWheel wheel;
+  const uint32_t a = wheel.Insert(5, 0);
+  const uint32_t b = wheel.Insert(5, 1);
+  const uint32_t c = wheel.Insert(70000, 2);
+  wheel.Cancel(c);
+  EXPECT_EQ(wheel.NextWakeup(), 5);
+  wheel.Advance(100000);
+  // Timers that have expired but were not taken yet can still be cancelled.
+  wheel.Cancel(a);
+  EXPECT_EQ(wheel.size(), 1u);
+  EXPECT_EQ(TakeAll(&wheel), std::vector<uint32_t>{ b });
+  EXPECT_EQ(wheel.NextWakeup(), -1);
+}
+
+TEST(TimerWheelTest, PastExpiry) {
+  TimerWheel wheel;
+  wheel.Advance(500);
+  const uint32_t timer = wheel.Insert(100, 0);
+  EXPECT_EQ(wheel.NextWakeup(), 501);
+  wheel.Advance(500);
+  EXPECT_FALSE(wheel.has_expired());
+  wheel.Advance(501);
+  EXPECT_EQ(TakeAll(&wheel), std::vector<uint32_t>{ timer });
+}
+
+TEST(TimerWheelTest, HandlesAreReused) {
+  TimerWheel wheel;
+  const uint32_t a = wheel.Insert(1, 0);
+  wheel.Advance(1);
+  EXPECT_EQ(TakeAll(&wheel), std::vector<uint32_t>{ a });
+  EXPECT_EQ(wheel.Insert(2, 1), a);
+}
+
+// Compares the wheel against a brute force model for timers spread across
+// all levels, with the current time moved forward in uneven steps.
+TEST(TimerWheelTest, Random) {
+  struct Expected {
+    int64_t expiry;
+    double order;
+    uint32_t handle;
+    bool cancelled;
+  };
+
+  std::mt19937_64 random(42);
+  TimerWheel wheel;
+  std::vector<Expected> expected;
+  int64_t now = 0;
+  double order = 0;
+
+  for (int round = 0; round < 200; round++) {
+    for (int i = 0; i < 50; i++) {
+      int64_t range = int64_t{1} << (random() % 40);
+      int64_t expiry = now + 1 + static_cast<int64_t>(random() % range);
+      expected.push_back({ expiry, order, wheel.Insert(expiry, order), false });
+      order++;
+    }
+    for (Expected& timer : expected) {
+      if (!timer.cancelled && random() % 20 == 0) {
+        wheel.Cancel(timer.handle);
+        timer.cancelled = true;
+      }
+    }
+
+    int64_t next = wheel.NextWakeup();
+    if (random() % 2 == 0 && next != -1)
+      now = next;
+    else
+      now += static_cast<int64_t>(random() % (int64_t{1} << (random() % 36)));
+    wheel.Advance(now);
+
+    std::vector<Expected> due;
+    std::vector<Expected> remaining;
+    for (const Expected& timer : expected) {
+      if (timer.cancelled)
+        continue;
+      (timer.expiry <= now ? due : remaining).push_back(timer);
+    }
+    std::stable_sort(due.begin(), due.end(),
+                     [](const Expected& a, const Expected& b) {
+                       if (a.expiry != b.expiry)
+                         return a.expiry < b.expiry;
+                       return a.order < b.order;
+                     });
+    std::vector<uint32_t> due_handles;
+    for (const Expected& timer : due)
+      due_handles.push_back(timer.handle);
+
+    ASSERT_EQ(TakeAll(&wheel), due_handles);
+    expected = remaining;
+    ASSERT_EQ(wheel.size(), expected.size());
+    if (!expected.empty()) {
+      int64_t earliest = expected[0].expiry;
+      for (const Expected& timer : expected)
+        earliest = std::min(earliest, timer.expiry);
+      ASSERT_GT(wheel.NextWakeup(), now);
+      ASSERT_LE(wheel.NextWakeup(), earliest);
+    } else {
+      ASSERT_EQ(wheel.NextWakeup(), -1);
+    }
+  }
+}
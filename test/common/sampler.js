@@ -0,0 +1,69 @@
+/* eslint-disable node-core/require-common-first, node-core/required-modules */
+
+'use strict';
+
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('./tmpdir');
+
+// Decodes the fields of a pprof Profile message that the tests look at.
+// Profile.string_table is field 6, with the length-delimited wire type, and
+// Profile.duration_nanos is field 10.
+function parsePprof(profile) {
+  assert(Buffer.isBuffer(profile));
+  const strings = [];
+  let duration;
+  let pos = 0;
+  function varint() {
+    let value = 0;
+    let shift = 0;
+    let byte;
+    do {
+      byte = profile[pos++];
+      value += (byte & 0x7f) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+  while (pos < profile.length) {
+    const tag = varint();
+    if ((tag & 7) === 0) {
+      const value = varint();
+      if (tag >>> 3 === 10)
+        duration = value;
+    } else {
+      assert.strictEqual(tag & 7, 2);
+      const length = varint();
+      if (tag >>> 3 === 6)
+        strings.push(profile.toString('utf8', pos, pos + length));
+      pos += length;
+    }
+  }
+  assert.strictEqual(pos, profile.length);
+  return { strings, duration };
+}
+
+function signalSelfAndExit(signal) {
+  // The profile is written by the listener that the --*-sampler-signal
+  // option added before this one.
+  process.on(signal, () => process.exit());
+  process.kill(process.pid, signal);
+  setInterval(() => {}, 1000);
+}
+
+function spawnAndReadProfile(args, prefix) {
+  const child = cp.spawnSync(process.execPath, args, { cwd: tmpdir.path });
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  const files = fs.readdirSync(tmpdir.path)
+    .filter((name) => name.startsWith(prefix) && name.endsWith('.folded'));
+  assert.strictEqual(files.length, 1);
+  return fs.readFileSync(path.join(tmpdir.path, files[0]), 'utf8');
+}
+
+module.exports = {
+  parsePprof,
+  signalSelfAndExit,
+  spawnAndReadProfile
+};
@@ -252,3 +252,40 @@ assert.deepStrictEqual(test_object.TestGetProperty(), {
   keyIsNull: 'pass',
   resultIsNull: 'pass'
 });
+
+{
+  // Verify that property keys can be created and used.
+  const key = test_object.CreatePropertyKey('foo');
+  assert.strictEqual(key, 'foo');
+  const object = {};
+  test_object.Set(object, key, 1);
+  assert.deepStrictEqual(object, { foo: 1 });
+}
+
+{
+  // Verify that objects can be created from templates.
+  const sym = Symbol('sym');
+  const keys = ['a', 'b', sym];
+  const object = test_object.FromTemplate(keys, [1, 'two', null]);
+  assert.deepStrictEqual(object, { a: 1, b: 'two', [sym]: null });
+  assert.deepStrictEqual(Reflect.ownKeys(object), keys);
+  assert.strictEqual(Object.getPrototypeOf(object), Object.prototype);
+
+  // The properties are left undefined without values.
+  assert.deepStrictEqual(test_object.FromTemplate(['a', 'b']),
+                         { a: undefined, b: undefined });
+  assert.deepStrictEqual(test_object.FromTemplate([]), {});
+
+  // Instances are ordinary, writable objects.
+  object.a = 2;
+  object.c = 3;
+  delete object.b;
+  assert.deepStrictEqual(object, { a: 2, c: 3, [sym]: null });
+
+  assert.throws(() => test_object.FromTemplate([1]), {
+    message: 'A string or symbol was expected'
+  });
+  assert.throws(() => test_object.FromTemplate(['a', 'a']), {
+    message: 'Invalid argument'
+  });
+}
@@ -1,3 +1,4 @@
+#define NAPI_EXPERIMENTAL
 #include <js_native_api.h>
 #include "../common.h"
 #include <string.h>
@@ -524,6 +525,63 @@ static napi_value TestGetProperty(napi_env env,
   return object;
 }
 
+static napi_value CreatePropertyKey(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  char buffer[128];
+  size_t copied;
+  NAPI_CALL(env,
+      napi_get_value_string_utf8(env, args[0], buffer, sizeof(buffer), &copied));
+
+  napi_value key;
+  NAPI_CALL(env, napi_create_property_key_utf8(env, buffer, copied, &key));
+
+  return key;
+}
+
+#define MAX_TEMPLATE_KEYS 8
+
+// Creates a template with the keys in the first argument, and instantiates it
+// with the values in the second argument, if any.
+static napi_value FromTemplate(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  napi_value keys[MAX_TEMPLATE_KEYS];
+  napi_value values[MAX_TEMPLATE_KEYS];
+  uint32_t key_count, i;
+  NAPI_CALL(env, napi_get_array_length(env, args[0], &key_count));
+  NAPI_ASSERT(env, key_count <= MAX_TEMPLATE_KEYS, "Too many keys");
+  for (i = 0; i < key_count; i++) {
+    NAPI_CALL(env, napi_get_element(env, args[0], i, &keys[i]));
+  }
+
+  bool has_values = argc > 1;
+  if (has_values) {
+    for (i = 0; i < key_count; i++) {
+      NAPI_CALL(env, napi_get_element(env, args[1], i, &values[i]));
+    }
+  }
+
+  napi_object_template object_template;
+  NAPI_CALL(env, napi_create_object_template(
+      env, key_count, keys, &object_template));
+
+  napi_value result;
+  napi_status status = napi_create_object_from_template(
+      env, object_template, has_values ? values : NULL, &result);
+  // Keep the template on failure, so that the error is not cleared.
+  if (status == napi_ok) {
+    NAPI_CALL(env, napi_delete_object_template(env, object_template));
+  }
+  NAPI_CALL(env, status);
+
+  return result;
+}
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor descriptors[] = {
@@ -543,6 +601,8 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("TestSetProperty", TestSetProperty),
     DECLARE_NAPI_PROPERTY("TestHasProperty", TestHasProperty),
     DECLARE_NAPI_PROPERTY("TestGetProperty", TestGetProperty),
+    DECLARE_NAPI_PROPERTY("CreatePropertyKey", CreatePropertyKey),
+    DECLARE_NAPI_PROPERTY("FromTemplate", FromTemplate),
   };
 
   NAPI_CALL(env, napi_define_properties(
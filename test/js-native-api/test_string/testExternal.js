@@ -0,0 +1,46 @@
+'use strict';
+// Flags: --expose-gc
+
+const common = require('../../common');
+const assert = require('assert');
+
+// Testing api calls for external strings and string views
+const test_string = require(`./build/${common.buildType}/test_string`);
+
+const latin1 = 'hello wörld';
+const utf16 = 'hello \u{1F310}';
+
+const externalLatin1 = test_string.TestExternalLatin1(latin1);
+assert.strictEqual(externalLatin1, latin1);
+assert.strictEqual(test_string.TestLatin1View(externalLatin1), latin1);
+assert.strictEqual(test_string.TestUtf16View(externalLatin1), null);
+
+const externalUtf16 = test_string.TestExternalUtf16(utf16);
+assert.strictEqual(externalUtf16, utf16);
+assert.strictEqual(test_string.TestUtf16View(externalUtf16), utf16);
+assert.strictEqual(test_string.TestLatin1View(externalUtf16), null);
+
+// Strings on the JavaScript heap have no view.
+assert.strictEqual(test_string.TestLatin1View(latin1), null);
+assert.strictEqual(test_string.TestUtf16View(utf16), null);
+
+// Large strings that are decoded from a Buffer are external.
+const large = Buffer.alloc(1024 * 1024, 'a').toString('latin1');
+assert.strictEqual(test_string.TestLatin1View(large), large);
+
+assert.throws(() => test_string.TestLatin1View({}), {
+  message: 'A string was expected'
+});
+
+// Empty strings do not keep the memory alive.
+const count = test_string.ExternalFinalizeCount();
+assert.strictEqual(test_string.TestExternalLatin1(''), '');
+assert.strictEqual(test_string.ExternalFinalizeCount(), count + 1);
+
+// The memory is released once the strings are collected.
+(function() {
+  for (let i = 0; i < 100; i++)
+    test_string.TestExternalLatin1(`${latin1} ${i}`);
+})();
+global.gc();
+assert(test_string.ExternalFinalizeCount() > count + 1);
@@ -1,4 +1,7 @@
 #include <limits.h>  // INT_MAX
+#include <stdlib.h>
+#include <string.h>
+#define NAPI_EXPERIMENTAL
 #include <js_native_api.h>
 #include "../common.h"
 
@@ -244,6 +247,101 @@ static napi_value TestLargeUtf16(napi_env env, napi_callback_info info) {
   return output;
 }
 
+static int finalize_count = 0;
+
+static void FreeExternalString(napi_env env, void* data, void* hint) {
+  free(data);
+  finalize_count++;
+}
+
+static napi_value TestExternalLatin1(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  size_t length;
+  NAPI_CALL(env, napi_get_value_string_latin1(env, args[0], NULL, 0, &length));
+
+  char* buffer = malloc(length + 1);
+  NAPI_ASSERT(env, buffer != NULL, "Failed to allocate the buffer");
+  NAPI_CALL(env, napi_get_value_string_latin1(
+      env, args[0], buffer, length + 1, NULL));
+
+  napi_value output;
+  NAPI_CALL(env, napi_create_external_string_latin1(
+      env, buffer, length, FreeExternalString, NULL, &output));
+
+  return output;
+}
+
+static napi_value TestExternalUtf16(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  size_t length;
+  NAPI_CALL(env, napi_get_value_string_utf16(env, args[0], NULL, 0, &length));
+
+  char16_t* buffer = malloc((length + 1) * sizeof(*buffer));
+  NAPI_ASSERT(env, buffer != NULL, "Failed to allocate the buffer");
+  NAPI_CALL(env, napi_get_value_string_utf16(
+      env, args[0], buffer, length + 1, NULL));
+
+  napi_value output;
+  NAPI_CALL(env, napi_create_external_string_utf16(
+      env, buffer, length, FreeExternalString, NULL, &output));
+
+  return output;
+}
+
+// Returns a copy of the string made from its view, or null if there is none.
+static napi_value TestLatin1View(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  const char* view;
+  size_t length;
+  NAPI_CALL(env,
+      napi_get_value_string_latin1_view(env, args[0], &view, &length));
+
+  napi_value output;
+  if (view == NULL) {
+    NAPI_CALL(env, napi_get_null(env, &output));
+  } else {
+    NAPI_CALL(env, napi_create_string_latin1(env, view, length, &output));
+  }
+
+  return output;
+}
+
+static napi_value TestUtf16View(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  const char16_t* view;
+  size_t length;
+  NAPI_CALL(env,
+      napi_get_value_string_utf16_view(env, args[0], &view, &length));
+
+  napi_value output;
+  if (view == NULL) {
+    NAPI_CALL(env, napi_get_null(env, &output));
+  } else {
+    NAPI_CALL(env, napi_create_string_utf16(env, view, length, &output));
+  }
+
+  return output;
+}
+
+static napi_value ExternalFinalizeCount(napi_env env,
+                                        napi_callback_info info) {
+  napi_value output;
+  NAPI_CALL(env, napi_create_int32(env, finalize_count, &output));
+  return output;
+}
+
 EXTERN_C_START
 napi_value Init(napi_env env, napi_value exports) {
   napi_property_descriptor properties[] = {
@@ -258,6 +356,11 @@ napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("TestLargeUtf8", TestLargeUtf8),
     DECLARE_NAPI_PROPERTY("TestLargeLatin1", TestLargeLatin1),
     DECLARE_NAPI_PROPERTY("TestLargeUtf16", TestLargeUtf16),
+    DECLARE_NAPI_PROPERTY("TestExternalLatin1", TestExternalLatin1),
+    DECLARE_NAPI_PROPERTY("TestExternalUtf16", TestExternalUtf16),
+    DECLARE_NAPI_PROPERTY("TestLatin1View", TestLatin1View),
+    DECLARE_NAPI_PROPERTY("TestUtf16View", TestUtf16View),
+    DECLARE_NAPI_PROPERTY("ExternalFinalizeCount", ExternalFinalizeCount),
   };
 
   NAPI_CALL(env, napi_define_properties(
@@ -4,11 +4,13 @@
 // which, in turn, may affect the ABI stability of the project despite its use
 // of N-API.
 #include <uv.h>
+#define NAPI_EXPERIMENTAL
 #include <node_api.h>
 #include "../../js-native-api/common.h"
 
 #define ARRAY_LENGTH 10
 #define MAX_QUEUE_SIZE 2
+#define MAX_BATCH_SIZE 3
 
 static uv_thread_t uv_threads[2];
 static napi_threadsafe_function ts_fn;
@@ -129,6 +131,19 @@ static void call_js(napi_env env, napi_value cb, void* hint, void* data) {
   }
 }
 
+// Getting the data into JS several values at a time
+static void call_js_batch(napi_env env, napi_value cb, void* hint,
+                          void** data, size_t count) {
+  if (!(env == NULL || cb == NULL)) {
+    size_t index;
+    NAPI_ASSERT_RETURN_VOID(env, count > 0 && count <= MAX_BATCH_SIZE,
+        "Batch size is within bounds");
+    for (index = 0; index < count; index++) {
+      call_js(env, cb, hint, data[index]);
+    }
+  }
+}
+
 // Cleanup
 static napi_value StopThread(napi_env env, napi_callback_info info) {
   size_t argc = 2;
@@ -173,6 +188,8 @@ static void join_the_threads(napi_env env, void *data, void *hint) {
 static napi_value StartThreadInternal(napi_env env,
                                       napi_callback_info info,
                                       napi_threadsafe_function_call_js cb,
+                                      napi_threadsafe_function_call_js_batch
+                                          batch_cb,
                                       bool block_on_full) {
   size_t argc = 4;
   napi_value argv[4];
@@ -197,6 +214,12 @@ static napi_value StartThreadInternal(napi_env env,
                                                  &ts_info,
                                                  cb,
                                                  &ts_fn));
+  if (batch_cb != NULL) {
+    NAPI_CALL(env, napi_set_threadsafe_function_batching(env,
+                                                         ts_fn,
+                                                         MAX_BATCH_SIZE,
+                                                         batch_cb));
+  }
   bool abort;
   NAPI_CALL(env, napi_get_value_bool(env, argv[1], &abort));
   ts_info.abort = abort ? napi_tsfn_abort : napi_tsfn_release;
@@ -223,16 +246,20 @@ static napi_value Release(napi_env env, napi_callback_info info) {
 
 // Startup
 static napi_value StartThread(napi_env env, napi_callback_info info) {
-  return StartThreadInternal(env, info, call_js, true);
+  return StartThreadInternal(env, info, call_js, NULL, true);
 }
 
 static napi_value StartThreadNonblocking(napi_env env,
                                          napi_callback_info info) {
-  return StartThreadInternal(env, info, call_js, false);
+  return StartThreadInternal(env, info, call_js, NULL, false);
 }
 
 static napi_value StartThreadNoNative(napi_env env, napi_callback_info info) {
-  return StartThreadInternal(env, info, NULL, true);
+  return StartThreadInternal(env, info, NULL, NULL, true);
+}
+
+static napi_value StartThreadBatch(napi_env env, napi_callback_info info) {
+  return StartThreadInternal(env, info, call_js, call_js_batch, true);
 }
 
 // Module init
@@ -269,6 +296,7 @@ static napi_value Init(napi_env env, napi_value exports) {
     DECLARE_NAPI_PROPERTY("StartThread", StartThread),
     DECLARE_NAPI_PROPERTY("StartThreadNoNative", StartThreadNoNative),
     DECLARE_NAPI_PROPERTY("StartThreadNonblocking", StartThreadNonblocking),
+    DECLARE_NAPI_PROPERTY("StartThreadBatch", StartThreadBatch),
     DECLARE_NAPI_PROPERTY("StopThread", StopThread),
     DECLARE_NAPI_PROPERTY("Unref", Unref),
     DECLARE_NAPI_PROPERTY("Release", Release),
@@ -120,6 +120,34 @@ new Promise(function testWithoutJSMarshaller(resolve) {
 }))
 .then((result) => assert.deepStrictEqual(result, expectedArray))
 
+// Start the thread in blocking mode with batched dispatch, and assert that all
+// values are passed in order. Quit after it's done.
+.then(() => testWithJSMarshaller({
+  threadStarter: 'StartThreadBatch',
+  maxQueueSize: 0,
+  quitAfter: binding.ARRAY_LENGTH
+}))
+.then((result) => assert.deepStrictEqual(result, expectedArray))
+
+// Start the thread in blocking mode with batched dispatch and a bounded queue,
+// and assert that all values are passed. Quit early, but let the thread finish.
+.then(() => testWithJSMarshaller({
+  threadStarter: 'StartThreadBatch',
+  maxQueueSize: binding.MAX_QUEUE_SIZE,
+  quitAfter: 1
+}))
+.then((result) => assert.deepStrictEqual(result, expectedArray))
+
+// Start the thread in blocking mode with batched dispatch, and assert that it
+// could not finish. Quit early by aborting.
+.then(() => testWithJSMarshaller({
+  threadStarter: 'StartThreadBatch',
+  quitAfter: 1,
+  maxQueueSize: binding.MAX_QUEUE_SIZE,
+  abort: true
+}))
+.then((result) => assert.strictEqual(result.indexOf(0), -1))
+
 // Start the thread in blocking mode, and assert that all values are passed.
 // Quit early, but let the thread finish.
 .then(() => testWithJSMarshaller({
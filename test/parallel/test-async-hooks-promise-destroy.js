@@ -0,0 +1,42 @@
+// Flags: --expose-gc
+'use strict';
+
+// Promises are tracked without PromiseWrap objects. Check that destroy()
+// is still emitted for them once they are collected, and that before() and
+// after() get the ids that were assigned in init().
+
+const common = require('../common');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+
+const initIds = new Set();
+const destroyedIds = new Set();
+const beforeIds = [];
+
+async_hooks.createHook({
+  init(id, type) {
+    if (type === 'PROMISE')
+      initIds.add(id);
+  },
+  before(id) {
+    if (initIds.has(id))
+      beforeIds.push(id);
+  },
+  destroy(id) {
+    if (initIds.has(id))
+      destroyedIds.add(id);
+  }
+}).enable();
+
+Promise.resolve().then(common.mustCall(() => {
+  assert(initIds.has(async_hooks.executionAsyncId()));
+}));
+
+setImmediate(common.mustCall(() => {
+  global.gc();
+  setImmediate(common.mustCall(() => {
+    assert.strictEqual(beforeIds.length, 1);
+    assert.strictEqual(initIds.size, 2);
+    assert.deepStrictEqual([...destroyedIds].sort(), [...initIds].sort());
+  }));
+}));
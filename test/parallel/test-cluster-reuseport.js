@@ -0,0 +1,65 @@
+'use strict';
+
+// Tests that with cluster.SCHED_REUSEPORT every worker listens on a socket
+// of its own that shares the port with the sockets of the other workers.
+
+const common = require('../common');
+if (!common.isLinux)
+  common.skip('SO_REUSEPORT load balancing is tested on Linux only');
+
+const assert = require('assert');
+const cluster = require('cluster');
+const net = require('net');
+
+const WORKERS = 2;
+const CONNECTIONS = 20;
+
+if (cluster.isWorker) {
+  const server = net.createServer((socket) => {
+    socket.end(`${cluster.worker.id}`);
+  });
+  server.listen(0, common.mustCall(() => {
+    process.send({ port: server.address().port });
+  }));
+  return;
+}
+
+cluster.schedulingPolicy = cluster.SCHED_REUSEPORT;
+
+const ports = [];
+for (let i = 0; i < WORKERS; i++) {
+  cluster.fork().on('message', common.mustCall(({ port }) => {
+    ports.push(port);
+    if (ports.length === WORKERS)
+      onListening(port);
+  }));
+}
+
+function onListening(port) {
+  // Asking for port 0 gives all workers the same port.
+  assert.deepStrictEqual(ports, new Array(WORKERS).fill(port));
+
+  // Sockets without SO_REUSEPORT can't take the port away from the cluster.
+  const server = net.createServer();
+  server.listen(port, common.mustNotCall());
+  server.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EADDRINUSE');
+    connect(port, CONNECTIONS);
+  }));
+}
+
+function connect(port, left) {
+  if (left === 0) {
+    cluster.disconnect();
+    return;
+  }
+  const socket = net.connect(port, common.mustCall(() => {
+    let data = '';
+    socket.setEncoding('utf8');
+    socket.on('data', (chunk) => data += chunk);
+    socket.on('end', common.mustCall(() => {
+      assert(cluster.workers[data], `unexpected worker id ${data}`);
+      connect(port, left - 1);
+    }));
+  }));
+}
@@ -0,0 +1,129 @@
+'use strict';
+
+// Tests the DNS cache that is enabled with --dns-cache-size.
+
+const common = require('../common');
+const dnstools = require('../common/dns');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const dgram = require('dgram');
+const dns = require('dns');
+const util = require('util');
+
+if (process.argv[2] !== 'child') {
+  // The cache is disabled by default.
+  assert.deepStrictEqual(dns.getCacheStatistics(), {
+    hits: 0,
+    misses: 0,
+    coalesced: 0,
+    evictions: 0,
+    entries: 0
+  });
+
+  const child = spawnSync(process.execPath,
+                          ['--dns-cache-size=2', __filename, 'child'],
+                          { encoding: 'utf8' });
+  assert.strictEqual(child.status, 0, child.stderr);
+  return;
+}
+
+// Answers queries for 'example.org' with an A record, and all others with
+// NXDOMAIN.
+function createServer(address) {
+  const server = dgram.createSocket('udp4');
+  server.queries = 0;
+  server.on('message', (msg, { address: host, port }) => {
+    server.queries++;
+    const parsed = dnstools.parseDNSPacket(msg);
+    const domain = parsed.questions[0].domain;
+    const found = domain === 'example.org';
+    server.send(dnstools.writeDNSPacket({
+      id: parsed.id,
+      flags: found ? undefined : 0x8183,
+      questions: parsed.questions,
+      answers: found ? [{ type: 'A', domain, address, ttl: 300 }] : []
+    }), port, host);
+  });
+  return server;
+}
+
+function resolve4(resolver, name) {
+  return new Promise((resolve, reject) => {
+    resolver.resolve4(name, { ttl: true }, (err, result) => {
+      if (err) reject(err);
+      else resolve(result);
+    });
+  });
+}
+
+const server = createServer('1.2.3.4');
+const otherServer = createServer('5.6.7.8');
+
+server.bind(0, common.mustCall(() => {
+  otherServer.bind(0, common.mustCall(() => {
+    run().then(common.mustCall());
+  }));
+}));
+
+async function run() {
+  const resolver = new dns.Resolver();
+  resolver.setServers([`127.0.0.1:${server.address().port}`]);
+  const otherResolver = new dns.Resolver();
+  otherResolver.setServers([`127.0.0.1:${otherServer.address().port}`]);
+
+  // Identical queries that are in flight at the same time share one
+  // query to the server.
+  const results = await Promise.all([
+    resolve4(resolver, 'example.org'),
+    resolve4(resolver, 'example.org'),
+    resolve4(resolver, 'example.org')
+  ]);
+  for (const result of results)
+    assert.deepStrictEqual(result, [{ address: '1.2.3.4', ttl: 300 }]);
+  assert.strictEqual(server.queries, 1);
+  let stats = dns.getCacheStatistics();
+  assert.strictEqual(stats.hits, 0);
+  assert.strictEqual(stats.misses, 3);
+  assert.strictEqual(stats.coalesced, 2);
+  assert.strictEqual(stats.entries, 1);
+
+  // Later queries are answered from the cache.
+  const [cached] = await resolve4(resolver, 'example.org');
+  assert.strictEqual(cached.address, '1.2.3.4');
+  assert(cached.ttl <= 300);
+  assert.strictEqual(server.queries, 1);
+  assert.strictEqual(dns.getCacheStatistics().hits, 1);
+
+  // Resolvers that use other servers do not share the entries.
+  const [other] = await resolve4(otherResolver, 'example.org');
+  assert.strictEqual(other.address, '5.6.7.8');
+  assert.strictEqual(otherServer.queries, 1);
+
+  // Negative results are cached, too.
+  for (let i = 0; i < 2; i++) {
+    await assert.rejects(resolve4(resolver, 'example.com'),
+                         { code: 'ENOTFOUND' });
+  }
+  assert.strictEqual(server.queries, 2);
+
+  // The least recently used entry was evicted.
+  stats = dns.getCacheStatistics();
+  assert.strictEqual(stats.entries, 2);
+  assert.strictEqual(stats.evictions, 1);
+
+  dns.clearCache();
+  assert.strictEqual(dns.getCacheStatistics().entries, 0);
+  await resolve4(resolver, 'example.org');
+  assert.strictEqual(server.queries, 3);
+
+  server.close();
+  otherServer.close();
+
+  // dns.lookup() results are cached, too.
+  const { hits } = dns.getCacheStatistics();
+  const lookup = util.promisify(dns.lookup);
+  const { address } = await lookup('localhost');
+  const { address: cachedAddress } = await lookup('localhost');
+  assert.strictEqual(cachedAddress, address);
+  assert.strictEqual(dns.getCacheStatistics().hits, hits + 1);
+}
@@ -0,0 +1,91 @@
+'use strict';
+
+// Tests --experimental-code-cache: code cache for user modules is written to
+// the cache directory, reused by later runs, and replaced when it is stale or
+// rejected by V8.
+
+require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const cacheDir = path.join(tmpdir.path, 'code-cache');
+const dep = path.join(tmpdir.path, 'dep.js');
+const entry = path.join(tmpdir.path, 'entry.js');
+fs.writeFileSync(dep, 'module.exports = () => "dep";');
+fs.writeFileSync(entry, 'console.log(require("./dep.js")());');
+
+function run(...args) {
+  const child = spawnSync(process.execPath, [
+    `--experimental-code-cache=${cacheDir}`,
+    ...args
+  ]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  assert(/The code cache is experimental/.test(child.stderr));
+  return child.stdout.toString().trim();
+}
+
+function cacheFiles() {
+  return fs.readdirSync(cacheDir).sort().map((name) => {
+    const file = path.join(cacheDir, name);
+    return { file, mtimeMs: fs.statSync(file).mtimeMs };
+  });
+}
+
+assert.strictEqual(run(entry), 'dep');
+const files = cacheFiles();
+assert.strictEqual(files.length, 2);
+for (const { file } of files) {
+  assert(file.endsWith('.cache'));
+  const contents = fs.readFileSync(file);
+  const key = contents.toString('utf8', 4, 4 + contents.readUInt32LE(0));
+  assert(key.endsWith(`\0${dep}`) || key.endsWith(`\0${entry}`), key);
+}
+
+// A second run uses the cache and does not need to rewrite it.
+assert.strictEqual(run(entry), 'dep');
+assert.deepStrictEqual(cacheFiles(), files);
+
+// Changing a module invalidates its entry, and only its entry.
+fs.writeFileSync(dep, 'module.exports = () => "changed";');
+assert.strictEqual(run(entry), 'changed');
+{
+  const updated = cacheFiles();
+  assert.strictEqual(updated.length, 2);
+  const changed = updated.filter((f, i) => f.mtimeMs !== files[i].mtimeMs);
+  assert.strictEqual(changed.length, 1);
+}
+
+// The entry is keyed by the contents, not the mtime and size of the file, so a
+// change that keeps both is picked up too.
+{
+  const { mtime, size } = fs.statSync(dep);
+  fs.writeFileSync(dep, 'module.exports = () => "CHANGED";');
+  fs.utimesSync(dep, mtime, mtime);
+  assert.strictEqual(fs.statSync(dep).size, size);
+  assert.strictEqual(run(entry), 'CHANGED');
+}
+
+// Cache data that V8 rejects is ignored and replaced.
+{
+  const [{ file }] = cacheFiles();
+  const contents = fs.readFileSync(file);
+  const headerLength = 4 + contents.readUInt32LE(0);
+  contents.fill(0xff, headerLength);
+  fs.writeFileSync(file, contents);
+  assert.strictEqual(run(entry), 'CHANGED');
+  assert.notDeepStrictEqual(fs.readFileSync(file), contents);
+}
+
+// ES modules are cached too.
+{
+  const esm = path.join(tmpdir.path, 'entry.mjs');
+  fs.writeFileSync(esm, 'console.log("esm");');
+  assert.strictEqual(run('--experimental-modules', esm), 'esm');
+  assert.strictEqual(cacheFiles().length, 3);
+  assert.strictEqual(run('--experimental-modules', esm), 'esm');
+}
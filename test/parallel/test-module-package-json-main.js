@@ -0,0 +1,72 @@
+'use strict';
+
+// Checks that the "main" field that the CommonJS loader reads out of
+// package.json matches what JSON.parse() would see.
+
+require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+let counter = 0;
+function createPackage(json, files = { 'index.js': 'index' }) {
+  const dir = path.join(tmpdir.path, `pkg-${counter++}`);
+  fs.mkdirSync(dir);
+  fs.writeFileSync(path.join(dir, 'package.json'), json);
+  for (const [name, id] of Object.entries(files)) {
+    fs.mkdirSync(path.dirname(path.join(dir, name)), { recursive: true });
+    fs.writeFileSync(path.join(dir, name), `module.exports = '${id}';`);
+  }
+  return dir;
+}
+
+// Plain "main", surrounded by fields the loader does not care about.
+assert.strictEqual(require(createPackage(JSON.stringify({
+  name: 'pkg',
+  dependencies: { main: 'nope.js' },
+  files: ['main'],
+  main: 'lib/main.js',
+  exports: { '.': './lib/main.js' }
+}), { 'lib/main.js': 'main' })), 'main');
+
+// Escape sequences in keys and values.
+assert.strictEqual(
+  require(createPackage('{"m\\u0061in": "lib\\/\\u00e9.js"}',
+                        { 'lib/é.js': 'escaped' })),
+  'escaped');
+
+// The last duplicate key wins.
+assert.strictEqual(
+  require(createPackage('{"main": "a.js", "main": "b.js"}',
+                        { 'a.js': 'a', 'b.js': 'b' })),
+  'b');
+
+// A leading byte order mark is skipped.
+assert.strictEqual(
+  require(createPackage('\ufeff{"main": "bom.js"}', { 'bom.js': 'bom' })),
+  'bom');
+
+// Only the top-level "main" counts.
+assert.strictEqual(
+  require(createPackage('{"config": {"main": "nope.js"}}')), 'index');
+
+// Invalid JSON keeps producing the JSON.parse() error.
+{
+  const dir = createPackage('{"main": "index.js",}');
+  assert.throws(() => require(dir), (err) => {
+    assert(err instanceof SyntaxError);
+    assert.strictEqual(err.path, path.join(dir, 'package.json'));
+    assert(err.message.startsWith(`Error parsing ${err.path}: `));
+    return true;
+  });
+}
+
+// Invalid JSON without a "main" key has always been ignored.
+assert.strictEqual(require(createPackage('{"name": ')), 'index');
+
+// A "main" that is not a string is still rejected the same way.
+assert.throws(() => require(createPackage('{"main": 1}')),
+              { code: 'ERR_INVALID_ARG_TYPE' });
@@ -0,0 +1,126 @@
+'use strict';
+
+// Tests --experimental-resolution-cache: resolutions are written to the cache
+// file on exit, reused by later runs, and stale entries are ignored.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const cacheFile = path.join(tmpdir.path, 'resolution-cache.json');
+const appDir = path.join(tmpdir.path, 'app');
+const modulesDir = path.join(tmpdir.path, 'node_modules');
+const pkgDir = path.join(modulesDir, 'pkg');
+fs.mkdirSync(appDir);
+fs.mkdirSync(path.join(pkgDir, 'lib'), { recursive: true });
+fs.writeFileSync(path.join(pkgDir, 'package.json'), '{"main": "lib/a"}');
+fs.writeFileSync(path.join(pkgDir, 'lib', 'a.js'), 'module.exports = "a";');
+const entry = path.join(appDir, 'entry.js');
+fs.writeFileSync(entry, 'console.log(require("pkg"));');
+
+function run(file = entry) {
+  const child = spawnSync(process.execPath, [
+    `--experimental-resolution-cache=${cacheFile}`,
+    file
+  ]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  assert(/The resolution cache is experimental/.test(child.stderr));
+  return child.stdout.toString().trim();
+}
+
+assert.strictEqual(run(), 'a');
+const cache = JSON.parse(fs.readFileSync(cacheFile, 'utf8'));
+assert.strictEqual(cache.version, 3);
+const filenames = Object.values(cache.paths).map((entry) => entry.filename);
+assert(filenames.includes(path.join(pkgDir, 'lib', 'a.js')));
+
+// A second run uses the cache and does not need to rewrite it.
+const { mtimeMs } = fs.statSync(cacheFile);
+assert.strictEqual(run(), 'a');
+assert.strictEqual(fs.statSync(cacheFile).mtimeMs, mtimeMs);
+
+// A changed "main" field is picked up even though the previously resolved
+// file still exists.
+fs.writeFileSync(path.join(pkgDir, 'package.json'), '{"main": "lib/b"}');
+fs.writeFileSync(path.join(pkgDir, 'lib', 'b.js'), 'module.exports = "b";');
+assert.strictEqual(run(), 'b');
+assert.strictEqual(run(), 'b');
+
+// A new file that takes precedence over the package directory is found.
+fs.writeFileSync(path.join(modulesDir, 'pkg.js'), 'module.exports = "file";');
+assert.strictEqual(run(), 'file');
+
+// So is a new node_modules directory closer to the requiring module.
+fs.mkdirSync(path.join(appDir, 'node_modules'));
+fs.writeFileSync(path.join(appDir, 'node_modules', 'pkg.js'),
+                 'module.exports = "nearest";');
+assert.strictEqual(run(), 'nearest');
+
+// Cached resolutions that point to files that no longer exist are resolved
+// again.
+fs.unlinkSync(path.join(appDir, 'node_modules', 'pkg.js'));
+assert.strictEqual(run(), 'file');
+
+// A corrupt cache file is ignored.
+fs.writeFileSync(cacheFile, '{');
+assert.strictEqual(run(), 'file');
+
+// A retargeted symlink is followed to its new target.
+if (common.canCreateSymLink()) {
+  const linkEntry = path.join(appDir, 'link-entry.js');
+  fs.writeFileSync(linkEntry, 'console.log(require("linked"));');
+  for (const name of ['A', 'B']) {
+    fs.mkdirSync(path.join(tmpdir.path, `target${name}`));
+    fs.writeFileSync(path.join(tmpdir.path, `target${name}`, 'index.js'),
+                     `module.exports = "${name}";`);
+  }
+  const link = path.join(modulesDir, 'linked');
+  fs.symlinkSync(path.join(tmpdir.path, 'targetA'), link, 'dir');
+  assert.strictEqual(run(linkEntry), 'A');
+  assert.strictEqual(run(linkEntry), 'A');
+  fs.unlinkSync(link);
+  fs.symlinkSync(path.join(tmpdir.path, 'targetB'), link, 'dir');
+  assert.strictEqual(run(linkEntry), 'B');
+}
+
+// With the cache enabled, failed lookups are not cached, so files created
+// later on are found. Successful lookups are only kept while the main module
+// is being loaded, and Module.clearResolutionCache() discards them.
+{
+  const file = path.join(tmpdir.path, 'late');
+  const script = `
+    const assert = require('assert');
+    const fs = require('fs');
+    const path = require('path');
+    const { clearResolutionCache } = require('module');
+    const file = ${JSON.stringify(file)};
+    assert.throws(() => require.resolve(file), { code: 'MODULE_NOT_FOUND' });
+    fs.writeFileSync(file + '.js', '');
+    assert.strictEqual(require.resolve(file), file + '.js');
+    fs.unlinkSync(file + '.js');
+    fs.mkdirSync(file);
+    fs.writeFileSync(path.join(file, 'index.js'), '');
+    assert.strictEqual(require.resolve(file), file + '.js');
+    clearResolutionCache();
+    assert.strictEqual(require.resolve(file), path.join(file, 'index.js'));
+
+    const gone = path.join(file, 'gone.js');
+    fs.writeFileSync(gone, '');
+    assert.strictEqual(require.resolve(gone), gone);
+    setImmediate(() => {
+      fs.unlinkSync(gone);
+      assert.throws(() => require.resolve(path.join(file, '.', 'gone')),
+                    { code: 'MODULE_NOT_FOUND' });
+    });
+  `;
+  const child = spawnSync(process.execPath, [
+    `--experimental-resolution-cache=${cacheFile}`,
+    '-e', script
+  ]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+}
@@ -0,0 +1,44 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { MessageChannel } = require('worker_threads');
+
+// Socket reads are slices of a shared slab. Transferring the slab with
+// postMessage() must not hand its memory over to the receiving side, because
+// later reads still go into it.
+
+const kChunks = 16;
+const received = [];
+const { port1, port2 } = new MessageChannel();
+
+port2.on('message', common.mustCallAtLeast((copy) => {
+  if (copy === 'done')
+    return port2.close();
+  assert(copy.byteLength > 0);
+}, 2));
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.on('data', (data) => {
+    port1.postMessage(data.buffer, [data.buffer]);
+    // The slab was copied, not detached.
+    assert.notStrictEqual(data.buffer.byteLength, 0);
+    received.push(Buffer.from(data));
+  });
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(received),
+                           Buffer.alloc(kChunks * 100, 'x'));
+    port1.postMessage('done');
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port);
+  let n = 0;
+  (function write() {
+    if (n++ === kChunks)
+      return socket.end();
+    socket.write(Buffer.alloc(100, 'x'), write);
+  })();
+}));
@@ -0,0 +1,60 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const { getReadBufferPoolStats } = internalBinding('stream_wrap');
+
+// Reads from sockets are served from a shared pool. Check that data arriving
+// on several connections is delivered intact and that the pool is used.
+
+function getStats() {
+  const fields = new Float64Array(3);
+  getReadBufferPoolStats(fields);
+  return { hits: fields[0], misses: fields[1], slabs: fields[2] };
+}
+
+const kConnections = 8;
+const kChunks = 64;
+const before = getStats();
+const received = [];
+
+const server = net.createServer(common.mustCall((socket) => {
+  const chunks = [];
+  socket.on('data', (data) => {
+    chunks.push(data);
+  });
+  socket.on('end', common.mustCall(() => {
+    received.push(Buffer.concat(chunks));
+    if (received.length === kConnections)
+      server.close();
+  }));
+}, kConnections));
+
+server.on('close', common.mustCall(() => {
+  for (const data of received) {
+    const id = data[0];
+    const expected = Buffer.alloc(kChunks * 1000, id);
+    assert.deepStrictEqual(data, expected);
+  }
+
+  const after = getStats();
+  assert(after.hits > before.hits);
+  assert(after.slabs >= before.slabs);
+  assert(after.hits + after.misses >= received.length);
+}));
+
+server.listen(0, common.mustCall(() => {
+  for (let i = 0; i < kConnections; i++) {
+    const socket = net.connect(server.address().port);
+    socket.on('connect', common.mustCall(() => {
+      let n = 0;
+      (function write() {
+        if (n++ === kChunks)
+          return socket.end();
+        socket.write(Buffer.alloc(1000, i + 1), write);
+      })();
+    }));
+  }
+}));
@@ -0,0 +1,53 @@
+'use strict';
+
+// Tests the acceptBatchSize, deferAccept and fastOpen options of
+// server.listen().
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const CONNECTIONS = 10;
+
+{
+  // Connections accepted in batches are all emitted.
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.end();
+  }, CONNECTIONS));
+  server.listen({ port: 0, acceptBatchSize: 4 }, common.mustCall(() => {
+    let closed = 0;
+    for (let i = 0; i < CONNECTIONS; i++) {
+      net.connect(server.address().port).on('close', common.mustCall(() => {
+        if (++closed === CONNECTIONS)
+          server.close();
+      })).resume();
+    }
+  }));
+}
+
+if (common.isLinux) {
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.on('data', common.mustCall((data) => {
+      assert.strictEqual(data.toString(), 'hello');
+      socket.end();
+      server.close();
+    }));
+  }));
+  const options = { port: 0, deferAccept: 1, fastOpen: 16 };
+  server.listen(options, common.mustCall(() => {
+    net.connect(server.address().port).end('hello').resume();
+  }));
+}
+
+for (const name of ['acceptBatchSize', 'deferAccept', 'fastOpen']) {
+  assert.throws(() => {
+    net.createServer().listen({ port: 0, [name]: 'foo' });
+  }, { code: 'ERR_INVALID_ARG_TYPE' });
+  assert.throws(() => {
+    net.createServer().listen({ port: 0, [name]: -1 });
+  }, { code: 'ERR_OUT_OF_RANGE' });
+}
+
+assert.throws(() => {
+  net.createServer().listen({ port: 0, acceptBatchSize: 0 });
+}, { code: 'ERR_OUT_OF_RANGE' });
@@ -0,0 +1,155 @@
+'use strict';
+
+// Tests that small writes issued in the same tick are written to the socket
+// with fewer system calls if socket.setWriteCoalescing() was called, and
+// that coalesced writes only complete once their data was written out.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { spawn } = require('child_process');
+const { getIOStatistics } = require('perf_hooks');
+
+const CHUNKS = 10;
+
+const chunks = [];
+for (let i = 0; i < CHUNKS; i++)
+  chunks.push(`chunk ${i};`);
+const expected = chunks.join('');
+
+function writeChunks(socket, lastCallback) {
+  for (let i = 0; i < CHUNKS; i++) {
+    socket.write(chunks[i],
+                 i === CHUNKS - 1 ? lastCallback : common.mustCall());
+  }
+}
+
+if (process.argv[2] === 'child') {
+  const socket = net.connect(+process.argv[3], () => {
+    socket.setWriteCoalescing();
+    // Nothing that was written before may get lost.
+    writeChunks(socket, common.mustCall(() => process.exit()));
+  });
+  return;
+}
+
+function tcpStats() {
+  const stats = getIOStatistics().TCPWRAP;
+  return stats ? stats : { writes: 0, writeSyscalls: 0 };
+}
+
+let onServerEnd = null;
+const server = net.createServer((socket) => {
+  let data = '';
+  socket.setEncoding('utf8');
+  socket.on('data', (chunk) => data += chunk);
+  socket.on('end', () => {
+    if (onServerEnd)
+      onServerEnd(data);
+    socket.end(data);
+  });
+  // The client may have closed the connection already.
+  socket.on('error', () => {});
+});
+
+function connect(coalesce, onConnect) {
+  const client = net.connect(server.address().port, () => {
+    if (coalesce !== undefined)
+      client.setWriteCoalescing(coalesce);
+    onConnect(client);
+  });
+}
+
+function roundTrip(coalesce) {
+  return new Promise((resolve) => {
+    connect(coalesce, (client) => {
+      const before = tcpStats();
+      writeChunks(client, common.mustCall());
+      let received = '';
+      client.setEncoding('utf8');
+      client.on('data', (chunk) => received += chunk);
+      client.on('end', common.mustCall(() => {
+        assert.strictEqual(received, expected);
+        resolve({ before, after: tcpStats() });
+      }));
+      client.end();
+    });
+  });
+}
+
+// Resolves once the server has received `received` from what `write` wrote
+// before the client destroyed the socket.
+function destroyed(write, received = expected) {
+  return new Promise((resolve) => {
+    connect(true, (client) => {
+      client.on('error', () => {});
+      write(client);
+      onServerEnd = common.mustCall((data) => {
+        onServerEnd = null;
+        assert.strictEqual(data, received);
+        resolve();
+      });
+    });
+  });
+}
+
+function exitInCallback() {
+  return new Promise((resolve) => {
+    let pending = 2;
+    const onDone = () => {
+      if (--pending === 0)
+        resolve();
+    };
+    onServerEnd = common.mustCall((data) => {
+      onServerEnd = null;
+      assert.strictEqual(data, expected);
+      onDone();
+    });
+    const child = spawn(process.execPath, [
+      __filename, 'child', server.address().port
+    ], { stdio: 'inherit' });
+    child.on('exit', common.mustCall((code) => {
+      assert.strictEqual(code, 0);
+      onDone();
+    }));
+  });
+}
+
+async function run() {
+  let { before, after } = await roundTrip(true);
+  assert(after.writes - before.writes >= CHUNKS);
+  assert(after.writeSyscalls - before.writeSyscalls < CHUNKS);
+
+  // Write coalescing is disabled by default.
+  for (const coalesce of [undefined, false]) {
+    ({ before, after } = await roundTrip(coalesce));
+    assert(after.writeSyscalls - before.writeSyscalls >= CHUNKS);
+  }
+
+  await destroyed((client) => {
+    writeChunks(client, common.mustCall(() => client.destroy()));
+  });
+  await destroyed((client) => {
+    writeChunks(client, common.mustCall());
+    client.end();
+    client.on('finish', common.mustCall(() => client.destroy()));
+  });
+  // Writes that are still buffered are discarded by destroy(), unless write
+  // coalescing was disabled before.
+  await destroyed((client) => {
+    for (const chunk of chunks)
+      client.write(chunk, common.mustNotCall());
+    client.destroy();
+  }, '');
+  await destroyed((client) => {
+    for (const chunk of chunks)
+      client.write(chunk);
+    client.setWriteCoalescing(false);
+    client.destroy();
+  });
+  await exitInCallback();
+}
+
+server.listen(0, common.mustCall(() => {
+  run().then(common.mustCall(() => server.close()));
+}));
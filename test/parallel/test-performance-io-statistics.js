@@ -0,0 +1,73 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const zlib = require('zlib');
+const { getIOStatistics } = require('perf_hooks');
+
+const fields = [
+  'callbacks',
+  'callbackTime',
+  'requests',
+  'requestTime',
+  'bytesRead',
+  'bytesWritten',
+  'writes',
+  'writeSyscalls',
+  'threadpoolRequests',
+  'threadpoolQueueTime',
+  'threadpoolRunTime'
+];
+
+function get(stats, provider) {
+  const result = stats[provider];
+  if (result === undefined)
+    return Object.fromEntries(fields.map((field) => [field, 0]));
+  assert.deepStrictEqual(Object.keys(result), fields);
+  return result;
+}
+
+const before = getIOStatistics();
+for (const provider of Object.keys(before)) {
+  const stats = get(before, provider);
+  assert(fields.some((field) => stats[field] > 0), provider);
+}
+
+fs.readFile(__filename, common.mustCall((err) => {
+  assert.ifError(err);
+  const after = getIOStatistics();
+  const fsBefore = get(before, 'FSREQCALLBACK');
+  const fsAfter = get(after, 'FSREQCALLBACK');
+  assert(fsAfter.requests > fsBefore.requests);
+  assert(fsAfter.requestTime > fsBefore.requestTime);
+  // The callback that is currently running has not been accounted yet.
+  assert(fsAfter.callbacks > fsBefore.callbacks);
+}));
+
+zlib.deflate(Buffer.alloc(1024), common.mustCall((err) => {
+  assert.ifError(err);
+  const zlibBefore = get(before, 'ZLIB');
+  const zlibAfter = get(getIOStatistics(), 'ZLIB');
+  assert(zlibAfter.threadpoolRequests > zlibBefore.threadpoolRequests);
+  assert(zlibAfter.threadpoolRunTime > zlibBefore.threadpoolRunTime);
+  assert(zlibAfter.threadpoolQueueTime >= zlibBefore.threadpoolQueueTime);
+}));
+
+const payload = Buffer.alloc(64 * 1024, 'x');
+const server = net.createServer((socket) => {
+  socket.end(payload);
+}).listen(0, common.mustCall(() => {
+  const tcpBefore = get(getIOStatistics(), 'TCPWRAP');
+  const client = net.connect(server.address().port);
+  client.resume();
+  client.on('end', common.mustCall(() => {
+    server.close();
+    const tcpAfter = get(getIOStatistics(), 'TCPWRAP');
+    // Both ends of the connection are TCPWRAPs.
+    assert(tcpAfter.bytesRead - tcpBefore.bytesRead >= payload.length);
+    assert(tcpAfter.bytesWritten - tcpBefore.bytesWritten >= payload.length);
+    assert(tcpAfter.callbacks > tcpBefore.callbacks);
+  }));
+}));
@@ -0,0 +1,44 @@
+'use strict';
+
+// With --threadpool-max-size, the threadpool has to grow even if all of its
+// threads are blocked, i.e. when no work is being posted or picked up.
+
+const common = require('../common');
+if (common.isWindows)
+  common.skip('no mkfifo on Windows');
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+const fifos = [1, 2].map((i) => path.join(tmpdir.path, `fifo${i}`));
+
+if (process.argv[2] === 'child') {
+  // Opening a FIFO for reading blocks until it is opened for writing, which
+  // keeps both base threads busy.
+  for (const fifo of fifos)
+    fs.open(fifo, 'r', common.mustCall((err, fd) => fs.closeSync(fd)));
+  fs.stat(__filename, common.mustCall((err) => {
+    assert.ifError(err);
+    assert(process.threadpoolUsage().size > 2);
+    for (const fifo of fifos)
+      fs.closeSync(fs.openSync(fifo, 'w'));
+  }));
+  return;
+}
+
+tmpdir.refresh();
+for (const fifo of fifos) {
+  const mkfifo = spawnSync('mkfifo', [fifo]);
+  if (mkfifo.error && mkfifo.error.code === 'ENOENT')
+    common.skip('missing mkfifo');
+}
+
+const child = spawnSync(process.execPath,
+                        ['--threadpool-max-size=4', __filename, 'child'],
+                        { env: { ...process.env, UV_THREADPOOL_SIZE: '2' },
+                          encoding: 'utf8',
+                          timeout: 30000 });
+assert.strictEqual(child.status, 0, child.stderr);
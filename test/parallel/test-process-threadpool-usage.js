@@ -0,0 +1,83 @@
+'use strict';
+
+// Tests process.threadpoolUsage() and --threadpool-max-size.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const crypto = require('crypto');
+const fs = require('fs');
+
+if (process.argv[2] === 'child') {
+  // Keep the 2 base threads and any added ones busy. The pool only grows
+  // while tasks keep waiting for a thread.
+  const sizes = [];
+  for (let i = 0; i < 64; i++) {
+    crypto.pbkdf2('secret', 'salt', 20000, 32, 'sha256', common.mustCall(() => {
+      sizes.push(process.threadpoolUsage().size);
+      if (sizes.length === 64)
+        console.log(JSON.stringify({ maxSeen: Math.max(...sizes) }));
+    }));
+  }
+  return;
+}
+
+const fields = [
+  'size',
+  'maxSize',
+  'idle',
+  'queued',
+  'running',
+  'slowIORunning',
+  'submitted',
+  'completed',
+  'waitTime',
+  'runTime'
+];
+
+{
+  const usage = process.threadpoolUsage();
+  assert.deepStrictEqual(Object.keys(usage), fields);
+  for (const field of fields) {
+    assert(Number.isSafeInteger(usage[field]), field);
+    assert(usage[field] >= 0, field);
+  }
+  assert(usage.size > 0);
+  // Without --threadpool-max-size, the pool does not grow.
+  assert.strictEqual(usage.maxSize, usage.size);
+  assert(usage.idle <= usage.size);
+  assert(usage.running <= usage.size);
+  assert(usage.completed <= usage.submitted);
+
+  fs.stat(__filename, common.mustCall((err) => {
+    assert.ifError(err);
+    const after = process.threadpoolUsage();
+    assert(after.submitted > usage.submitted);
+    assert(after.completed > usage.completed);
+    assert(after.runTime > usage.runTime);
+    assert(after.waitTime >= usage.waitTime);
+  }));
+}
+
+{
+  const child = spawnSync(process.execPath,
+                          ['--threadpool-max-size=8', __filename, 'child'],
+                          { env: { ...process.env, UV_THREADPOOL_SIZE: '2' },
+                            encoding: 'utf8' });
+  assert.strictEqual(child.status, 0, child.stderr);
+  const { maxSeen } = JSON.parse(child.stdout);
+  assert(maxSeen > 2, `threadpool did not grow: ${maxSeen}`);
+  assert(maxSeen <= 8, `threadpool grew too much: ${maxSeen}`);
+}
+
+{
+  const child = spawnSync(process.execPath,
+                          ['--threadpool-max-size=129', '-e', '0'],
+                          { encoding: 'utf8' });
+  assert.notStrictEqual(child.status, 0);
+  assert(child.stderr.includes(
+    '--threadpool-max-size must not be larger than 128'));
+}
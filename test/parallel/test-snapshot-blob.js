@@ -0,0 +1,108 @@
+'use strict';
+
+// Tests building a snapshot with --build-snapshot and starting from it with
+// --snapshot-blob.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const blobPath = path.join(tmpdir.path, 'snapshot.blob');
+const entryPath = path.join(tmpdir.path, 'entry.js');
+const mainPath = path.join(tmpdir.path, 'main.js');
+
+fs.writeFileSync(entryPath, `
+  // Only JavaScript built-ins are available here.
+  if (typeof process !== 'undefined' || typeof require !== 'undefined')
+    throw new Error('Node.js should not be bootstrapped yet');
+  const table = new Map();
+  for (let i = 0; i < 1000; i++)
+    table.set(i, String(i * i));
+  globalThis.snapshotState = {
+    table,
+    square(n) { return table.get(n); }
+  };
+`);
+fs.writeFileSync(mainPath, `
+  console.log(JSON.stringify({
+    size: snapshotState.table.size,
+    square: snapshotState.square(12),
+    hasRequire: typeof require
+  }));
+`);
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', blobPath, '--build-snapshot', entryPath
+  ]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  assert(fs.statSync(blobPath).size > 0);
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', blobPath, mainPath
+  ]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  assert.deepStrictEqual(JSON.parse(child.stdout), {
+    size: 1000,
+    square: '144',
+    hasRequire: 'function'
+  });
+}
+
+// Errors thrown by the entry point are reported and no blob is written.
+{
+  const throwingEntry = path.join(tmpdir.path, 'throws.js');
+  const throwingBlob = path.join(tmpdir.path, 'throws.blob');
+  fs.writeFileSync(throwingEntry, 'throw new Error("snapshot entry failed");');
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', throwingBlob, '--build-snapshot', throwingEntry
+  ]);
+  assert.strictEqual(child.status, 1);
+  assert(/snapshot entry failed/.test(child.stderr.toString()));
+  assert(!fs.existsSync(throwingBlob));
+}
+
+// --build-snapshot requires --snapshot-blob and an entry point.
+{
+  let child = spawnSync(process.execPath, ['--build-snapshot', entryPath]);
+  assert.strictEqual(child.status, 9);
+  assert(/--build-snapshot must be used with --snapshot-blob/.test(
+    child.stderr.toString()));
+
+  child = spawnSync(process.execPath, [
+    '--snapshot-blob', blobPath, '--build-snapshot'
+  ]);
+  assert.strictEqual(child.status, 9);
+  assert(/must be used with an entry point/.test(child.stderr.toString()));
+}
+
+// Files that are not snapshot blobs, or were truncated, are rejected.
+{
+  const invalidPath = path.join(tmpdir.path, 'invalid.blob');
+  fs.writeFileSync(invalidPath, 'not a snapshot');
+  let child = spawnSync(process.execPath, [
+    '--snapshot-blob', invalidPath, '-e', '0'
+  ]);
+  assert.strictEqual(child.status, 9);
+  assert(/is not a snapshot blob/.test(child.stderr.toString()));
+
+  const blob = fs.readFileSync(blobPath);
+  fs.writeFileSync(invalidPath, blob.slice(0, blob.length - 1));
+  child = spawnSync(process.execPath, [
+    '--snapshot-blob', invalidPath, '-e', '0'
+  ]);
+  assert.strictEqual(child.status, 9);
+  assert(/is truncated/.test(child.stderr.toString()));
+
+  child = spawnSync(process.execPath, [
+    '--snapshot-blob', path.join(tmpdir.path, 'missing.blob'), '-e', '0'
+  ]);
+  assert.strictEqual(child.status, 9);
+  assert(/Cannot read snapshot blob/.test(child.stderr.toString()));
+}
@@ -0,0 +1,67 @@
+'use strict';
+
+// Tests that --threadpool-crypto-size and --threadpool-compression-size move
+// work out of libuv's threadpool.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const crypto = require('crypto');
+const fs = require('fs');
+const zlib = require('zlib');
+const { getIOStatistics } = require('perf_hooks');
+
+if (process.argv[2] === 'child') {
+  const before = process.threadpoolUsage();
+  const order = [];
+  crypto.pbkdf2('secret', 'salt', 100000, 32, 'sha256', common.mustCall(() => {
+    order.push('pbkdf2');
+  }));
+  zlib.deflate(Buffer.alloc(1024), common.mustCall((err) => {
+    assert.ifError(err);
+  }));
+  // With a single thread in libuv's threadpool, this would have to wait for
+  // pbkdf2() to finish.
+  fs.stat(__filename, common.mustCall((err) => {
+    assert.ifError(err);
+    order.push('stat');
+  }));
+  process.on('exit', () => {
+    const after = process.threadpoolUsage();
+    const stats = getIOStatistics();
+    console.log(JSON.stringify({
+      order,
+      submitted: after.submitted - before.submitted,
+      pbkdf2: stats.PBKDF2REQUEST.threadpoolRequests,
+      zlib: stats.ZLIB.threadpoolRequests
+    }));
+  });
+  return;
+}
+
+const child = spawnSync(process.execPath,
+                        ['--threadpool-crypto-size=1',
+                         '--threadpool-compression-size=1',
+                         __filename, 'child'],
+                        { env: { ...process.env, UV_THREADPOOL_SIZE: '1' },
+                          encoding: 'utf8' });
+assert.strictEqual(child.status, 0, child.stderr);
+const result = JSON.parse(child.stdout);
+assert.deepStrictEqual(result.order, ['stat', 'pbkdf2']);
+// Only fs.stat() ran in libuv's threadpool.
+assert.strictEqual(result.submitted, 1);
+// The work is still accounted for in the I/O statistics.
+assert.strictEqual(result.pbkdf2, 1);
+assert.strictEqual(result.zlib, 1);
+
+for (const name of ['addon', 'compression', 'crypto']) {
+  const child = spawnSync(process.execPath,
+                          [`--threadpool-${name}-size=129`, '-e', '0'],
+                          { encoding: 'utf8' });
+  assert.notStrictEqual(child.status, 0);
+  assert(child.stderr.includes(
+    `--threadpool-${name}-size must not be larger than 128`));
+}
@@ -0,0 +1,97 @@
+// Flags: --expose-internals --timer-slack=50
+
+'use strict';
+
+// Tests that --timer-slack coalesces the idle timeouts of sockets: they do not
+// fire early, refreshing them keeps them from firing, and they still fire
+// once the socket goes idle.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const {
+  coalescedTimerListMap,
+  setUnrefTimeout
+} = require('internal/timers');
+
+const kTimeout = 100;
+// Date.now() and the event loop's clock can be a few milliseconds apart.
+const kTolerance = 5;
+
+// A timeout that is refreshed for a while and then left alone fires no earlier
+// than kTimeout after the last refresh.
+{
+  const keepAlive = setTimeout(() => {}, 10000);
+  let lastRefresh = Date.now();
+  const timer = setUnrefTimeout(common.mustCall(() => {
+    assert(Date.now() - lastRefresh >= kTimeout - kTolerance);
+    clearTimeout(keepAlive);
+  }), kTimeout);
+
+  let refreshes = 0;
+  const interval = setInterval(() => {
+    lastRefresh = Date.now();
+    assert.strictEqual(timer.refresh(), timer);
+    if (++refreshes === 10)
+      clearInterval(interval);
+  }, 20);
+}
+
+// Timeouts of different durations that expire close to each other all fire.
+{
+  const keepAlive = setTimeout(() => {}, 10000);
+  let pending = 5;
+  for (let i = 0; i < 5; i++) {
+    const start = Date.now();
+    setUnrefTimeout(common.mustCall(() => {
+      assert(Date.now() - start >= kTimeout + i - kTolerance);
+      if (--pending === 0)
+        clearTimeout(keepAlive);
+    }), kTimeout + i);
+  }
+}
+
+// Timeouts that are cleared do not fire, even after they were refreshed.
+{
+  const timer = setUnrefTimeout(common.mustNotCall(), kTimeout);
+  timer.refresh();
+  clearTimeout(timer);
+}
+
+// Clearing the last timeout of a list removes the list.
+{
+  const lists = Object.keys(coalescedTimerListMap).length;
+  const timer = setUnrefTimeout(common.mustNotCall(), kTimeout * 100);
+  assert.strictEqual(Object.keys(coalescedTimerListMap).length, lists + 1);
+  clearTimeout(timer);
+  assert.strictEqual(Object.keys(coalescedTimerListMap).length, lists);
+}
+
+// Regular timers are not coalesced.
+{
+  const timer = setTimeout(common.mustCall(), kTimeout);
+  timer.refresh();
+}
+
+// Socket idle timeouts.
+{
+  const server = net.createServer((socket) => {
+    socket.resume();
+  }).listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    let lastWrite;
+    let writes = 0;
+    const interval = setInterval(() => {
+      lastWrite = Date.now();
+      client.write('x');
+      if (++writes === 5)
+        clearInterval(interval);
+    }, 20);
+    client.setTimeout(kTimeout, common.mustCall(() => {
+      assert.strictEqual(writes, 5);
+      assert(Date.now() - lastWrite >= kTimeout - kTolerance);
+      client.destroy();
+      server.close();
+    }));
+  }));
+}
@@ -0,0 +1,37 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+
+// Promises are tracked without AsyncWrap objects. Check that they still emit
+// begin and end trace events for their lifetime.
+
+const CODE = `
+  Promise.resolve().then(() => {});
+  setImmediate(() => global.gc());
+`;
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+const FILE_NAME = path.join(tmpdir.path, 'node_trace.1.log');
+
+const proc = cp.spawn(process.execPath,
+                      [ '--trace-event-categories', 'node.async_hooks',
+                        '--expose-gc', '-e', CODE ],
+                      { cwd: tmpdir.path });
+
+proc.once('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+  const traces = JSON.parse(fs.readFileSync(FILE_NAME, 'utf8')).traceEvents
+    .filter((trace) => trace.pid === proc.pid && trace.name === 'PROMISE');
+
+  const begin = traces.filter((trace) => trace.ph === 'b');
+  const end = traces.filter((trace) => trace.ph === 'e');
+  assert(begin.length >= 2);
+  assert(begin.every((trace) => trace.args.data.triggerAsyncId > 0));
+  assert(end.length > 0);
+  const ids = new Set(begin.map((trace) => trace.id));
+  assert(end.every((trace) => ids.has(trace.id)));
+}));
@@ -0,0 +1,129 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+// Minimal protobuf reader: returns the fields of a message as
+// [field number, value] pairs, where value is a Number for varints, a Buffer
+// for length-delimited fields and 8-byte Buffer for fixed64 fields.
+function decode(buf) {
+  const fields = [];
+  let pos = 0;
+  function varint() {
+    let value = 0;
+    let shift = 0;
+    let byte;
+    do {
+      byte = buf[pos++];
+      value += (byte & 0x7f) * 2 ** shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+  while (pos < buf.length) {
+    const tag = varint();
+    const field = Math.floor(tag / 8);
+    switch (tag & 7) {
+      case 0:
+        fields.push([field, varint()]);
+        break;
+      case 1:
+        fields.push([field, buf.slice(pos, pos + 8)]);
+        pos += 8;
+        break;
+      case 2: {
+        const length = varint();
+        fields.push([field, buf.slice(pos, pos + length)]);
+        pos += length;
+        break;
+      }
+      default:
+        assert.fail(`Unexpected wire type ${tag & 7}`);
+    }
+  }
+  assert.strictEqual(pos, buf.length);
+  return fields;
+}
+
+function field(fields, number) {
+  const found = fields.find(([n]) => n === number);
+  return found && found[1];
+}
+
+if (process.argv[2] === 'child') {
+  const { performance } = require('perf_hooks');
+  performance.mark('A');
+  setTimeout(() => {
+    performance.mark('B');
+    performance.measure('A to B', 'A', 'B');
+  }, 1);
+} else {
+  tmpdir.refresh();
+
+  const proc = cp.fork(__filename, ['child'], {
+    cwd: tmpdir.path,
+    execArgv: [
+      '--trace-event-categories', 'node.perf',
+      '--trace-event-format', 'proto'
+    ]
+  });
+
+  proc.once('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    const file = path.join(tmpdir.path, 'node_trace.1.log');
+    const events = [];
+    // Trace.packet -> TracePacket.chrome_events -> trace_events.
+    for (const [n, packet] of decode(fs.readFileSync(file))) {
+      assert.strictEqual(n, 1);
+      const bundle = field(decode(packet), 5);
+      for (const [m, event] of decode(bundle)) {
+        assert.strictEqual(m, 1);
+        events.push(decode(event));
+      }
+    }
+
+    const names = [];
+    for (const event of events) {
+      assert.strictEqual(field(event, 11), proc.pid);
+      const category = field(event, 10).toString();
+      if (category === '__metadata') {
+        // Metadata events carry their value in an argument.
+        assert.strictEqual(String.fromCharCode(field(event, 3)), 'M');
+        assert.ok(field(event, 14));
+        continue;
+      }
+      assert.strictEqual(category, 'node,node.perf,node.perf.usertiming');
+      assert.strictEqual(typeof field(event, 2), 'number');
+      names.push(field(event, 1).toString());
+    }
+    assert.deepStrictEqual(names.sort(), ['A', 'A to B', 'A to B', 'B']);
+  }));
+
+  // Size-based rotation must still produce complete JSON files.
+  const rotated = cp.fork(__filename, ['child'], {
+    cwd: tmpdir.path,
+    execArgv: [
+      '--trace-event-categories', 'node.perf',
+      // eslint-disable-next-line no-template-curly-in-string
+      '--trace-event-file-pattern', 'rotated.${rotation}.log',
+      '--trace-event-file-size', '1'
+    ]
+  });
+
+  rotated.once('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    const files = fs.readdirSync(tmpdir.path)
+      .filter((name) => name.startsWith('rotated.'));
+    assert.ok(files.length > 0);
+    let count = 0;
+    for (const name of files) {
+      const data = fs.readFileSync(path.join(tmpdir.path, name), 'utf8');
+      count += JSON.parse(data).traceEvents
+        .filter((trace) => trace.cat !== '__metadata').length;
+    }
+    assert.strictEqual(count, 4);
+  }));
+}
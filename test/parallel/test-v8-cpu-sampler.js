@@ -0,0 +1,118 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const tmpdir = require('../common/tmpdir');
+const {
+  parsePprof,
+  signalSelfAndExit,
+  spawnAndReadProfile
+} = require('../common/sampler');
+
+function busyLoop(ms) {
+  const end = Date.now() + ms;
+  let x = 0;
+  while (Date.now() < end)
+    x += Math.sqrt(x + 1);
+  return x;
+}
+
+if (process.argv[2] === 'child') {
+  busyLoop(200);
+  signalSelfAndExit('SIGUSR2');
+  return;
+}
+
+tmpdir.refresh();
+
+assert.strictEqual(v8.getCpuSamplerProfile(), undefined);
+assert.strictEqual(v8.getCpuSamplerStatistics(), undefined);
+assert.strictEqual(v8.writeCpuSamplerProfile(), undefined);
+
+[0, 10001, 1.5, '99'].forEach((frequency) => {
+  assert.throws(() => v8.startCpuSampler({ frequency }), {
+    code: typeof frequency === 'string' ?
+      'ERR_INVALID_ARG_TYPE' : 'ERR_OUT_OF_RANGE'
+  });
+});
+assert.throws(() => v8.startCpuSampler({ duration: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => v8.startCpuSampler(null), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => v8.getCpuSamplerProfile('json'), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+
+v8.startCpuSampler({ frequency: 1000, duration: 5 });
+assert.throws(() => v8.startCpuSampler(), {
+  code: 'ERR_CPU_SAMPLER_RUNNING',
+  message: 'The CPU sampler is already running'
+});
+busyLoop(200);
+v8.stopCpuSampler();
+v8.stopCpuSampler();
+
+{
+  const stats = v8.getCpuSamplerStatistics();
+  assert.strictEqual(stats.running, false);
+  assert.strictEqual(stats.frequency, 1000);
+  assert(stats.samples > 0);
+  assert.strictEqual(stats.droppedSamples, 0);
+  assert(stats.aggregationTime >= 0);
+  assert(stats.elapsedTime >= 200);
+  assert(stats.overhead >= 0 && stats.overhead < 1);
+  // Time stops when the sampler is stopped.
+  busyLoop(20);
+  assert.strictEqual(v8.getCpuSamplerStatistics().elapsedTime,
+                     stats.elapsedTime);
+}
+
+{
+  const profile = v8.getCpuSamplerProfile();
+  assert.strictEqual(typeof profile, 'string');
+  const lines = profile.trim().split('\n');
+  let total = 0;
+  let busy = 0;
+  for (const line of lines) {
+    const match = /^(.+) (\d+)$/.exec(line);
+    assert(match, line);
+    total += +match[2];
+    if (match[1].includes(`busyLoop ${__filename}:`))
+      busy += +match[2];
+  }
+  assert(total > 0);
+  assert(busy > 0);
+  // The profile is kept after the sampler was stopped.
+  assert.strictEqual(v8.getCpuSamplerProfile('collapsed'), profile);
+}
+
+{
+  const { strings, duration } = parsePprof(v8.getCpuSamplerProfile('pprof'));
+  assert.strictEqual(strings[0], '');
+  for (const str of ['samples', 'count', 'cpu', 'nanoseconds', 'busyLoop'])
+    assert(strings.includes(str), str);
+  assert(duration > 0);
+  busyLoop(20);
+  assert.strictEqual(parsePprof(v8.getCpuSamplerProfile('pprof')).duration,
+                     duration);
+}
+
+{
+  const file = path.join(tmpdir.path, 'profile.pb');
+  assert.strictEqual(v8.writeCpuSamplerProfile(file, 'pprof'), file);
+  assert(fs.statSync(file).size > 0);
+}
+
+if (!common.isWindows) {
+  const profile = spawnAndReadProfile([
+    '--cpu-sampler',
+    '--cpu-sampler-signal=SIGUSR2',
+    __filename,
+    'child'
+  ], 'CPU.');
+  assert(profile.includes('busyLoop'));
+}
@@ -0,0 +1,100 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const tmpdir = require('../common/tmpdir');
+const {
+  parsePprof,
+  signalSelfAndExit,
+  spawnAndReadProfile
+} = require('../common/sampler');
+
+const retained = [];
+function allocate(n) {
+  for (let i = 0; i < n; i++)
+    retained.push({ i, s: `item ${i}`, a: [i, i + 1, i + 2] });
+}
+
+if (process.argv[2] === 'child') {
+  allocate(1e4);
+  signalSelfAndExit('SIGUSR2');
+  return;
+}
+
+tmpdir.refresh();
+
+assert.strictEqual(v8.getHeapSamplerProfile(), undefined);
+assert.strictEqual(v8.writeHeapSamplerProfile(), undefined);
+v8.stopHeapSampler();
+
+[0, 1.5, '1024'].forEach((interval) => {
+  assert.throws(() => v8.startHeapSampler({ interval }), {
+    code: typeof interval === 'string' ?
+      'ERR_INVALID_ARG_TYPE' : 'ERR_OUT_OF_RANGE'
+  });
+});
+assert.throws(() => v8.startHeapSampler({ stackDepth: 1025 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => v8.startHeapSampler(null), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => v8.getHeapSamplerProfile('json'), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+
+v8.startHeapSampler({ interval: 1024 });
+assert.throws(() => v8.startHeapSampler(), {
+  code: 'ERR_HEAP_SAMPLER_RUNNING',
+  message: 'A sampling heap profiler is already running'
+});
+allocate(1e4);
+
+{
+  const profile = v8.getHeapSamplerProfile();
+  assert.strictEqual(typeof profile, 'string');
+  const lines = profile.trim().split('\n');
+  let total = 0;
+  let allocated = 0;
+  for (const line of lines) {
+    const match = /^(.+) (\d+)$/.exec(line);
+    assert(match, line);
+    total += +match[2];
+    if (match[1].includes(`allocate ${__filename}:`))
+      allocated += +match[2];
+  }
+  assert(total > 0);
+  assert(allocated > 0);
+}
+
+{
+  const { strings } = parsePprof(v8.getHeapSamplerProfile('pprof'));
+  assert.strictEqual(strings[0], '');
+  for (const str of ['objects', 'count', 'space', 'bytes', 'allocate'])
+    assert(strings.includes(str), str);
+}
+
+{
+  const file = path.join(tmpdir.path, 'profile.pb');
+  assert.strictEqual(v8.writeHeapSamplerProfile(file, 'pprof'), file);
+  assert(fs.statSync(file).size > 0);
+}
+
+v8.stopHeapSampler();
+assert.strictEqual(v8.getHeapSamplerProfile(), undefined);
+// The sampler can be started again once it was stopped.
+v8.startHeapSampler();
+v8.stopHeapSampler();
+
+if (!common.isWindows) {
+  const profile = spawnAndReadProfile([
+    '--heap-sampler',
+    '--heap-sampler-interval=1024',
+    '--heap-sampler-signal=SIGUSR2',
+    __filename,
+    'child'
+  ], 'Heap.');
+  assert(profile.includes('allocate'));
+}
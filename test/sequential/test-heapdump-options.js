@@ -0,0 +1,128 @@
+'use strict';
+
+const common = require('../common');
+
+if (!common.isMainThread)
+  common.skip('process.chdir is not available in Workers');
+
+const {
+  writeHeapSnapshot,
+  writeHeapSnapshotInBackground
+} = require('v8');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const zlib = require('zlib');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+process.chdir(tmpdir.path);
+
+function readSnapshot(filename) {
+  let data = fs.readFileSync(filename);
+  if (filename.endsWith('.gz'))
+    data = zlib.gunzipSync(data);
+  const snapshot = JSON.parse(data.toString());
+  assert(snapshot.snapshot.node_count > 0);
+  return snapshot;
+}
+
+{
+  assert.strictEqual(writeHeapSnapshot('plain.heapsnapshot', {}),
+                     'plain.heapsnapshot');
+  const compressed =
+    writeHeapSnapshot('compressed.heapsnapshot.gz', { compress: true });
+  assert.strictEqual(compressed, 'compressed.heapsnapshot.gz');
+  readSnapshot('plain.heapsnapshot');
+  readSnapshot(compressed);
+  assert(fs.statSync(compressed).size <
+         fs.statSync('plain.heapsnapshot').size);
+}
+
+{
+  const filename = writeHeapSnapshot(undefined, { compress: true });
+  assert(/^Heap\..+\.heapsnapshot\.gz$/.test(filename), filename);
+  readSnapshot(filename);
+}
+
+{
+  const fd = fs.openSync('fd.heapsnapshot', 'w');
+  assert.strictEqual(writeHeapSnapshot(undefined, { fd }), fd);
+  // The file descriptor is left open.
+  fs.writeSync(fd, '\n');
+  fs.closeSync(fd);
+  readSnapshot('fd.heapsnapshot');
+}
+
+{
+  // Errors while writing to a file descriptor are thrown.
+  const fd = fs.openSync('fd.heapsnapshot', 'r');
+  assert.throws(() => writeHeapSnapshot(undefined, { fd }), {
+    code: 'EBADF',
+    syscall: 'write'
+  });
+  fs.closeSync(fd);
+}
+
+[null, 1, 'gzip'].forEach((options) => {
+  common.expectsError(() => writeHeapSnapshot(undefined, options), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+});
+common.expectsError(() => writeHeapSnapshot(undefined, { compress: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+common.expectsError(() => writeHeapSnapshot(undefined, { fd: -1 }), {
+  code: 'ERR_OUT_OF_RANGE',
+  type: RangeError
+});
+common.expectsError(() => writeHeapSnapshot('file', { fd: 1 }), {
+  code: 'ERR_INVALID_ARG_VALUE',
+  type: TypeError
+});
+common.expectsError(() => writeHeapSnapshotInBackground(), {
+  code: 'ERR_INVALID_CALLBACK',
+  type: TypeError
+});
+
+{
+  const filename = writeHeapSnapshotInBackground(
+    common.mustCall((err, target) => {
+      assert.ifError(err);
+      assert.strictEqual(target, filename);
+      readSnapshot(target);
+    }));
+  assert(/^Heap\..+\.heapsnapshot$/.test(filename), filename);
+}
+
+writeHeapSnapshotInBackground(
+  'background.heapsnapshot.gz',
+  { compress: true },
+  common.mustCall((err, target) => {
+    assert.ifError(err);
+    assert.strictEqual(target, 'background.heapsnapshot.gz');
+    readSnapshot(target);
+  }));
+
+writeHeapSnapshotInBackground(
+  path.join('does', 'not', 'exist.heapsnapshot'),
+  common.mustCall((err, target) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'open');
+    assert.strictEqual(target, undefined);
+  }));
+
+{
+  // With --track-heap-objects, the snapshot is serialized on the main thread.
+  const child = spawnSync(process.execPath, [
+    '--track-heap-objects',
+    '-e',
+    `require('v8').writeHeapSnapshotInBackground('tracked.heapsnapshot',
+                                                 require('assert').ifError)`
+  ]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  readSnapshot('tracked.heapsnapshot');
+}
@@ -8,6 +8,7 @@ if (!common.isMainThread)
 const { writeHeapSnapshot, getHeapSnapshot } = require('v8');
 const assert = require('assert');
 const fs = require('fs');
+const path = require('path');
 const tmpdir = require('../common/tmpdir');
 
 tmpdir.refresh();
@@ -24,6 +25,15 @@ process.chdir(tmpdir.path);
   fs.accessSync(heapdump);
 }
 
+{
+  const heapdump = path.join('does-not-exist', 'my.heapdump');
+  assert.throws(() => writeHeapSnapshot(heapdump), {
+    code: 'ENOENT',
+    syscall: 'open',
+    path: heapdump
+  });
+}
+
 [1, true, {}, [], null, Infinity, NaN].forEach((i) => {
   common.expectsError(() => writeHeapSnapshot(i), {
     code: 'ERR_INVALID_ARG_TYPE',
@@ -0,0 +1,107 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const {
+  monitorEventLoopDelay,
+  monitorEventLoopPhases
+} = require('perf_hooks');
+
+const phases = ['timers', 'other', 'pollWait', 'poll', 'check', 'nextTick'];
+
+{
+  const monitor = monitorEventLoopPhases();
+  assert(monitor.enable());
+  assert(!monitor.enable());
+  // Only one monitor can be enabled at a time.
+  const other = monitorEventLoopPhases();
+  assert(!other.enable());
+  assert(!other.disable());
+  monitor.reset();
+  assert(monitor.disable());
+  assert(!monitor.disable());
+  assert(other.enable());
+  assert(other.disable());
+
+  // Phase monitors do not interfere with event loop delay histograms.
+  const histogram = monitorEventLoopDelay();
+  assert(histogram.enable());
+  assert(histogram.disable());
+}
+
+{
+  const monitor = monitorEventLoopPhases();
+  ['a', false, {}, []].forEach((i) => {
+    common.expectsError(
+      () => monitor.poll.percentile(i),
+      {
+        type: TypeError,
+        code: 'ERR_INVALID_ARG_TYPE'
+      }
+    );
+  });
+  [-1, 0, 101].forEach((i) => {
+    common.expectsError(
+      () => monitor.poll.percentile(i),
+      {
+        type: RangeError,
+        code: 'ERR_INVALID_ARG_VALUE'
+      }
+    );
+  });
+}
+
+{
+  const monitor = monitorEventLoopPhases();
+  monitor.enable();
+
+  // Spend some time in each phase: a timer, a socket read in the poll phase,
+  // an immediate and a next tick queue.
+  const server = net.createServer((socket) => {
+    socket.end('x');
+  }).listen(0, common.mustCall(() => {
+    let m = 5;
+    function spinAWhile() {
+      const socket = net.connect(server.address().port);
+      socket.on('data', common.mustCall(() => {
+        common.busyLoop(10);
+        process.nextTick(() => common.busyLoop(10));
+      }));
+      socket.on('end', common.mustCall(() => {
+        setImmediate(() => common.busyLoop(10));
+        if (--m > 0)
+          setTimeout(spinAWhile, common.platformTimeout(10));
+        else
+          setTimeout(check, common.platformTimeout(10));
+      }));
+      common.busyLoop(10);
+    }
+    setTimeout(spinAWhile, common.platformTimeout(10));
+  }));
+
+  function check() {
+    server.close();
+    assert(monitor.disable());
+    // The values are non-deterministic, so we just check that values are
+    // present, as opposed to specific values.
+    for (const phase of phases) {
+      const histogram = monitor[phase];
+      assert(histogram.max >= histogram.min, phase);
+      assert(histogram.percentiles.size > 0, phase);
+      assert(!Number.isNaN(histogram.mean), phase);
+    }
+    assert(monitor.timers.max >= 10 * 1e6);
+    assert(monitor.poll.max >= 10 * 1e6);
+    assert(monitor.check.max >= 10 * 1e6);
+    assert(monitor.nextTick.max >= 10 * 1e6);
+
+    monitor.reset();
+    for (const phase of phases) {
+      const histogram = monitor[phase];
+      assert.strictEqual(histogram.min, 9223372036854776000);
+      assert.strictEqual(histogram.max, 0);
+      assert(Number.isNaN(histogram.mean));
+    }
+  }
+}